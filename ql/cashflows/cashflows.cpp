@@ -564,54 +564,16 @@ namespace QuantLib {
         return targetNpv/bps;
     }
 
-    // IRR utility functions
+    // yield utility functions
     namespace {
 
-        template <class T>
-        Integer sign(T x) {
-            static T zero = T();
-            if (x == zero)
-                return 0;
-            else if (x > zero)
-                return 1;
-            else
-                return -1;
-        }
-
-        // helper fucntion used to calculate Time-To-Discount for each stage when calculating discount factor stepwisely
-        Time getStepwiseDiscountTime(const ext::shared_ptr<QuantLib::CashFlow>& cashFlow,
-                                     const DayCounter& dc,
-                                     Date npvDate,
-                                     Date lastDate) {
-            Date cashFlowDate = cashFlow->date();
-            Date refStartDate, refEndDate;
-            ext::shared_ptr<Coupon> coupon =
-                    ext::dynamic_pointer_cast<Coupon>(cashFlow);
-            if (coupon != 0) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = cashFlowDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = cashFlowDate;
-            }
-
-            if ((coupon != 0) && lastDate != coupon->accrualStartDate()) {
-                Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
-                                                cashFlowDate, refStartDate, refEndDate);
-                Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
-                                                lastDate, refStartDate, refEndDate);
-                return couponPeriod - accruedPeriod;
-            }
-            else {
-                return dc.yearFraction(lastDate, cashFlowDate,
-                                       refStartDate, refEndDate);
-            }
+        Time stepwiseDiscountTime(const ext::shared_ptr<CashFlow>& cashFlow,
+                                  const DayCounter& dc,
+                                  Date npvDate,
+                                  Date lastDate) {
+            return detail::stepwiseDiscountTime(
+                *cashFlow, dynamic_cast<const Coupon*>(cashFlow.get()),
+                dc, npvDate, lastDate);
         }
 
         Real simpleDuration(const Leg& leg,
@@ -643,7 +605,7 @@ namespace QuantLib {
                     c = 0.0;
                 }
 
-                t += getStepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
+                t += stepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 dPdy += t * c * B;
@@ -686,7 +648,7 @@ namespace QuantLib {
                     c = 0.0;
                 }
 
-                t += getStepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
+                t += stepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 switch (y.compounding()) {
@@ -738,96 +700,17 @@ namespace QuantLib {
                                  settlementDate, npvDate);
         }
 
+#if defined(QL_EXTRA_SAFETY_CHECKS)
         struct CashFlowLater {
             bool operator()(const ext::shared_ptr<CashFlow> &c,
                             const ext::shared_ptr<CashFlow> &d) {
                 return c->date() > d->date();
             }
         };
+#endif
 
     } // anonymous namespace ends here
 
-    CashFlows::IrrFinder::IrrFinder(const Leg& leg,
-                                    Real npv,
-                                    const DayCounter& dayCounter,
-                                    Compounding comp,
-                                    Frequency freq,
-                                    bool includeSettlementDateFlows,
-                                    Date settlementDate,
-                                    Date npvDate)
-    : leg_(leg), npv_(npv),
-      dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
-      includeSettlementDateFlows_(includeSettlementDateFlows),
-      settlementDate_(settlementDate),
-      npvDate_(npvDate) {
-
-        if (settlementDate_ == Date())
-            settlementDate_ = Settings::instance().evaluationDate();
-
-        if (npvDate_ == Date())
-            npvDate_ = settlementDate_;
-
-        checkSign();
-    }
-
-    Real CashFlows::IrrFinder::operator()(Rate y) const {
-        InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        Real NPV = CashFlows::npv(leg_, yield,
-                                  includeSettlementDateFlows_,
-                                  settlementDate_, npvDate_);
-        return npv_ - NPV;
-    }
-
-    Real CashFlows::IrrFinder::derivative(Rate y) const {
-        InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        return modifiedDuration(leg_, yield,
-                                includeSettlementDateFlows_,
-                                settlementDate_, npvDate_);
-    }
-
-    void CashFlows::IrrFinder::checkSign() const {
-        // depending on the sign of the market price, check that cash
-        // flows of the opposite sign have been specified (otherwise
-        // IRR is nonsensical.)
-
-        Integer lastSign = sign(-npv_),
-                signChanges = 0;
-        for (Size i = 0; i < leg_.size(); ++i) {
-            if (!leg_[i]->hasOccurred(settlementDate_,
-                                      includeSettlementDateFlows_) &&
-                !leg_[i]->tradingExCoupon(settlementDate_)) {
-                Integer thisSign = sign(leg_[i]->amount());
-                if (lastSign * thisSign < 0) // sign change
-                    signChanges++;
-
-                if (thisSign != 0)
-                    lastSign = thisSign;
-            }
-        }
-        QL_REQUIRE(signChanges > 0,
-                   "the given cash flows cannot result in the given market "
-                   "price due to their sign");
-
-        /* The following is commented out due to the lack of a QL_WARN macro
-        if (signChanges > 1) {    // Danger of non-unique solution
-                                  // Check the aggregate cash flows (Norstrom)
-            Real aggregateCashFlow = npv;
-            signChanges = 0;
-            for (Size i = 0; i < leg.size(); ++i) {
-                Real nextAggregateCashFlow =
-                    aggregateCashFlow + leg[i]->amount();
-
-                if (aggregateCashFlow * nextAggregateCashFlow < 0.0)
-                    signChanges++;
-
-                aggregateCashFlow = nextAggregateCashFlow;
-            }
-            if (signChanges > 1)
-                QL_WARN( "danger of non-unique solution");
-        };
-        */
-    }
-
     Real CashFlows::npv(const Leg& leg,
                         const InterestRate& y,
                         bool includeSettlementDateFlows,
@@ -863,7 +746,7 @@ namespace QuantLib {
                 amount = 0.0;
             }
 
-            DiscountFactor b = y.discountFactor(getStepwiseDiscountTime(leg[i], dc, npvDate, lastDate));
+            DiscountFactor b = y.discountFactor(stepwiseDiscountTime(leg[i], dc, npvDate, lastDate));
             discount *= b;
             lastDate = leg[i]->date();
 
@@ -1023,7 +906,7 @@ namespace QuantLib {
                 c = 0.0;
             }
 
-            t += getStepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
+            t += stepwiseDiscountTime(leg[i], dc, npvDate, lastDate);
             DiscountFactor B = y.discountFactor(t);
             P += c * B;
             switch (y.compounding()) {
@@ -1176,18 +1059,11 @@ namespace QuantLib {
                           bool includeSettlementDateFlows,
                           Date settlementDate,
                           Date npvDate)
-            : leg_(leg), npv_(npv), zSpread_(new SimpleQuote(0.0)),
+            : leg_(leg, includeSettlementDateFlows,
+                   settlementDate, npvDate),
+              npv_(npv), zSpread_(new SimpleQuote(0.0)),
               curve_(Handle<YieldTermStructure>(discountCurve),
-                     Handle<Quote>(zSpread_), comp, freq, dc),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-                if (settlementDate_ == Date())
-                    settlementDate_ = Settings::instance().evaluationDate();
-
-                if (npvDate_ == Date())
-                    npvDate_ = settlementDate_;
+                     Handle<Quote>(zSpread_), comp, freq, dc) {
 
                 // if the discount curve allows extrapolation, let's
                 // the spreaded curve do too.
@@ -1196,18 +1072,16 @@ namespace QuantLib {
             }
             Real operator()(Rate zSpread) const {
                 zSpread_->setValue(zSpread);
-                Real NPV = CashFlows::npv(leg_, curve_,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
+                Real NPV = leg_.npv(curve_);
                 return npv_ - NPV;
             }
           private:
-            const Leg& leg_;
+            // the cash flows are read once for all the evaluations;
+            // the spreaded curve measures its own times
+            CompiledLeg leg_;
             Real npv_;
             ext::shared_ptr<SimpleQuote> zSpread_;
             ZeroSpreadedTermStructure curve_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
         };
 
     } // anonymous namespace ends here
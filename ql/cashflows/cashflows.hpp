@@ -27,6 +27,7 @@
 #ifndef quantlib_cashflows_hpp
 #define quantlib_cashflows_hpp
 
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/duration.hpp>
 #include <ql/cashflow.hpp>
 #include <ql/interestrate.hpp>
@@ -42,31 +43,6 @@ namespace QuantLib {
       private:
         CashFlows();
         CashFlows(const CashFlows&);
-
-        class IrrFinder {
-          public:
-            IrrFinder(const Leg& leg,
-                      Real npv,
-                      const DayCounter& dayCounter,
-                      Compounding comp,
-                      Frequency freq,
-                      bool includeSettlementDateFlows,
-                      Date settlementDate,
-                      Date npvDate);
-
-            Real operator()(Rate y) const;
-            Real derivative(Rate y) const;
-          private:
-            void checkSign() const;
-
-            const Leg& leg_;
-            Real npv_;
-            DayCounter dayCounter_;
-            Compounding compounding_;
-            Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
-        };
       public:
         //! \name Date functions
         //@{
@@ -213,6 +189,12 @@ namespace QuantLib {
         //! \name Yield (a.k.a. Internal Rate of Return, i.e. IRR) functions
         /*! The IRR is the interest rate at which the NPV of the cash
             flows equals the dirty price.
+
+            \note The yield function reads the cash flows into a
+                  CompiledLeg instance once per solve; the others
+                  walk the leg once per call.  When several of them
+                  are called on the same leg, using a CompiledLeg
+                  directly avoids reading the cash flows each time.
         */
         //@{
         //! NPV of the cash flows.
@@ -284,10 +266,11 @@ namespace QuantLib {
                           Date npvDate = Date(),
                           Real accuracy = 1.0e-10,
                           Rate guess = 0.05) {
-            IrrFinder objFunction(leg, npv, dayCounter, compounding,
-                                  frequency, includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-            return solver.solve(objFunction, accuracy, guess, guess/10.0);
+            CompiledLeg compiledLeg(leg, dayCounter,
+                                    includeSettlementDateFlows,
+                                    settlementDate, npvDate);
+            return compiledLeg.yield(solver, npv, compounding, frequency,
+                                     accuracy, guess);
         }
 
         //! Cash-flow duration.
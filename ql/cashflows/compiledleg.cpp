@@ -0,0 +1,433 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class T>
+        Integer sign(T x) {
+            static T zero = T();
+            if (x == zero)
+                return 0;
+            else if (x > zero)
+                return 1;
+            else
+                return -1;
+        }
+
+#if defined(QL_EXTRA_SAFETY_CHECKS)
+        struct CashFlowLater {
+            bool operator()(const ext::shared_ptr<CashFlow> &c,
+                            const ext::shared_ptr<CashFlow> &d) {
+                return c->date() > d->date();
+            }
+        };
+#endif
+
+        const Spread basisPoint_ = 1.0e-4;
+
+    }
+
+    namespace detail {
+
+        Time stepwiseDiscountTime(const CashFlow& cashFlow,
+                                  const Coupon* coupon,
+                                  const DayCounter& dc,
+                                  Date npvDate,
+                                  Date lastDate) {
+            Date cashFlowDate = cashFlow.date();
+            Date refStartDate, refEndDate;
+            if (coupon != 0) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = cashFlowDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = cashFlowDate;
+            }
+
+            if ((coupon != 0) && lastDate != coupon->accrualStartDate()) {
+                Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                cashFlowDate, refStartDate, refEndDate);
+                Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                lastDate, refStartDate, refEndDate);
+                return couponPeriod - accruedPeriod;
+            }
+            else {
+                return dc.yearFraction(lastDate, cashFlowDate,
+                                       refStartDate, refEndDate);
+            }
+        }
+
+    }
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             const DayCounter& dayCounter,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate)
+    : dayCounter_(dayCounter), settlementDate_(settlementDate),
+      npvDate_(npvDate) {
+        compile(leg, includeSettlementDateFlows, true);
+    }
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate)
+    : settlementDate_(settlementDate), npvDate_(npvDate) {
+        compile(leg, includeSettlementDateFlows, false);
+    }
+
+    void CompiledLeg::compile(const Leg& leg,
+                              bool includeSettlementDateFlows,
+                              bool measureTimes) {
+
+        if (settlementDate_ == Date())
+            settlementDate_ = Settings::instance().evaluationDate();
+
+        if (npvDate_ == Date())
+            npvDate_ = settlementDate_;
+
+#if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(std::adjacent_find(leg.begin(), leg.end(),
+                                      CashFlowLater()) == leg.end(),
+                   "cashflows must be sorted in ascending order w.r.t. their payment dates");
+#endif
+
+        dates_.reserve(leg.size());
+        amounts_.reserve(leg.size());
+        accrualNominals_.reserve(leg.size());
+        if (measureTimes) {
+            periods_.reserve(leg.size());
+            times_.reserve(leg.size());
+        }
+
+        Time t = 0.0;
+        Date lastDate = npvDate_;
+        for (Size i=0; i<leg.size(); ++i) {
+            const CashFlow& cf = *leg[i];
+            if (cf.hasOccurred(settlementDate_, includeSettlementDateFlows))
+                continue;
+
+            const Coupon* coupon = dynamic_cast<const Coupon*>(&cf);
+            Real amount = 0.0, accrualNominal = 0.0;
+            if (!cf.tradingExCoupon(settlementDate_)) {
+                amount = cf.amount();
+                if (coupon != 0)
+                    accrualNominal = coupon->nominal() *
+                                     coupon->accrualPeriod();
+            }
+
+            if (measureTimes) {
+                Time dt = detail::stepwiseDiscountTime(cf, coupon,
+                                                       dayCounter_,
+                                                       npvDate_, lastDate);
+                t += dt;
+                periods_.push_back(dt);
+                times_.push_back(t);
+            }
+            lastDate = cf.date();
+
+            dates_.push_back(lastDate);
+            amounts_.push_back(amount);
+            accrualNominals_.push_back(accrualNominal);
+        }
+    }
+
+    InterestRate CompiledLeg::flatRate(Rate yield,
+                                       Compounding compounding,
+                                       Frequency frequency) const {
+        // the times are already measured, so the rate needs no day
+        // counter; not copying it also keeps threads working on
+        // different legs off its shared reference count
+        return InterestRate(yield, DayCounter(), compounding, frequency);
+    }
+
+    void CompiledLeg::checkTimes() const {
+        QL_REQUIRE(times_.size() == dates_.size(),
+                   "discount times not measured for this leg");
+    }
+
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve) const {
+        if (dates_.empty())
+            return 0.0;
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<dates_.size(); ++i)
+            totalNPV += amounts_[i] * discountCurve.discount(dates_[i]);
+
+        return totalNPV/discountCurve.discount(npvDate_);
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve) const {
+        if (dates_.empty())
+            return 0.0;
+
+        Real bps = 0.0;
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (accrualNominals_[i] != 0.0)
+                bps += accrualNominals_[i] * discountCurve.discount(dates_[i]);
+        }
+
+        return basisPoint_*bps/discountCurve.discount(npvDate_);
+    }
+
+    void CompiledLeg::npvbps(const YieldTermStructure& discountCurve,
+                             Real& npv,
+                             Real& bps) const {
+        npv = bps = 0.0;
+        if (dates_.empty())
+            return;
+
+        for (Size i=0; i<dates_.size(); ++i) {
+            DiscountFactor df = discountCurve.discount(dates_[i]);
+            npv += amounts_[i] * df;
+            bps += accrualNominals_[i] * df;
+        }
+
+        DiscountFactor d = discountCurve.discount(npvDate_);
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+
+    Real CompiledLeg::npv(const InterestRate& y) const {
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size i=0; i<periods_.size(); ++i) {
+            discount *= y.discountFactor(periods_[i]);
+            npv += amounts_[i] * discount;
+        }
+        return npv;
+    }
+
+    Real CompiledLeg::npv(Rate yield,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        checkTimes();
+        return npv(flatRate(yield, compounding, frequency));
+    }
+
+    Real CompiledLeg::bps(Rate yield,
+                          Compounding compounding,
+                          Frequency frequency) const {
+        checkTimes();
+        if (dates_.empty())
+            return 0.0;
+
+        FlatForward flatCurve(settlementDate_, yield, dayCounter_,
+                              compounding, frequency);
+        return bps(flatCurve);
+    }
+
+    Real CompiledLeg::simpleDuration(const InterestRate& y) const {
+        Real P = 0.0;
+        Real dPdy = 0.0;
+        for (Size i=0; i<times_.size(); ++i) {
+            Time t = times_[i];
+            Real c = amounts_[i];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            dPdy += t * c * B;
+        }
+        if (P == 0.0) // no cashflows
+            return 0.0;
+        return dPdy/P;
+    }
+
+    Real CompiledLeg::modifiedDuration(const InterestRate& y) const {
+        Real P = 0.0;
+        Real dPdy = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size i=0; i<times_.size(); ++i) {
+            Time t = times_[i];
+            Real c = amounts_[i];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                dPdy -= c * B*B * t;
+                break;
+              case Compounded:
+                dPdy -= c * t * B/(1+r/N);
+                break;
+              case Continuous:
+                dPdy -= c * B * t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0) // no cashflows
+            return 0.0;
+        return -dPdy/P; // reverse derivative sign
+    }
+
+    Time CompiledLeg::duration(Rate yield,
+                               Compounding compounding,
+                               Frequency frequency,
+                               Duration::Type type) const {
+        checkTimes();
+        InterestRate y = flatRate(yield, compounding, frequency);
+        switch (type) {
+          case Duration::Simple:
+            return simpleDuration(y);
+          case Duration::Modified:
+            return modifiedDuration(y);
+          case Duration::Macaulay:
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+            return (1.0+y.rate()/y.frequency()) * modifiedDuration(y);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+    Real CompiledLeg::convexity(Rate yield,
+                                Compounding compounding,
+                                Frequency frequency) const {
+        checkTimes();
+        InterestRate y = flatRate(yield, compounding, frequency);
+
+        Real P = 0.0;
+        Real d2Pdy2 = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size i=0; i<times_.size(); ++i) {
+            Time t = times_[i];
+            Real c = amounts_[i];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                d2Pdy2 += c * 2.0*B*B*B*t*t;
+                break;
+              case Compounded:
+                d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              case Continuous:
+                d2Pdy2 += c * B*t*t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                else
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                else
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0)
+            // no cashflows
+            return 0.0;
+
+        return d2Pdy2/P;
+    }
+
+    Rate CompiledLeg::yield(Real npv,
+                            Compounding compounding,
+                            Frequency frequency,
+                            Real accuracy,
+                            Size maxIterations,
+                            Rate guess) const {
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        return yield<NewtonSafe>(solver, npv, compounding, frequency,
+                                 accuracy, guess);
+    }
+
+
+    CompiledLeg::IrrFinder::IrrFinder(const CompiledLeg& leg,
+                                      Real npv,
+                                      Compounding comp,
+                                      Frequency freq)
+    : leg_(leg), npv_(npv), compounding_(comp), frequency_(freq) {
+        leg_.checkTimes();
+        checkSign();
+    }
+
+    Real CompiledLeg::IrrFinder::operator()(Rate y) const {
+        InterestRate yield = leg_.flatRate(y, compounding_, frequency_);
+        return npv_ - leg_.npv(yield);
+    }
+
+    Real CompiledLeg::IrrFinder::derivative(Rate y) const {
+        InterestRate yield = leg_.flatRate(y, compounding_, frequency_);
+        return leg_.modifiedDuration(yield);
+    }
+
+    void CompiledLeg::IrrFinder::checkSign() const {
+        // depending on the sign of the market price, check that cash
+        // flows of the opposite sign have been specified (otherwise
+        // IRR is nonsensical.)  Cash flows trading ex-coupon have
+        // null amount and don't affect the result.
+
+        Integer lastSign = sign(-npv_),
+                signChanges = 0;
+        for (Size i = 0; i < leg_.amounts_.size(); ++i) {
+            Integer thisSign = sign(leg_.amounts_[i]);
+            if (lastSign * thisSign < 0) // sign change
+                signChanges++;
+
+            if (thisSign != 0)
+                lastSign = thisSign;
+        }
+        QL_REQUIRE(signChanges > 0,
+                   "the given cash flows cannot result in the given market "
+                   "price due to their sign");
+    }
+
+}
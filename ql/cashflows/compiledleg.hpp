@@ -0,0 +1,238 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief cash flows stored as arrays for repeated analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/cashflow.hpp>
+#include <ql/interestrate.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+    class Coupon;
+
+    //! cash flows stored as arrays for repeated analysis
+    /*! The cash flows of a leg not yet paid at the settlement date
+        are read once and stored as arrays of payment dates, amounts,
+        accrual data and discount times; the analysis functions then
+        work on the arrays, without calling virtual methods of the
+        cash flows or measuring times again.  This pays off when the
+        functions are called repeatedly on the same leg, e.g., while
+        solving for its yield.
+
+        The results are the same as those of the corresponding
+        CashFlows functions called with the same arguments.
+
+        \warning The amounts are read when the leg is compiled; the
+                 compiled leg must be built again if they change,
+                 e.g., when the forecast curve of floating-rate
+                 coupons moves.  Likewise, the settlement date is
+                 fixed on construction.
+    */
+    class CompiledLeg {
+      public:
+        /*! The given day counter is used to measure the discount
+            times for the yield-based functions.  If no settlement
+            date is given, the evaluation date is used; if no NPV
+            date is given, the settlement date is used.
+        */
+        CompiledLeg(const Leg& leg,
+                    const DayCounter& dayCounter,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        /*! The discount times are not measured, so that no day
+            counter is needed; only the YieldTermStructure functions
+            can be used.
+        */
+        CompiledLeg(const Leg& leg,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        //! number of cash flows not yet paid
+        Size size() const;
+        bool empty() const;
+        const DayCounter& dayCounter() const;
+        Date settlementDate() const;
+        Date npvDate() const;
+        //! payment dates
+        const std::vector<Date>& dates() const;
+        //! amounts; null for cash flows trading ex-coupon
+        const std::vector<Real>& amounts() const;
+        /*! nominal times accrual period of coupons; null for other
+            cash flows and for coupons trading ex-coupon
+        */
+        const std::vector<Real>& accrualNominals() const;
+        //! discount times from the NPV date, if measured
+        const std::vector<Time>& times() const;
+        //@}
+        //! \name YieldTermStructure functions
+        //@{
+        //! NPV of the cash flows
+        Real npv(const YieldTermStructure& discountCurve) const;
+        //! basis-point sensitivity of the cash flows
+        Real bps(const YieldTermStructure& discountCurve) const;
+        //! NPV and BPS of the cash flows
+        void npvbps(const YieldTermStructure& discountCurve,
+                    Real& npv,
+                    Real& bps) const;
+        //@}
+        //! \name Yield functions
+        /*! The yield is compounded as given and uses the day counter
+            passed to the constructor.
+        */
+        //@{
+        //! NPV of the cash flows
+        Real npv(Rate yield,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! basis-point sensitivity of the cash flows
+        Real bps(Rate yield,
+                 Compounding compounding,
+                 Frequency frequency) const;
+        //! cash-flow duration
+        Time duration(Rate yield,
+                      Compounding compounding,
+                      Frequency frequency,
+                      Duration::Type type) const;
+        //! cash-flow convexity
+        Real convexity(Rate yield,
+                       Compounding compounding,
+                       Frequency frequency) const;
+        //! implied internal rate of return
+        Rate yield(Real npv,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy = 1.0e-10,
+                   Size maxIterations = 100,
+                   Rate guess = 0.05) const;
+
+        template <typename Solver>
+        Rate yield(const Solver& solver,
+                   Real npv,
+                   Compounding compounding,
+                   Frequency frequency,
+                   Real accuracy = 1.0e-10,
+                   Rate guess = 0.05) const {
+            IrrFinder objFunction(*this, npv, compounding, frequency);
+            return solver.solve(objFunction, accuracy, guess, guess/10.0);
+        }
+        //@}
+      private:
+        class IrrFinder {
+          public:
+            IrrFinder(const CompiledLeg& leg,
+                      Real npv,
+                      Compounding comp,
+                      Frequency freq);
+
+            Real operator()(Rate y) const;
+            Real derivative(Rate y) const;
+          private:
+            void checkSign() const;
+
+            const CompiledLeg& leg_;
+            Real npv_;
+            Compounding compounding_;
+            Frequency frequency_;
+        };
+        void compile(const Leg& leg,
+                     bool includeSettlementDateFlows,
+                     bool measureTimes);
+        void checkTimes() const;
+        InterestRate flatRate(Rate yield,
+                              Compounding compounding,
+                              Frequency frequency) const;
+        Real npv(const InterestRate& yield) const;
+        Real simpleDuration(const InterestRate& yield) const;
+        Real modifiedDuration(const InterestRate& yield) const;
+
+        DayCounter dayCounter_;
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_, accrualNominals_;
+        // times between successive payments, and their sums
+        std::vector<Time> periods_, times_;
+    };
+
+
+    // inline definitions
+
+    inline Size CompiledLeg::size() const {
+        return dates_.size();
+    }
+
+    inline bool CompiledLeg::empty() const {
+        return dates_.empty();
+    }
+
+    inline const DayCounter& CompiledLeg::dayCounter() const {
+        return dayCounter_;
+    }
+
+    inline Date CompiledLeg::settlementDate() const {
+        return settlementDate_;
+    }
+
+    inline Date CompiledLeg::npvDate() const {
+        return npvDate_;
+    }
+
+    inline const std::vector<Date>& CompiledLeg::dates() const {
+        return dates_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::amounts() const {
+        return amounts_;
+    }
+
+    inline const std::vector<Real>& CompiledLeg::accrualNominals() const {
+        return accrualNominals_;
+    }
+
+    inline const std::vector<Time>& CompiledLeg::times() const {
+        return times_;
+    }
+
+
+    namespace detail {
+
+        //! time to discount a cash flow from the previous one
+        /*! Used by CashFlows and CompiledLeg when discounting
+            stepwise at a flat yield; the coupon is null if the
+            cash flow is not a coupon.
+        */
+        Time stepwiseDiscountTime(const CashFlow& cashFlow,
+                                  const Coupon* coupon,
+                                  const DayCounter& dc,
+                                  Date npvDate,
+                                  Date lastDate);
+
+    }
+
+}
+
+#endif
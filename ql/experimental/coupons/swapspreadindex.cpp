@@ -45,6 +45,7 @@ namespace QuantLib {
              << gearing1 << ") + " << swapIndex2_->name() << "(" << gearing2
              << ")";
         name_ = name.str();
+        historyId_ = IndexManager::instance().historyId(name_);
 
         QL_REQUIRE(swapIndex1_->fixingDays() == swapIndex2_->fixingDays(),
                    "index1 fixing days ("
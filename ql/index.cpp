@@ -18,6 +18,7 @@
 */
 
 #include <ql/index.hpp>
+#include <boost/unordered_map.hpp>
 
 namespace QuantLib {
 
@@ -33,13 +34,7 @@ namespace QuantLib {
     void Index::addFixings(const TimeSeries<Real>& t,
                            bool forceOverwrite) {
         checkNativeFixingsAllowed();
-        // is there a way of iterating over dates and values
-        // without having to make a copy?
-        std::vector<Date> dates = t.dates();
-        std::vector<Real> values = t.values();
-        addFixings(dates.begin(), dates.end(),
-                   values.begin(),
-                   forceOverwrite);
+        storeFixings(t.dates(), t.values(), forceOverwrite);
     }
 
     void Index::clearFixings() {
@@ -47,6 +42,81 @@ namespace QuantLib {
         IndexManager::instance().clearHistory(name());
     }
 
+    void Index::storeFixings(const std::vector<Date>& dates,
+                             const std::vector<Real>& values,
+                             bool forceOverwrite) {
+        IndexManager& manager = IndexManager::instance();
+        Size id = manager.historyId(name());
+
+        std::vector<Date> newDates;
+        std::vector<Real> newValues;
+        newDates.reserve(dates.size());
+        newValues.reserve(dates.size());
+        // positions of the new fixings by date; only filled once the
+        // dates stop increasing, and might repeat
+        boost::unordered_map<serial_type, Size> positions;
+
+        bool noInvalidFixing = true, noDuplicatedFixing = true;
+        Date invalidDate, duplicatedDate;
+        Real nullValue = Null<Real>();
+        Real invalidValue = Null<Real>();
+        Real duplicatedValue = Null<Real>();
+        for (Size i=0; i<dates.size(); ++i) {
+            const Date& d = dates[i];
+            if (!isValidFixingDate(d)) {
+                noInvalidFixing = false;
+                invalidDate = d;
+                invalidValue = values[i];
+                continue;
+            }
+            // a fixing given earlier in the same call replaces the
+            // stored one, if any
+            bool given = false;
+            Size position = newDates.size();
+            if (!positions.empty() ||
+                (!newDates.empty() && d <= newDates.back())) {
+                if (positions.empty()) {
+                    for (Size j=0; j<newDates.size(); ++j)
+                        positions[newDates[j].serialNumber()] = j;
+                }
+                boost::unordered_map<serial_type, Size>::const_iterator j =
+                    positions.find(d.serialNumber());
+                if (j != positions.end()) {
+                    given = true;
+                    position = j->second;
+                }
+            }
+            Real currentValue =
+                given ? newValues[position] : manager.fixing(id, d);
+            bool missingFixing = forceOverwrite || currentValue == nullValue;
+            if (missingFixing) {
+                if (given) {
+                    newValues[position] = values[i];
+                } else {
+                    if (!positions.empty())
+                        positions[d.serialNumber()] = position;
+                    newDates.push_back(d);
+                    newValues.push_back(values[i]);
+                }
+            } else if (!close(currentValue, values[i])) {
+                noDuplicatedFixing = false;
+                duplicatedDate = d;
+                duplicatedValue = values[i];
+            }
+        }
+        manager.addFixings(id, newDates, newValues);
+
+        QL_REQUIRE(noInvalidFixing,
+                   "At least one invalid fixing provided: " <<
+                   invalidDate.weekday() << " " << invalidDate <<
+                   ", " << invalidValue);
+        QL_REQUIRE(noDuplicatedFixing,
+                   "At least one duplicated fixing provided: " <<
+                   duplicatedDate << ", " << duplicatedValue <<
+                   " while " << manager.fixing(id, duplicatedDate) <<
+                   " value is already present");
+    }
+
     void Index::checkNativeFixingsAllowed() {
         QL_REQUIRE(allowsNativeFixings(),
                    "native fixings not allowed for " << name()
@@ -23,49 +23,420 @@
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
 #endif
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Snapshot layout: a header, a table of contents with one
+           entry per history, the history names, and the fixings of
+           each history (values, aligned at 8 bytes, followed by the
+           dates as serial numbers).  Offsets are from the start of
+           the file. */
+
+        const char snapshotMagic[8] = { 'Q','L','F','I','X','I','N','G' };
+        const boost::uint32_t snapshotVersion = 1;
+        const boost::uint32_t snapshotByteOrder = 0x01020304;
+
+        struct SnapshotHeader {
+            char magic[8];
+            boost::uint32_t version;
+            boost::uint32_t byteOrder;
+            boost::uint64_t count;
+        };
+
+        struct SnapshotEntry {
+            boost::uint64_t nameOffset, nameLength;
+            boost::uint64_t size, valuesOffset, datesOffset;
+        };
+
+        bool earlierSerial(const std::pair<serial_type, Size>& p1,
+                           const std::pair<serial_type, Size>& p2) {
+            return p1.first < p2.first;
+        }
+
+    }
+
+    class IndexManager::Snapshot : private boost::noncopyable {
+      public:
+        explicit Snapshot(const string& path)
+        : file_(path.c_str(), boost::interprocess::read_only),
+          region_(file_, boost::interprocess::read_only) {}
+        const char* data() const {
+            return static_cast<const char*>(region_.get_address());
+        }
+        Size size() const { return region_.get_size(); }
+      private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+    };
+
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        std::map<string, Size>::const_iterator i =
+            ids_.find(to_upper_copy(name));
+        return i != ids_.end() && data_[i->second].stored;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        const History& h = history(name);
+        if (!h.cached) {
+            std::vector<serial_type> serials;
+            std::vector<Real> values;
+            merge(h, serials, values);
+            std::vector<Date> dates;
+            dates.reserve(serials.size());
+            for (Size i=0; i<serials.size(); ++i)
+                dates.push_back(Date(serials[i]));
+            h.timeSeries = TimeSeries<Real>(dates.begin(), dates.end(),
+                                            values.begin());
+            h.cached = true;
+        }
+        return h.timeSeries;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        History& h = this->history(name);
+        h.dates.clear();
+        h.values.clear();
+        clearSnapshot(h);
+        h.dates.reserve(history.size());
+        h.values.reserve(history.size());
+        for (TimeSeries<Real>::const_iterator i=history.cbegin();
+             i!=history.cend(); ++i) {
+            h.dates.push_back(i->first.serialNumber());
+            h.values.push_back(i->second);
+        }
+        h.timeSeries = history;
+        h.cached = true;
+        h.notifier->notifyObservers();
     }
 
     ext::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name).notifier;
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
-        temp.reserve(data_.size());
-        for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+        temp.reserve(ids_.size());
+        for (std::map<string, Size>::const_iterator i=ids_.begin();
+             i!=ids_.end(); ++i)
+            if (data_[i->second].stored)
+                temp.push_back(i->first);
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        std::map<string, Size>::const_iterator i =
+            ids_.find(to_upper_copy(name));
+        if (i != ids_.end())
+            clear(data_[i->second]);
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        for (Size i=0; i<data_.size(); ++i)
+            clear(data_[i]);
+    }
+
+    Size IndexManager::historyId(const string& name) const {
+        std::pair<std::map<string, Size>::iterator, bool> i =
+            ids_.insert(std::make_pair(to_upper_copy(name), data_.size()));
+        if (i.second)
+            data_.push_back(History());
+        // as in a map, accessing a history by name creates it
+        data_[i.first->second].stored = true;
+        return i.first->second;
+    }
+
+    Real IndexManager::fixing(Size id, const Date& fixingDate) const {
+        QL_REQUIRE(id < data_.size(), "unknown index history id " << id);
+        const History& h = data_[id];
+        serial_type d = fixingDate.serialNumber();
+        std::vector<serial_type>::const_iterator i =
+            std::lower_bound(h.dates.begin(), h.dates.end(), d);
+        if (i != h.dates.end() && *i == d)
+            return h.values[i - h.dates.begin()];
+        const boost::int32_t* end = h.snapshotDates + h.snapshotSize;
+        const boost::int32_t* j = std::lower_bound(h.snapshotDates, end, d);
+        if (j != end && *j == d)
+            return h.snapshotValues[j - h.snapshotDates];
+        return Null<Real>();
+    }
+
+    void IndexManager::addFixings(Size id,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values) {
+        QL_REQUIRE(id < data_.size(), "unknown index history id " << id);
+        QL_REQUIRE(dates.size() == values.size(),
+                   "different number of fixing dates (" << dates.size()
+                   << ") and values (" << values.size() << ")");
+        History& h = data_[id];
+
+        // new fixings, sorted by date; the sort is stable, so that
+        // the last of the fixings at a given date is kept
+        std::vector<std::pair<serial_type, Size> > fixings(dates.size());
+        bool sorted = true;
+        for (Size i=0; i<dates.size(); ++i) {
+            fixings[i] = std::make_pair(dates[i].serialNumber(), i);
+            if (i > 0 && fixings[i].first <= fixings[i-1].first)
+                sorted = false;
+        }
+        if (!sorted) {
+            std::stable_sort(fixings.begin(), fixings.end(), earlierSerial);
+            Size n = 0;
+            for (Size i=0; i<fixings.size(); ++i) {
+                if (i+1 < fixings.size() &&
+                    fixings[i+1].first == fixings[i].first)
+                    continue;
+                fixings[n++] = fixings[i];
+            }
+            fixings.resize(n);
+        }
+
+        if (fixings.empty()) {
+            // nothing to store
+        } else if (h.dates.empty() ||
+                   fixings.front().first > h.dates.back()) {
+            // the common case: appended after the stored fixings
+            h.dates.reserve(h.dates.size() + fixings.size());
+            h.values.reserve(h.values.size() + fixings.size());
+            for (Size i=0; i<fixings.size(); ++i) {
+                h.dates.push_back(fixings[i].first);
+                h.values.push_back(values[fixings[i].second]);
+            }
+        } else {
+            std::vector<serial_type> mergedDates;
+            std::vector<Real> mergedValues;
+            mergedDates.reserve(h.dates.size() + fixings.size());
+            mergedValues.reserve(h.dates.size() + fixings.size());
+            Size i = 0, j = 0;
+            while (i < h.dates.size() || j < fixings.size()) {
+                if (j == fixings.size() ||
+                    (i < h.dates.size() && h.dates[i] < fixings[j].first)) {
+                    mergedDates.push_back(h.dates[i]);
+                    mergedValues.push_back(h.values[i]);
+                    ++i;
+                } else {
+                    // new fixings replace stored ones at the same date
+                    if (i < h.dates.size() && h.dates[i] == fixings[j].first)
+                        ++i;
+                    mergedDates.push_back(fixings[j].first);
+                    mergedValues.push_back(values[fixings[j].second]);
+                    ++j;
+                }
+            }
+            h.dates.swap(mergedDates);
+            h.values.swap(mergedValues);
+        }
+        // the id might have been taken before the history was cleared
+        h.stored = true;
+        changed(h);
+    }
+
+    void IndexManager::writeSnapshot(const string& path) const {
+        std::vector<string> names;
+        std::vector<std::vector<serial_type> > dates;
+        std::vector<std::vector<Real> > values;
+        for (std::map<string, Size>::const_iterator i=ids_.begin();
+             i!=ids_.end(); ++i) {
+            const History& h = data_[i->second];
+            if (!h.stored)
+                continue;
+            names.push_back(i->first);
+            dates.push_back(std::vector<serial_type>());
+            values.push_back(std::vector<Real>());
+            merge(h, dates.back(), values.back());
+            // fixing() looks the dates up by binary search, and
+            // loadSnapshot() doesn't check them by default
+            QL_ENSURE(std::adjacent_find(dates.back().begin(),
+                                         dates.back().end(),
+                                         std::greater_equal<serial_type>())
+                      == dates.back().end(),
+                      "fixing dates of " << i->first << " are not sorted");
+        }
+
+        SnapshotHeader header;
+        std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+        header.version = snapshotVersion;
+        header.byteOrder = snapshotByteOrder;
+        header.count = names.size();
+        std::vector<SnapshotEntry> entries(names.size());
+        boost::uint64_t offset =
+            sizeof(SnapshotHeader) + names.size()*sizeof(SnapshotEntry);
+        for (Size i=0; i<names.size(); ++i) {
+            entries[i].nameOffset = offset;
+            entries[i].nameLength = names[i].size();
+            offset += names[i].size();
+        }
+        for (Size i=0; i<names.size(); ++i) {
+            offset = (offset + 7) & ~boost::uint64_t(7);
+            entries[i].size = dates[i].size();
+            entries[i].valuesOffset = offset;
+            offset += dates[i].size()*sizeof(Real);
+            entries[i].datesOffset = offset;
+            offset += dates[i].size()*sizeof(boost::int32_t);
+        }
+
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary |
+                                        std::ios::trunc);
+        QL_REQUIRE(out, "could not open " << path << " for writing");
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!entries.empty())
+            out.write(reinterpret_cast<const char*>(&entries[0]),
+                      entries.size()*sizeof(SnapshotEntry));
+        for (Size i=0; i<names.size(); ++i)
+            out.write(names[i].data(), names[i].size());
+        const char padding[8] = { 0 };
+        for (Size i=0; i<names.size(); ++i) {
+            out.write(padding, entries[i].valuesOffset - out.tellp());
+            if (!values[i].empty())
+                out.write(reinterpret_cast<const char*>(&values[i][0]),
+                          values[i].size()*sizeof(Real));
+            std::vector<boost::int32_t> serials(dates[i].begin(),
+                                                dates[i].end());
+            if (!serials.empty())
+                out.write(reinterpret_cast<const char*>(&serials[0]),
+                          serials.size()*sizeof(boost::int32_t));
+        }
+        out.close();
+        QL_REQUIRE(out, "could not write fixing snapshot to " << path);
+    }
+
+    void IndexManager::loadSnapshot(const string& path, bool verify) {
+        ext::shared_ptr<Snapshot> snapshot;
+        try {
+            snapshot = ext::make_shared<Snapshot>(path);
+        } catch (std::exception& e) {
+            QL_FAIL("could not map " << path << ": " << e.what());
+        }
+        const char* data = snapshot->data();
+        Size size = snapshot->size();
+
+        SnapshotHeader header;
+        QL_REQUIRE(size >= sizeof(SnapshotHeader),
+                   path << " is not a fixing snapshot");
+        std::memcpy(&header, data, sizeof(SnapshotHeader));
+        QL_REQUIRE(std::equal(snapshotMagic, snapshotMagic+8, header.magic),
+                   path << " is not a fixing snapshot");
+        QL_REQUIRE(header.version == snapshotVersion,
+                   "unsupported version " << header.version <<
+                   " of fixing snapshot " << path);
+        QL_REQUIRE(header.byteOrder == snapshotByteOrder,
+                   "fixing snapshot " << path <<
+                   " was written with a different byte order");
+        QL_REQUIRE(header.count <= (size - sizeof(SnapshotHeader)) /
+                                   sizeof(SnapshotEntry),
+                   "fixing snapshot " << path << " is truncated");
+
+        // check all entries before modifying any history
+        const SnapshotEntry* entries = reinterpret_cast<const SnapshotEntry*>(
+                                           data + sizeof(SnapshotHeader));
+        for (Size i=0; i<header.count; ++i) {
+            const SnapshotEntry& e = entries[i];
+            QL_REQUIRE(e.nameOffset <= size &&
+                       e.nameLength <= size - e.nameOffset &&
+                       e.valuesOffset % sizeof(Real) == 0 &&
+                       e.valuesOffset <= size &&
+                       e.size <= (size - e.valuesOffset) / sizeof(Real) &&
+                       e.datesOffset % sizeof(boost::int32_t) == 0 &&
+                       e.datesOffset <= size &&
+                       e.size <= (size - e.datesOffset) /
+                                 sizeof(boost::int32_t),
+                       "fixing snapshot " << path <<
+                       " is truncated or corrupted");
+            // fixing() looks the dates up by binary search; checking
+            // them reads every page, so it is only done on request
+            if (verify) {
+                const boost::int32_t* dates =
+                    reinterpret_cast<const boost::int32_t*>(
+                                                    data + e.datesOffset);
+                for (Size j=1; j<e.size; ++j)
+                    QL_REQUIRE(dates[j-1] < dates[j],
+                               "fixing dates in snapshot " << path <<
+                               " are not sorted");
+            }
+        }
+
+        for (Size i=0; i<header.count; ++i) {
+            const SnapshotEntry& e = entries[i];
+            History& h = history(string(data + e.nameOffset, e.nameLength));
+            std::vector<serial_type>().swap(h.dates);
+            std::vector<Real>().swap(h.values);
+            h.snapshot = snapshot;
+            h.snapshotDates =
+                reinterpret_cast<const boost::int32_t*>(data + e.datesOffset);
+            h.snapshotValues =
+                reinterpret_cast<const Real*>(data + e.valuesOffset);
+            h.snapshotSize = e.size;
+            changed(h);
+        }
+    }
+
+    IndexManager::History&
+    IndexManager::history(const string& name) const {
+        return data_[historyId(name)];
+    }
+
+    void IndexManager::clear(History& h) const {
+        std::vector<serial_type>().swap(h.dates);
+        std::vector<Real>().swap(h.values);
+        clearSnapshot(h);
+        h.stored = false;
+        changed(h);
+    }
+
+    void IndexManager::clearSnapshot(History& h) {
+        // the file is unmapped with its last history
+        h.snapshot.reset();
+        h.snapshotDates = 0;
+        h.snapshotValues = 0;
+        h.snapshotSize = 0;
+    }
+
+    void IndexManager::changed(History& h) const {
+        h.cached = false;
+        h.timeSeries = TimeSeries<Real>();
+        h.notifier->notifyObservers();
+    }
+
+    void IndexManager::merge(const History& h,
+                             std::vector<serial_type>& dates,
+                             std::vector<Real>& values) {
+        dates.clear();
+        values.clear();
+        dates.reserve(h.snapshotSize + h.dates.size());
+        values.reserve(h.snapshotSize + h.dates.size());
+        Size i = 0, j = 0;
+        while (i < h.snapshotSize || j < h.dates.size()) {
+            if (j == h.dates.size() ||
+                (i < h.snapshotSize && h.snapshotDates[i] < h.dates[j])) {
+                dates.push_back(h.snapshotDates[i]);
+                values.push_back(h.snapshotValues[i]);
+                ++i;
+            } else {
+                if (i < h.snapshotSize && h.snapshotDates[i] == h.dates[j])
+                    ++i;
+                dates.push_back(h.dates[j]);
+                values.push_back(h.values[j]);
+                ++j;
+            }
+        }
     }
 
 }
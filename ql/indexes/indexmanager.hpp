@@ -26,13 +26,38 @@
 
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <ql/patterns/observable.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/cstdint.hpp>
+#include <deque>
+#include <map>
+#include <vector>
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Each history is stored as a sorted array of fixing dates and
+        an array of values; fixings are looked up by binary search,
+        and fixings later than the last stored one are appended
+        without touching the others.  Histories are identified by an
+        id, which avoids a lookup by name on each access; ids are
+        assigned on first use and remain valid until the end of the
+        program, even if the history is cleared.
+
+        Histories can also be read from a snapshot file written by
+        writeSnapshot(); the file is mapped read-only into memory, so
+        that several processes loading the same snapshot share a
+        single copy of it in the page cache, and loading takes no
+        more than parsing its table of contents; the fixing pages are
+        only read when used.  A snapshot stays mapped as long as any
+        history reads from it.  Fixings added later
+        to a history read from a snapshot are stored separately and
+        take precedence over those in the snapshot, which is never
+        modified.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
@@ -41,6 +66,9 @@ namespace QuantLib {
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
+        /*! The time series is built from the stored fixings when
+            first requested after a change.
+        */
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
@@ -52,10 +80,70 @@ namespace QuantLib {
         void clearHistory(const std::string& name);
         //! clears all stored fixings
         void clearHistories();
+        //! \name Access by id
+        //@{
+        //! returns the id of the index history
+        Size historyId(const std::string& name) const;
+        //! returns the fixing at the given date, or Null<Real>() if missing
+        Real fixing(Size id, const Date& fixingDate) const;
+        //! stores the given fixings, replacing those at the same dates
+        /*! If a date is repeated, the last of its fixings is stored. */
+        void addFixings(Size id,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values);
+        //@}
+        //! \name Snapshots
+        //@{
+        //! writes all stored histories to a snapshot file
+        /*! The file uses the native byte order and is meant to be
+            read on the same platform.
+        */
+        void writeSnapshot(const std::string& path) const;
+        //! reads the histories from a snapshot file
+        /*! The histories in the snapshot replace the stored ones for
+            the same indexes; other histories are not affected.
+
+            The layout of the file is always checked; if \p verify is
+            true, the fixing dates are also checked to be sorted,
+            which reads the whole file.  Files written by
+            writeSnapshot() always have sorted dates.
+
+            \warning the file must not be modified while the program
+                     is running.
+        */
+        void loadSnapshot(const std::string& path, bool verify = false);
+        //@}
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
-        mutable history_map data_;
+        class Snapshot;
+        struct History {
+            History() : snapshotDates(0), snapshotValues(0),
+                        snapshotSize(0), notifier(new Observable),
+                        stored(false), cached(false) {}
+            // fixings added in this process; they replace those
+            // read from a snapshot at the same dates
+            std::vector<serial_type> dates;
+            std::vector<Real> values;
+            // fixings read from a snapshot, if any; the pointers are
+            // into the mapped file, which is kept alive by snapshot
+            ext::shared_ptr<Snapshot> snapshot;
+            const boost::int32_t* snapshotDates;
+            const Real* snapshotValues;
+            Size snapshotSize;
+            ext::shared_ptr<Observable> notifier;
+            // whether the history is listed by histories()
+            bool stored;
+            mutable TimeSeries<Real> timeSeries;
+            mutable bool cached;
+        };
+        History& history(const std::string& name) const;
+        void clear(History&) const;
+        static void clearSnapshot(History&);
+        void changed(History&) const;
+        static void merge(const History&, std::vector<serial_type>& dates,
+                          std::vector<Real>& values);
+        mutable std::map<std::string, Size> ids_;
+        // a deque keeps references to the histories valid
+        mutable std::deque<History> data_;
     };
 
 }
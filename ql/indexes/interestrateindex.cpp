@@ -54,6 +54,7 @@ namespace QuantLib {
         out << " " << dayCounter_.name();
         name_ = out.str();
 
+        historyId_ = IndexManager::instance().historyId(name_);
         registerWith(Settings::instance().evaluationDate());
         registerWith(IndexManager::instance().notifier(InterestRateIndex::name()));
     }
@@ -89,6 +89,7 @@ namespace QuantLib {
         Currency currency_;
         DayCounter dayCounter_;
         std::string name_;
+        Size historyId_;
       private:
         Calendar fixingCalendar_;
     };
@@ -127,7 +128,7 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return IndexManager::instance().fixing(historyId_, fixingDate);
     }
 
 }
@@ -33,37 +33,45 @@ namespace QuantLib {
                                const DayCounter& dc,
                                Compounding comp,
                                Frequency freq)
-    : r_(r), dc_(dc), comp_(comp), freqMakesSense_(false) {
+    : r_(r), dc_(dc), comp_(comp), freqMakesSense_(false),
+      freq_(Real(freq)) {
 
         if (comp_==Compounded || comp_==SimpleThenCompounded || comp_==CompoundedThenSimple) {
             freqMakesSense_ = true;
             QL_REQUIRE(freq!=Once && freq!=NoFrequency,
                        "frequency not allowed for this interest rate");
-            freq_ = Real(freq);
         }
     }
 
     Real InterestRate::compoundFactor(Time t) const {
 
-        QL_REQUIRE(t>=0.0, "negative time (" << t << ") not allowed");
         QL_REQUIRE(r_ != Null<Rate>(), "null interest rate");
-        switch (comp_) {
+        return compoundFactor(r_, comp_, freq_, t);
+    }
+
+    Real InterestRate::compoundFactor(Rate r,
+                                      Compounding comp,
+                                      Real freq,
+                                      Time t) {
+
+        QL_REQUIRE(t>=0.0, "negative time (" << t << ") not allowed");
+        switch (comp) {
           case Simple:
-            return 1.0 + r_*t;
+            return 1.0 + r*t;
           case Compounded:
-            return std::pow(1.0+r_/freq_, freq_*t);
+            return std::pow(1.0+r/freq, freq*t);
           case Continuous:
-            return std::exp(r_*t);
+            return std::exp(r*t);
           case SimpleThenCompounded:
-            if (t<=1.0/Real(freq_))
-                return 1.0 + r_*t;
+            if (t<=1.0/freq)
+                return 1.0 + r*t;
             else
-                return std::pow(1.0+r_/freq_, freq_*t);
+                return std::pow(1.0+r/freq, freq*t);
           case CompoundedThenSimple:
-            if (t>1.0/Real(freq_))
-                return 1.0 + r_*t;
+            if (t>1.0/freq)
+                return 1.0 + r*t;
             else
-                return std::pow(1.0+r_/freq_, freq_*t);
+                return std::pow(1.0+r/freq, freq*t);
           default:
             QL_FAIL("unknown compounding convention");
         }
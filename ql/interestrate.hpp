@@ -94,6 +94,16 @@ namespace QuantLib {
         */
         Real compoundFactor(Time t) const;
 
+        //! compound factor implied by a rate compounded at time t.
+        /*! This is the calculation performed by the method above,
+            available to code working on plain rates; the frequency
+            is only used by the compounded conventions.
+        */
+        static Real compoundFactor(Rate r,
+                                   Compounding comp,
+                                   Real freq,
+                                   Time t);
+
         //! compound factor implied by the rate compounded between two dates
         /*! returns the compound (a.k.a capitalization) factor
             implied by the rate compounded between two dates.
@@ -0,0 +1,292 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file timeseriesstatistics.hpp
+    \brief returns and rolling-window statistics of time series
+*/
+
+#ifndef quantlib_time_series_statistics_hpp
+#define quantlib_time_series_statistics_hpp
+
+#include <ql/timeseries.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* The loops of the kernels below, over any X providing the
+           data as x[i]; with X = const Real*, they work on contiguous
+           data and can be vectorized by the compiler. */
+
+        template <class X>
+        void simpleReturns(const X& x, Size n, Real* r) {
+            for (Size i=0; i+1<n; ++i)
+                r[i] = x[i+1]/x[i] - 1.0;
+        }
+
+        template <class X>
+        void logReturns(const X& x, Size n, Real* r) {
+            for (Size i=0; i+1<n; ++i)
+                r[i] = std::log(x[i+1]/x[i]);
+        }
+
+        template <class X>
+        void rollingMean(const X& x, Size n, Size window, Real* m) {
+            if (n < window)
+                return;
+            Real sum = 0.0;
+            for (Size i=0; i+window<=n; ++i) {
+                if (i % window == 0) {
+                    sum = 0.0;
+                    for (Size j=i; j<i+window; ++j)
+                        sum += x[j];
+                } else {
+                    sum += x[i+window-1] - x[i-1];
+                }
+                m[i] = sum/window;
+            }
+        }
+
+        template <class X>
+        void rollingStandardDeviation(const X& x, Size n, Size window,
+                                      Real* s) {
+            if (n < window)
+                return;
+            Real shift = 0.0, sum = 0.0, sum2 = 0.0;
+            for (Size i=0; i+window<=n; ++i) {
+                if (i % window == 0) {
+                    shift = x[i];
+                    sum = sum2 = 0.0;
+                    for (Size j=i; j<i+window; ++j) {
+                        Real d = x[j] - shift;
+                        sum += d;
+                        sum2 += d*d;
+                    }
+                } else {
+                    Real in = x[i+window-1] - shift,
+                         out = x[i-1] - shift;
+                    sum += in - out;
+                    sum2 += in*in - out*out;
+                }
+                Real variance = (sum2 - sum*sum/window)/(window-1);
+                s[i] = std::sqrt(std::max(variance, 0.0));
+            }
+        }
+
+        // data placed stride elements apart in an array
+        class StridedValues {
+          public:
+            StridedValues(const Real* x, Size stride)
+            : x_(x), stride_(stride) {}
+            Real operator[](Size i) const { return x_[i*stride_]; }
+          private:
+            const Real* x_;
+            Size stride_;
+        };
+
+    }
+
+
+    /*! \name Kernels
+
+        These functions work on \f$ n \f$ data, each placed
+        <tt>stride</tt> elements after the previous one; the loops
+        over contiguous data (unit stride) are written so that they
+        can be vectorized by the compiler.
+    */
+    //@{
+    //! writes the \f$ n-1 \f$ returns \f$ x_{i+1}/x_i - 1 \f$ to \c r
+    inline void simpleReturns(const Real* x, Size n, Real* r,
+                              Size stride = 1) {
+        if (stride == 1)
+            detail::simpleReturns(x, n, r);
+        else
+            detail::simpleReturns(detail::StridedValues(x, stride), n, r);
+    }
+
+    //! writes the \f$ n-1 \f$ returns \f$ \log(x_{i+1}/x_i) \f$ to \c r
+    inline void logReturns(const Real* x, Size n, Real* r,
+                           Size stride = 1) {
+        if (stride == 1)
+            detail::logReturns(x, n, r);
+        else
+            detail::logReturns(detail::StridedValues(x, stride), n, r);
+    }
+
+    //! writes the \f$ n-w+1 \f$ means over windows of \f$ w \f$ data to \c m
+    /*! The sum over the window is updated as the window slides, and
+        calculated again every \f$ w \f$ steps so that rounding
+        errors don't accumulate.
+    */
+    inline void rollingMean(const Real* x, Size n, Size window, Real* m,
+                            Size stride = 1) {
+        QL_REQUIRE(window > 0, "null window size");
+        if (stride == 1)
+            detail::rollingMean(x, n, window, m);
+        else
+            detail::rollingMean(detail::StridedValues(x, stride),
+                                n, window, m);
+    }
+
+    /*! writes the \f$ n-w+1 \f$ sample standard deviations over
+        windows of \f$ w \f$ data to \c s
+    */
+    /*! The sums of the data and of their squares are updated as the
+        window slides; they are taken after subtracting the first
+        datum in the window, and calculated again every \f$ w \f$
+        steps, in order to limit rounding errors.
+    */
+    inline void rollingStandardDeviation(const Real* x, Size n, Size window,
+                                         Real* s, Size stride = 1) {
+        QL_REQUIRE(window > 1, "window size must be at least 2");
+        if (stride == 1)
+            detail::rollingStandardDeviation(x, n, window, s);
+        else
+            detail::rollingStandardDeviation(
+                detail::StridedValues(x, stride), n, window, s);
+    }
+    //@}
+
+
+    namespace detail {
+
+        // the values of a time series, as passed to the kernels; they
+        // are copied, unless they are already stored in an array
+        template <class Container>
+        class TimeSeriesValues {
+          public:
+            typedef const Real* values_type;
+            explicit TimeSeriesValues(const TimeSeries<Real, Container>& s)
+            : values_(s.values()) {}
+            values_type values() const {
+                return values_.empty() ? 0 : &values_[0];
+            }
+          private:
+            std::vector<Real> values_;
+        };
+
+        // the values of a FlatTimeSeries, read in place; boost's
+        // flat_map keeps (date, datum) pairs in a single vector, so
+        // the data are not contiguous but strided by the pair size
+        class FlatTimeSeriesValues {
+          public:
+            typedef FlatTimeSeries<Real>::const_iterator const_iterator;
+            explicit FlatTimeSeriesValues(const_iterator begin)
+            : begin_(begin) {}
+            Real operator[](Size i) const { return begin_[i].second; }
+          private:
+            const_iterator begin_;
+        };
+
+        template <>
+        class TimeSeriesValues<boost::container::flat_map<Date, Real> > {
+          public:
+            typedef FlatTimeSeriesValues values_type;
+            explicit TimeSeriesValues(const FlatTimeSeries<Real>& s)
+            : begin_(s.cbegin()) {}
+            values_type values() const {
+                return FlatTimeSeriesValues(begin_);
+            }
+          private:
+            FlatTimeSeries<Real>::const_iterator begin_;
+        };
+
+        // a series with the given values, dated as the data of s
+        // starting from the one at position first
+        template <class Container>
+        TimeSeries<Real, Container> timeSeries(
+                                     const TimeSeries<Real, Container>& s,
+                                     Size first,
+                                     const std::vector<Real>& values) {
+            TimeSeries<Real, Container> result;
+            typename TimeSeries<Real, Container>::const_iterator d =
+                s.cbegin();
+            std::advance(d, first);
+            for (Size i=0; i<values.size(); ++i, ++d)
+                result.append(d->first, values[i]);
+            return result;
+        }
+
+    }
+
+
+    /*! \name Time-series functions
+
+        The results are dated as the last datum used to calculate
+        them.  The data of a FlatTimeSeries are read in place from
+        its (date, datum) pairs; those of other series are copied
+        first.
+    */
+    //@{
+    //! returns \f$ x_{i}/x_{i-1} - 1 \f$
+    template <class Container>
+    TimeSeries<Real, Container>
+    simpleReturns(const TimeSeries<Real, Container>& s) {
+        if (s.size() < 2)
+            return TimeSeries<Real, Container>();
+        detail::TimeSeriesValues<Container> x(s);
+        std::vector<Real> r(s.size()-1);
+        detail::simpleReturns(x.values(), s.size(), &r[0]);
+        return detail::timeSeries(s, 1, r);
+    }
+
+    //! returns \f$ \log(x_{i}/x_{i-1}) \f$
+    template <class Container>
+    TimeSeries<Real, Container>
+    logReturns(const TimeSeries<Real, Container>& s) {
+        if (s.size() < 2)
+            return TimeSeries<Real, Container>();
+        detail::TimeSeriesValues<Container> x(s);
+        std::vector<Real> r(s.size()-1);
+        detail::logReturns(x.values(), s.size(), &r[0]);
+        return detail::timeSeries(s, 1, r);
+    }
+
+    //! returns the means over the given number of data
+    template <class Container>
+    TimeSeries<Real, Container>
+    rollingMean(const TimeSeries<Real, Container>& s, Size window) {
+        QL_REQUIRE(window > 0, "null window size");
+        if (s.size() < window)
+            return TimeSeries<Real, Container>();
+        detail::TimeSeriesValues<Container> x(s);
+        std::vector<Real> m(s.size()-window+1);
+        detail::rollingMean(x.values(), s.size(), window, &m[0]);
+        return detail::timeSeries(s, window-1, m);
+    }
+
+    //! returns the sample standard deviations over the given number of data
+    template <class Container>
+    TimeSeries<Real, Container>
+    rollingStandardDeviation(const TimeSeries<Real, Container>& s,
+                             Size window) {
+        QL_REQUIRE(window > 1, "window size must be at least 2");
+        if (s.size() < window)
+            return TimeSeries<Real, Container>();
+        detail::TimeSeriesValues<Container> x(s);
+        std::vector<Real> v(s.size()-window+1);
+        detail::rollingStandardDeviation(x.values(), s.size(), window,
+                                         &v[0]);
+        return detail::timeSeries(s, window-1, v);
+    }
+    //@}
+
+}
+
+#endif
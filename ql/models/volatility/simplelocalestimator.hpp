@@ -25,6 +25,7 @@
 #define quantlib_simple_local_estimator_hpp
 
 #include <ql/volatilitymodel.hpp>
+#include <ql/math/statistics/timeseriesstatistics.hpp>
 #include <map>
 
 namespace QuantLib {
@@ -42,15 +43,15 @@ namespace QuantLib {
         TimeSeries<Volatility>
         calculate(const TimeSeries<Real> &quoteSeries) {
             TimeSeries<Volatility> retval;
-            TimeSeries<Real>::const_iterator prev, next, cur, start;
-            start = quoteSeries.begin();
-            ++start;
-            for (cur = start; cur != quoteSeries.end(); ++cur) {
-                prev = cur; --prev;
-                retval[cur->first] =
-                    std::fabs(std::log(cur->second/prev->second))/
-                    std::sqrt(yearFraction_);
-            }
+            if (quoteSeries.size() < 2)
+                return retval;
+            std::vector<Real> quotes = quoteSeries.values();
+            std::vector<Real> returns(quotes.size()-1);
+            logReturns(&quotes[0], quotes.size(), &returns[0]);
+            Real scale = std::sqrt(yearFraction_);
+            TimeSeries<Real>::const_iterator cur = quoteSeries.cbegin();
+            for (Size i=0; i<returns.size(); ++i)
+                retval.append((++cur)->first, std::fabs(returns[i])/scale);
             return retval;
         }
     };
@@ -0,0 +1,238 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/lazyobjectscheduler.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <algorithm>
+#include <system_error>
+
+namespace QuantLib {
+
+    LazyObjectScheduler::LazyObjectScheduler(Size threads)
+    : nodes_(0), remaining_(0), successful_(true), calculated_(0),
+      stopping_(false), threads_(threads) {
+        if (threads_ == 0)
+            threads_ = std::max<Size>(std::thread::hardware_concurrency(), 1);
+        // the calling thread is the last one
+        for (Size i=1; i<threads_; ++i) {
+            try {
+                workers_.push_back(
+                    std::thread(&LazyObjectScheduler::work, this));
+            } catch (std::system_error&) {
+                // the threads already running take the whole work
+                threads_ = workers_.size() + 1;
+                break;
+            }
+        }
+    }
+
+    LazyObjectScheduler::~LazyObjectScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        for (Size i=0; i<workers_.size(); ++i)
+            workers_[i].join();
+    }
+
+    void LazyObjectScheduler::add(const ext::shared_ptr<LazyObject>& o) {
+        QL_REQUIRE(o, "null lazy object");
+        objects_.push_back(o);
+    }
+
+    void LazyObjectScheduler::clear() {
+        objects_.clear();
+    }
+
+    Size LazyObjectScheduler::size() const {
+        return objects_.size();
+    }
+
+    Size LazyObjectScheduler::threads() const {
+        return threads_;
+    }
+
+    void LazyObjectScheduler::discover(std::vector<Node>& nodes) const {
+        boost::unordered_map<LazyObject*, Size> index;
+        std::vector<Size> unexplored;
+        for (Size i=0; i<objects_.size(); ++i) {
+            LazyObject* o = objects_[i].get();
+            if (!o->calculated_ && !o->frozen_ &&
+                index.insert(std::make_pair(o, nodes.size())).second) {
+                unexplored.push_back(nodes.size());
+                nodes.push_back(Node(o));
+            }
+        }
+
+        while (!unexplored.empty()) {
+            Size i = unexplored.back();
+            unexplored.pop_back();
+            // the lazy objects this one depends on, possibly through
+            // observables which are not lazy
+            boost::unordered_set<Observable*> seen;
+            std::vector<const Observer*> observers(1, nodes[i].object);
+            while (!observers.empty()) {
+                const Observer* observer = observers.back();
+                observers.pop_back();
+                for (Observer::set_type::const_iterator
+                         j=observer->observables_.begin();
+                     j!=observer->observables_.end(); ++j) {
+                    Observable* observable = j->get();
+                    if (!seen.insert(observable).second)
+                        continue;
+                    LazyObject* dependency =
+                        dynamic_cast<LazyObject*>(observable);
+                    if (dependency) {
+                        if (dependency->calculated_ || dependency->frozen_)
+                            continue;
+                        std::pair<boost::unordered_map<LazyObject*, Size>::iterator,
+                                  bool> k = index.insert(
+                                      std::make_pair(dependency, nodes.size()));
+                        if (k.second) {
+                            unexplored.push_back(nodes.size());
+                            nodes.push_back(Node(dependency));
+                        }
+                        nodes[k.first->second].dependents.push_back(i);
+                        ++nodes[i].pending;
+                    } else if (const Observer* next =
+                                   dynamic_cast<const Observer*>(observable)) {
+                        observers.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    Size LazyObjectScheduler::calculate() {
+        std::vector<Node> nodes;
+        discover(nodes);
+
+        // objects on a cycle, and those depending on them, are never
+        // ready; they are found here and left out of the parallel run
+        std::vector<Size> pending(nodes.size());
+        std::vector<Size> ready;
+        for (Size i=0; i<nodes.size(); ++i) {
+            pending[i] = nodes[i].pending;
+            if (pending[i] == 0)
+                ready.push_back(i);
+        }
+        Size sorted = 0;
+        while (!ready.empty()) {
+            Size i = ready.back();
+            ready.pop_back();
+            ++sorted;
+            for (Size j=0; j<nodes[i].dependents.size(); ++j) {
+                if (--pending[nodes[i].dependents[j]] == 0)
+                    ready.push_back(nodes[i].dependents[j]);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        QL_REQUIRE(nodes_ == 0, "lazy-object calculation already running");
+        nodes_ = &nodes;
+        remaining_ = sorted;
+        successful_ = true;
+        errMsg_.clear();
+        calculated_ = 0;
+        for (Size i=0; i<nodes.size(); ++i) {
+            if (nodes[i].pending == 0)
+                ready_.push_back(i);
+        }
+        changed_.notify_all();
+        while (remaining_ != 0) {
+            if (!ready_.empty())
+                runNext(lock);
+            else
+                changed_.wait(lock);
+        }
+        nodes_ = 0;
+        lock.unlock();
+
+        // the rest is calculated in discovery order, which is not
+        // the dependency order; each calculation brings whatever it
+        // needs up to date and the ones that follow are no-ops
+        for (Size i=0; i<nodes.size(); ++i) {
+            if (pending[i] == 0 || nodes[i].failed)
+                continue;
+            try {
+                nodes[i].object->calculate();
+                ++calculated_;
+            } catch (std::exception& e) {
+                successful_ = false;
+                errMsg_ = e.what();
+            } catch (...) {
+                successful_ = false;
+                errMsg_ = "unknown error";
+            }
+        }
+
+        QL_ENSURE(successful_,
+                  "could not calculate one or more lazy objects: " << errMsg_);
+        return calculated_;
+    }
+
+    void LazyObjectScheduler::work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            while (!stopping_ && ready_.empty())
+                changed_.wait(lock);
+            if (stopping_)
+                return;
+            runNext(lock);
+        }
+    }
+
+    void LazyObjectScheduler::runNext(std::unique_lock<std::mutex>& lock) {
+        Node& node = (*nodes_)[ready_.front()];
+        ready_.pop_front();
+        bool skipped = node.failed, failed = false;
+        std::string errMsg;
+
+        lock.unlock();
+        if (!skipped) {
+            try {
+                node.object->calculate();
+            } catch (std::exception& e) {
+                failed = true;
+                errMsg = e.what();
+            } catch (...) {
+                failed = true;
+                errMsg = "unknown error";
+            }
+        }
+        lock.lock();
+
+        if (failed) {
+            successful_ = false;
+            errMsg_ = errMsg;
+        } else if (!skipped) {
+            ++calculated_;
+        }
+        for (Size i=0; i<node.dependents.size(); ++i) {
+            Node& dependent = (*nodes_)[node.dependents[i]];
+            if (skipped || failed)
+                dependent.failed = true;
+            if (--dependent.pending == 0)
+                ready_.push_back(node.dependents[i]);
+        }
+        --remaining_;
+        changed_.notify_all();
+    }
+
+}
@@ -0,0 +1,118 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lazyobjectscheduler.hpp
+    \brief parallel recalculation of lazy objects
+*/
+
+#ifndef quantlib_lazy_object_scheduler_hpp
+#define quantlib_lazy_object_scheduler_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Parallel recalculation of lazy objects
+    /*! The scheduler brings a set of lazy objects up to date, e.g.,
+        the curves and volatility surfaces to be rebuilt after a
+        market tick.  The lazy objects they depend on are found
+        through their observables, including those reached through
+        objects which are not lazy (such as handle links and rate
+        helpers); objects already calculated or frozen are not
+        visited further.  Objects are calculated after those they
+        depend on, and independent ones are calculated concurrently
+        on a pool of threads; each object is calculated once.
+        Objects on a dependency cycle, and those depending on them,
+        are calculated last on the calling thread.  Their order is
+        the one in which they were found, not the dependency order;
+        the objects they depend on and which are not calculated yet
+        are brought up to date by their own calculation, as usual
+        for lazy objects.
+
+        If the calculation of an object fails, those depending on it
+        are not calculated; calculate() raises an exception after all
+        the other objects were calculated.
+
+        \warning Objects calculated concurrently must not share any
+                 mutable state other than through the lazy objects
+                 they depend on, which are up to date by then.  In
+                 particular, they must not notify or register with
+                 shared observables while performing calculations,
+                 unless the thread-safe observer pattern is enabled;
+                 and dependencies must be registered as observables,
+                 or they will be calculated on the threads that need
+                 them, possibly more than once at the same time.
+
+        \ingroup patterns
+    */
+    class LazyObjectScheduler : private boost::noncopyable {
+      public:
+        /*! The calling thread takes part in the calculations,
+            together with <tt>threads-1</tt> worker threads; if no
+            number is given, the number of hardware threads is used.
+        */
+        explicit LazyObjectScheduler(Size threads = 0);
+        ~LazyObjectScheduler();
+        //! adds an object to be brought up to date by calculate()
+        void add(const ext::shared_ptr<LazyObject>&);
+        //! removes all objects added so far
+        void clear();
+        //! calculates the added objects and their dependencies
+        /*! \returns the number of objects calculated */
+        Size calculate();
+        //! \name Inspectors
+        //@{
+        Size size() const;
+        Size threads() const;
+        //@}
+      private:
+        struct Node {
+            explicit Node(LazyObject* object)
+            : object(object), pending(0), failed(false) {}
+            LazyObject* object;
+            std::vector<Size> dependents;
+            Size pending;
+            bool failed;
+        };
+        void discover(std::vector<Node>&) const;
+        void work();
+        void runNext(std::unique_lock<std::mutex>&);
+        std::vector<ext::shared_ptr<LazyObject> > objects_;
+        // calculation in progress
+        std::vector<Node>* nodes_;
+        std::deque<Size> ready_;
+        Size remaining_;
+        bool successful_;
+        std::string errMsg_;
+        Size calculated_;
+        // worker threads
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        bool stopping_;
+        Size threads_;
+    };
+
+}
+
+#endif
@@ -23,8 +23,137 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <boost/unordered_map.hpp>
+#include <deque>
+#include <vector>
+
 namespace QuantLib {
 
+    /* The observers notified while updates were deferred, together
+       with the observers that depend on them through observables
+       (as LazyObject instances do), form a graph; the deferred
+       notifications are sent by visiting it in topological order.
+       An observer is updated if it was notified before the delivery
+       or by an observable updated earlier in the delivery; the
+       notifications sent during the delivery to observers not yet
+       visited are recorded instead of being sent right away, so
+       that each observer receives them as a single update(). */
+    class ObservableSettings::Delivery {
+      public:
+        explicit Delivery(const set_type& notified);
+        //! updates the observers, in topological order
+        void run(bool& successful, std::string& errMsg);
+        /*! records a notification for a later update() of the
+            observer; returns false if the observer is not part of
+            the delivery or if its turn has passed, in which case the
+            caller must update it.
+        */
+        bool notify(Observer* o);
+        void remove(Observer* o);
+      private:
+        struct Node {
+            Node() : predecessors(0), notified(false), done(false) {}
+            std::vector<Observer*> successors;
+            Size predecessors;
+            bool notified, done;
+        };
+        boost::unordered_map<Observer*, Node> nodes_;
+        std::vector<Observer*> order_;
+    };
+
+    ObservableSettings::Delivery::Delivery(const set_type& notified) {
+        // collect the graph...
+        std::deque<Observer*> queue;
+        for (set_type::const_iterator i=notified.begin();
+             i!=notified.end(); ++i) {
+            nodes_[*i].notified = true;
+            queue.push_back(*i);
+        }
+        std::vector<Observer*> visited;
+        while (!queue.empty()) {
+            Observer* o = queue.front();
+            queue.pop_front();
+            visited.push_back(o);
+            const Observable* observable = dynamic_cast<const Observable*>(o);
+            if (!observable)
+                continue;
+            for (Observable::iterator j=observable->observers_.begin();
+                 j!=observable->observers_.end(); ++j) {
+                boost::unordered_map<Observer*, Node>::iterator k =
+                    nodes_.find(*j);
+                if (k == nodes_.end()) {
+                    k = nodes_.insert(std::make_pair(*j, Node())).first;
+                    queue.push_back(*j);
+                }
+                nodes_[o].successors.push_back(*j);
+                ++k->second.predecessors;
+            }
+        }
+
+        // ...and sort it
+        std::deque<Observer*> ready;
+        for (Size i=0; i<visited.size(); ++i) {
+            if (nodes_[visited[i]].predecessors == 0)
+                ready.push_back(visited[i]);
+        }
+        order_.reserve(visited.size());
+        while (!ready.empty()) {
+            Observer* o = ready.front();
+            ready.pop_front();
+            order_.push_back(o);
+            const std::vector<Observer*>& successors = nodes_[o].successors;
+            for (Size i=0; i<successors.size(); ++i) {
+                if (--nodes_[successors[i]].predecessors == 0)
+                    ready.push_back(successors[i]);
+            }
+        }
+        // observers on a cycle are left over; they go last, in the
+        // order in which they were reached
+        if (order_.size() < visited.size()) {
+            for (Size i=0; i<visited.size(); ++i) {
+                if (nodes_[visited[i]].predecessors != 0)
+                    order_.push_back(visited[i]);
+            }
+        }
+    }
+
+    void ObservableSettings::Delivery::run(bool& successful,
+                                           std::string& errMsg) {
+        for (Size i=0; i<order_.size(); ++i) {
+            boost::unordered_map<Observer*, Node>::iterator k =
+                nodes_.find(order_[i]);
+            // observers destroyed during the delivery are removed
+            if (k == nodes_.end())
+                continue;
+            // once its turn has passed, an observer notified later in
+            // the delivery must be updated right away (see notify())
+            k->second.done = true;
+            if (!k->second.notified)
+                continue;
+            try {
+                order_[i]->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+    }
+
+    bool ObservableSettings::Delivery::notify(Observer* o) {
+        boost::unordered_map<Observer*, Node>::iterator k = nodes_.find(o);
+        if (k == nodes_.end() || k->second.done)
+            return false;
+        k->second.notified = true;
+        return true;
+    }
+
+    void ObservableSettings::Delivery::remove(Observer* o) {
+        nodes_.erase(o);
+    }
+
+
     void ObservableSettings::enableUpdates() {
         updatesEnabled_  = true;
         updatesDeferred_ = false;
@@ -34,25 +163,41 @@ namespace QuantLib {
             bool successful = true;
             std::string errMsg;
 
-            for (iterator i=deferredObservers_.begin();
-                i!=deferredObservers_.end(); ++i) {
-                try {
-                    (*i)->update();
-                } catch (std::exception& e) {
-                    successful = false;
-                    errMsg = e.what();
-                } catch (...) {
-                    successful = false;
+            set_type notified;
+            notified.swap(deferredObservers_);
+            if (!delivery_) {
+                Delivery delivery(notified);
+                delivery_ = &delivery;
+                delivery.run(successful, errMsg);
+                delivery_ = 0;
+            } else {
+                // called from an update() during a delivery; the
+                // observers it doesn't include are updated right away
+                for (iterator i=notified.begin(); i!=notified.end(); ++i) {
+                    if (delivery_->notify(*i))
+                        continue;
+                    try {
+                        (*i)->update();
+                    } catch (std::exception& e) {
+                        successful = false;
+                        errMsg = e.what();
+                    } catch (...) {
+                        successful = false;
+                    }
                 }
             }
 
-            deferredObservers_.clear();
-
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
     }
 
+    void ObservableSettings::unregisterDeferredObserver(Observer* o) {
+        deferredObservers_.erase(o);
+        if (delivery_)
+            delivery_->remove(o);
+    }
+
 
     void Observable::notifyObservers() {
         if (!settings_.updatesEnabled()) {
@@ -63,6 +208,10 @@ namespace QuantLib {
             bool successful = true;
             std::string errMsg;
             for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+                // while deferred notifications are being sent, those
+                // to observers not yet updated are coalesced
+                if (settings_.delivery_ && settings_.delivery_->notify(*i))
+                    continue;
                 try {
                     (*i)->update();
                 } catch (std::exception& e) {
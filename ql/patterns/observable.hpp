@@ -34,6 +34,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/patterns/singleton.hpp>
 
 #include <ql/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
 #include <boost/unordered_set.hpp>
 
 
@@ -53,6 +54,12 @@ namespace QuantLib {
             updatesEnabled_  = false;
             updatesDeferred_ = deferred;
         }
+        /*! Deferred notifications, if any, are sent at this point.
+            Each observer that was notified, directly or through the
+            observables it depends on, receives a single update()
+            call; the calls are made in topological order, so that
+            each observer is updated after those it observes.
+        */
         void enableUpdates();
 
         bool updatesEnabled() const { return updatesEnabled_; }
@@ -61,7 +68,8 @@ namespace QuantLib {
       private:
         ObservableSettings()
         : updatesEnabled_(true),
-          updatesDeferred_(false) {}
+          updatesDeferred_(false),
+          delivery_(0) {}
 
         void registerDeferredObservers(
             const boost::unordered_set<Observer*>& observers);
@@ -72,12 +80,17 @@ namespace QuantLib {
         set_type deferredObservers_;
 
         bool updatesEnabled_,  updatesDeferred_;
+
+        // the deferred notifications being sent by enableUpdates()
+        class Delivery;
+        Delivery* delivery_;
     };
 
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
@@ -99,6 +112,7 @@ namespace QuantLib {
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class LazyObjectScheduler;
       public:
         typedef boost::unordered_set<ext::shared_ptr<Observable> > set_type;
         typedef set_type::iterator iterator;
@@ -147,9 +161,6 @@ namespace QuantLib {
         }
     }
 
-    inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
-        deferredObservers_.erase(o);
-    }
 
     inline Observable::Observable(const Observable&)
     : settings_(ObservableSettings::instance()) {
@@ -179,7 +190,7 @@ namespace QuantLib {
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        if (settings_.updatesDeferred())
+        if (settings_.updatesDeferred() || settings_.delivery_)
             settings_.unregisterDeferredObserver(o);
 
         return observers_.erase(o);
@@ -264,6 +275,7 @@ namespace QuantLib {
     class Observer : public ext::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
+        friend class LazyObjectScheduler;
       public:
         typedef boost::unordered_set<ext::shared_ptr<Observable> > set_type;
         typedef set_type::iterator iterator;
@@ -563,4 +575,71 @@ namespace QuantLib {
     }
 }
 #endif
+
+namespace QuantLib {
+
+    //! batch of changes whose notifications are sent together
+    /*! Notifications are deferred from the construction of the batch
+        until commit() is called or the batch is destroyed, whichever
+        comes first; they are then sent by
+        ObservableSettings::enableUpdates().  This allows to set many
+        quotes at once and have each affected object notified once,
+        instead of once per quote.
+
+        \code
+        {
+            UpdateBatch batch;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+            batch.commit();
+        }
+        \endcode
+
+        The changes themselves can't be rolled back: if the batch is
+        destroyed because of an exception, the notifications for the
+        changes made so far are still sent.  Batches can be nested;
+        only the outermost one sends the notifications.  If updates
+        were already disabled when the batch was created, the batch
+        doesn't change the settings.
+
+        \ingroup patterns
+    */
+    class UpdateBatch : private boost::noncopyable {
+      public:
+        UpdateBatch();
+        ~UpdateBatch();
+        //! sends the deferred notifications
+        void commit();
+      private:
+        bool wasEnabled_, committed_;
+    };
+
+
+    // inline definitions
+
+    inline UpdateBatch::UpdateBatch()
+    : wasEnabled_(ObservableSettings::instance().updatesEnabled()),
+      committed_(false) {
+        if (wasEnabled_)
+            ObservableSettings::instance().disableUpdates(true);
+    }
+
+    inline UpdateBatch::~UpdateBatch() {
+        try {
+            commit();
+        } catch (...) {
+            // nowhere to report it from a destructor
+        }
+    }
+
+    inline void UpdateBatch::commit() {
+        if (!committed_) {
+            committed_ = true;
+            if (wasEnabled_)
+                ObservableSettings::instance().enableUpdates();
+        }
+    }
+
+}
+
 #endif
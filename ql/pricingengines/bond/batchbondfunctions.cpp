@@ -0,0 +1,435 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/bond/batchbondfunctions.hpp>
+#include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/comparison.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace QuantLib {
+
+    namespace {
+
+        // bonds are handed out to the threads in chunks of this size
+        const Size chunkSize = 64;
+
+        class BondDispatcher {
+          public:
+            BondDispatcher(const ext::function<Real(Size)>& f,
+                           std::vector<Real>& results,
+                           std::vector<std::string>& errors)
+            : f_(f), results_(results), errors_(errors), next_(0) {}
+            void work() {
+                try {
+                    for (;;) {
+                        Size begin, end;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            if (next_ == results_.size() || failure_)
+                                return;
+                            begin = next_;
+                            end = std::min(begin + chunkSize,
+                                           results_.size());
+                            next_ = end;
+                        }
+                        for (Size i=begin; i<end; ++i) {
+                            try {
+                                results_[i] = f_(i);
+                            } catch (Error& e) {
+                                results_[i] = Null<Real>();
+                                errors_[i] = e.what();
+                            }
+                        }
+                    }
+                } catch (...) {
+                    // anything else stops the calculation, and is
+                    // raised again on the calling thread
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!failure_)
+                        failure_ = std::current_exception();
+                }
+            }
+            void checkFailure() const {
+                if (failure_)
+                    std::rethrow_exception(failure_);
+            }
+          private:
+            const ext::function<Real(Size)>& f_;
+            std::vector<Real>& results_;
+            std::vector<std::string>& errors_;
+            Size next_;
+            std::exception_ptr failure_;
+            std::mutex mutex_;
+        };
+
+        /* The discount factor of a ZeroSpreadedTermStructure at time
+           t, given the zero rate of the original curve at t.  The
+           calculation is the same as in zeroYieldImpl() and
+           discountImpl(), through the same compound factor as
+           InterestRate; it doesn't copy day counters, which would
+           serialize the threads on their reference counts.  The
+           yield functions of CompiledLeg avoid them likewise.
+        */
+        DiscountFactor spreadedDiscount(Time t,
+                                        Rate zeroRate,
+                                        Spread zSpread,
+                                        Compounding compounding,
+                                        Real frequency) {
+            if (t == 0.0)
+                return 1.0;
+
+            Real compound = InterestRate::compoundFactor(
+                              zeroRate + zSpread, compounding, frequency, t);
+            QL_REQUIRE(compound>0.0, "positive compound factor required");
+            Rate continuous = compound==1.0 ? 0.0 : std::log(compound)/t;
+            return DiscountFactor(std::exp(-continuous*t));
+        }
+
+    }
+
+
+    class BatchBondFunctions::ZSpreadFinder {
+      public:
+        ZSpreadFinder(const BatchBondFunctions& bonds,
+                      Size i,
+                      const CurveSample& curve,
+                      Real npv)
+        : bonds_(bonds), i_(i), curve_(curve), npv_(npv) {}
+        Real operator()(Spread zSpread) const {
+            return npv_ - bonds_.npv(i_, curve_, zSpread);
+        }
+      private:
+        const BatchBondFunctions& bonds_;
+        Size i_;
+        const CurveSample& curve_;
+        Real npv_;
+    };
+
+
+    BatchBondFunctions::BatchBondFunctions(Size threads)
+    : offsets_(1, 0), threads_(threads) {
+        if (threads_ == 0)
+            threads_ = std::max<Size>(std::thread::hardware_concurrency(), 1);
+    }
+
+    Size BatchBondFunctions::add(const Bond& bond,
+                                 const DayCounter& dayCounter,
+                                 Compounding compounding,
+                                 Frequency frequency,
+                                 Date settlement) {
+        if (settlement == Date())
+            settlement = bond.settlementDate();
+
+        QL_REQUIRE(BondFunctions::isTradable(bond, settlement),
+                   "non tradable at " << settlement <<
+                   " (maturity being " << bond.maturityDate() << ")");
+
+        CompiledLeg leg(bond.cashflows(), dayCounter, false,
+                        settlement, settlement);
+        Real accruedAmount = bond.accruedAmount(settlement);
+        Real notional = bond.notional(settlement);
+
+        legs_.push_back(leg);
+        compoundings_.push_back(compounding);
+        frequencies_.push_back(frequency);
+        accruedAmounts_.push_back(accruedAmount);
+        notionals_.push_back(notional);
+        offsets_.push_back(offsets_.back() + leg.size() + 1);
+        return legs_.size()-1;
+    }
+
+    void BatchBondFunctions::clear() {
+        legs_.clear();
+        compoundings_.clear();
+        frequencies_.clear();
+        accruedAmounts_.clear();
+        notionals_.clear();
+        offsets_.assign(1, 0);
+        errors_.clear();
+    }
+
+
+    std::vector<Real> BatchBondFunctions::cleanPrice(
+                                      const std::vector<Rate>& yields) const {
+        using namespace ext::placeholders;
+        checkSize(yields.size());
+        return run(ext::bind(&BatchBondFunctions::bondCleanPrice, this,
+                             _1, &yields));
+    }
+
+    std::vector<Real> BatchBondFunctions::dirtyPrice(
+                                      const std::vector<Rate>& yields) const {
+        using namespace ext::placeholders;
+        checkSize(yields.size());
+        return run(ext::bind(&BatchBondFunctions::bondDirtyPrice, this,
+                             _1, &yields));
+    }
+
+    std::vector<Rate> BatchBondFunctions::yield(
+                                         const std::vector<Real>& prices,
+                                         Real accuracy,
+                                         Size maxIterations,
+                                         Rate guess,
+                                         Bond::Price::Type priceType) const {
+        using namespace ext::placeholders;
+        checkSize(prices.size());
+        return run(ext::bind(&BatchBondFunctions::bondYield, this,
+                             _1, &prices, accuracy, maxIterations, guess,
+                             priceType));
+    }
+
+    std::vector<Time> BatchBondFunctions::duration(
+                                             const std::vector<Rate>& yields,
+                                             Duration::Type type) const {
+        using namespace ext::placeholders;
+        checkSize(yields.size());
+        return run(ext::bind(&BatchBondFunctions::bondDuration, this,
+                             _1, &yields, type));
+    }
+
+    std::vector<Real> BatchBondFunctions::convexity(
+                                      const std::vector<Rate>& yields) const {
+        using namespace ext::placeholders;
+        checkSize(yields.size());
+        return run(ext::bind(&BatchBondFunctions::bondConvexity, this,
+                             _1, &yields));
+    }
+
+    std::vector<Real> BatchBondFunctions::cleanPrice(
+                      const ext::shared_ptr<YieldTermStructure>& discount,
+                      const std::vector<Spread>& zSpreads) const {
+        using namespace ext::placeholders;
+        QL_REQUIRE(discount, "null discount curve");
+        checkSize(zSpreads.size());
+        CurveSample curve;
+        sample(*discount, curve);
+        return run(ext::bind(&BatchBondFunctions::bondSpreadedCleanPrice,
+                             this, _1, &curve, &zSpreads));
+    }
+
+    std::vector<Spread> BatchBondFunctions::zSpread(
+                      const std::vector<Real>& cleanPrices,
+                      const ext::shared_ptr<YieldTermStructure>& discount,
+                      Real accuracy,
+                      Size maxIterations,
+                      Rate guess) const {
+        using namespace ext::placeholders;
+        QL_REQUIRE(discount, "null discount curve");
+        checkSize(cleanPrices.size());
+        CurveSample curve;
+        sample(*discount, curve);
+        return run(ext::bind(&BatchBondFunctions::bondZSpread, this,
+                             _1, &curve, &cleanPrices,
+                             accuracy, maxIterations, guess));
+    }
+
+
+    void BatchBondFunctions::checkSize(Size n) const {
+        QL_REQUIRE(n == legs_.size(),
+                   n << " values given for " << legs_.size() << " bonds");
+    }
+
+    void BatchBondFunctions::checkSample(Size i,
+                                         const CurveSample& curve) const {
+        QL_REQUIRE(curve.errors[i].empty(),
+                   "could not sample discount curve: " << curve.errors[i]);
+    }
+
+    std::vector<Real> BatchBondFunctions::run(const BondCalculation& f) const {
+        std::vector<Real> results(legs_.size());
+        errors_.assign(legs_.size(), std::string());
+        BondDispatcher dispatcher(f, results, errors_);
+
+        // the calling thread is the last one
+        Size chunks = (results.size() + chunkSize - 1) / chunkSize;
+        std::vector<std::thread> workers;
+        for (Size i=1; i<std::min(threads_, chunks); ++i) {
+            try {
+                workers.push_back(
+                    std::thread(&BondDispatcher::work, &dispatcher));
+            } catch (std::system_error&) {
+                // the threads already running take the remaining work
+                break;
+            }
+        }
+        dispatcher.work();
+        for (Size i=0; i<workers.size(); ++i)
+            workers[i].join();
+        dispatcher.checkFailure();
+        return results;
+    }
+
+    void BatchBondFunctions::sample(const YieldTermStructure& discount,
+                                    CurveSample& curve) const {
+        curve.times.resize(offsets_.back());
+        curve.zeroRates.resize(offsets_.back());
+        curve.errors.assign(legs_.size(), std::string());
+
+        // same checks as the ZeroSpreadedTermStructure used by
+        // CashFlows::zSpread, which takes them from the original curve
+        Time maxTime = discount.maxTime();
+        bool extrapolate = discount.allowsExtrapolation();
+
+        for (Size i=0; i<legs_.size(); ++i) {
+            const CompiledLeg& leg = legs_[i];
+            try {
+                for (Size j=0; j<=leg.size(); ++j) {
+                    Date d = j == 0 ? leg.npvDate() : leg.dates()[j-1];
+                    Time t = discount.timeFromReference(d);
+                    QL_REQUIRE(t >= 0.0,
+                               "negative time (" << t << ") given");
+                    QL_REQUIRE(extrapolate || t <= maxTime ||
+                               close_enough(t, maxTime),
+                               "time (" << t << ") is past max curve time ("
+                               << maxTime << ")");
+                    Rate zeroRate = 0.0;
+                    if (t != 0.0)
+                        zeroRate = discount.zeroRate(t, compoundings_[i],
+                                                     frequencies_[i],
+                                                     true).rate();
+                    curve.times[offsets_[i]+j] = t;
+                    curve.zeroRates[offsets_[i]+j] = zeroRate;
+                }
+            } catch (Error& e) {
+                curve.errors[i] = e.what();
+            }
+        }
+    }
+
+    Real BatchBondFunctions::npv(Size i,
+                                 const CurveSample& curve,
+                                 Spread zSpread) const {
+        const std::vector<Real>& amounts = legs_[i].amounts();
+        if (amounts.empty())
+            return 0.0;
+
+        const Time* t = &curve.times[offsets_[i]];
+        const Rate* zeroRate = &curve.zeroRates[offsets_[i]];
+        Compounding compounding = compoundings_[i];
+        Real frequency = Real(frequencies_[i]);
+
+        // the first sample is at the NPV date
+        Real totalNPV = 0.0;
+        for (Size j=0; j<amounts.size(); ++j)
+            totalNPV += amounts[j] *
+                spreadedDiscount(t[j+1], zeroRate[j+1], zSpread,
+                                 compounding, frequency);
+
+        return totalNPV/spreadedDiscount(t[0], zeroRate[0], zSpread,
+                                         compounding, frequency);
+    }
+
+
+    Real BatchBondFunctions::bondDirtyPrice(
+                                     Size i,
+                                     const std::vector<Rate>* yields) const {
+        Rate yield = (*yields)[i];
+        if (yield == Null<Rate>())
+            return Null<Real>();
+        return legs_[i].npv(yield, compoundings_[i], frequencies_[i]) *
+            100.0 / notionals_[i];
+    }
+
+    Real BatchBondFunctions::bondCleanPrice(
+                                     Size i,
+                                     const std::vector<Rate>* yields) const {
+        Real dirtyPrice = bondDirtyPrice(i, yields);
+        if (dirtyPrice == Null<Real>())
+            return Null<Real>();
+        return dirtyPrice - accruedAmounts_[i];
+    }
+
+    Real BatchBondFunctions::bondYield(Size i,
+                                       const std::vector<Real>* prices,
+                                       Real accuracy,
+                                       Size maxIterations,
+                                       Rate guess,
+                                       Bond::Price::Type priceType) const {
+        Real dirtyPrice = (*prices)[i];
+        if (dirtyPrice == Null<Real>())
+            return Null<Real>();
+
+        if (priceType == Bond::Price::Clean)
+            dirtyPrice += accruedAmounts_[i];
+
+        dirtyPrice /= 100.0 / notionals_[i];
+
+        return legs_[i].yield(dirtyPrice, compoundings_[i], frequencies_[i],
+                              accuracy, maxIterations, guess);
+    }
+
+    Real BatchBondFunctions::bondDuration(Size i,
+                                          const std::vector<Rate>* yields,
+                                          Duration::Type type) const {
+        Rate yield = (*yields)[i];
+        if (yield == Null<Rate>())
+            return Null<Real>();
+        return legs_[i].duration(yield, compoundings_[i], frequencies_[i],
+                                 type);
+    }
+
+    Real BatchBondFunctions::bondConvexity(
+                                     Size i,
+                                     const std::vector<Rate>* yields) const {
+        Rate yield = (*yields)[i];
+        if (yield == Null<Rate>())
+            return Null<Real>();
+        return legs_[i].convexity(yield, compoundings_[i], frequencies_[i]);
+    }
+
+    Real BatchBondFunctions::bondSpreadedCleanPrice(
+                                  Size i,
+                                  const CurveSample* curve,
+                                  const std::vector<Spread>* zSpreads) const {
+        Spread zSpread = (*zSpreads)[i];
+        if (zSpread == Null<Spread>())
+            return Null<Real>();
+        checkSample(i, *curve);
+        Real dirtyPrice = npv(i, *curve, zSpread) * 100.0 / notionals_[i];
+        return dirtyPrice - accruedAmounts_[i];
+    }
+
+    Real BatchBondFunctions::bondZSpread(Size i,
+                                         const CurveSample* curve,
+                                         const std::vector<Real>* cleanPrices,
+                                         Real accuracy,
+                                         Size maxIterations,
+                                         Rate guess) const {
+        Real dirtyPrice = (*cleanPrices)[i];
+        if (dirtyPrice == Null<Real>())
+            return Null<Real>();
+        checkSample(i, *curve);
+
+        dirtyPrice += accruedAmounts_[i];
+        dirtyPrice /= 100.0 / notionals_[i];
+
+        Brent solver;
+        solver.setMaxEvaluations(maxIterations);
+        ZSpreadFinder objFunction(*this, i, *curve, dirtyPrice);
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
+}
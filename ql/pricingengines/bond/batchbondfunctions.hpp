@@ -0,0 +1,191 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchbondfunctions.hpp
+    \brief bond functions for many bonds at once
+*/
+
+#ifndef quantlib_batch_bond_functions_hpp
+#define quantlib_batch_bond_functions_hpp
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/instruments/bond.hpp>
+#include <ql/functional.hpp>
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    class YieldTermStructure;
+
+    //! BondFunctions for many bonds at once
+    /*! The yield, duration, convexity and Z-spread functions of
+        BondFunctions are calculated for all the added bonds in a
+        single call, e.g., for a whole portfolio under a curve
+        scenario.  The cash flows of each bond are compiled once,
+        when the bond is added (see CompiledLeg); the bonds are then
+        processed concurrently on a number of threads.
+
+        Each bond is added with the conventions of its yield and
+        Z-spread and with its settlement date, which are used by all
+        the functions.  The results are the same as those returned by
+        the corresponding BondFunctions functions called with the
+        same arguments.  The result for a bond whose price, yield or
+        spread is Null<Real>(), or on which the calculation fails
+        (e.g., because the solver doesn't converge), is Null<Real>();
+        in the latter case, errors() returns the reason.  Failures
+        other than a QuantLib::Error (e.g., running out of memory)
+        stop the calculation and are raised again by the function.
+
+        For the Z-spread functions, the zero rates of the discount
+        curve are sampled at the cash-flow dates on the calling
+        thread; only the spread is added on the worker threads, so
+        that the curve is never used concurrently.
+
+        \warning The amounts and accrued amounts are read when the
+                 bonds are added; bonds must be added again if they
+                 change, e.g., when the forecast curve of
+                 floating-rate coupons moves.
+
+        \warning The calculations store their error messages in the
+                 instance, so that they must not be called on the same
+                 instance from different threads at the same time,
+                 even though they are const.  Each calling thread
+                 should use its own instance.
+    */
+    class BatchBondFunctions : private boost::noncopyable {
+      public:
+        /*! The calling thread takes part in the calculations,
+            together with <tt>threads-1</tt> worker threads; if no
+            number is given, the number of hardware threads is used.
+        */
+        explicit BatchBondFunctions(Size threads = 0);
+        //! adds a bond and returns its position in the results
+        /*! If no settlement date is given, the bond settlement date
+            is used.
+        */
+        Size add(const Bond& bond,
+                 const DayCounter& dayCounter,
+                 Compounding compounding,
+                 Frequency frequency,
+                 Date settlementDate = Date());
+        //! removes all bonds added so far, and the last error messages
+        void clear();
+        //! \name Inspectors
+        //@{
+        Size size() const;
+        Size threads() const;
+        /*! the error messages of the last calculation, one for each
+            bond; the message is empty if the result is available or
+            if it was Null<Real>() because of missing input.
+        */
+        const std::vector<std::string>& errors() const;
+        //@}
+
+        //! \name Yield functions
+        /*! The arguments hold one yield or price for each bond, in
+            the order they were added.
+        */
+        //@{
+        std::vector<Real> cleanPrice(const std::vector<Rate>& yields) const;
+        std::vector<Real> dirtyPrice(const std::vector<Rate>& yields) const;
+        std::vector<Rate> yield(const std::vector<Real>& prices,
+                                Real accuracy = 1.0e-10,
+                                Size maxIterations = 100,
+                                Rate guess = 0.05,
+                                Bond::Price::Type priceType =
+                                                     Bond::Price::Clean) const;
+        std::vector<Time> duration(const std::vector<Rate>& yields,
+                                   Duration::Type type =
+                                                     Duration::Modified) const;
+        std::vector<Real> convexity(const std::vector<Rate>& yields) const;
+        //@}
+
+        //! \name Z-spread functions
+        //@{
+        std::vector<Real> cleanPrice(
+                     const ext::shared_ptr<YieldTermStructure>& discount,
+                     const std::vector<Spread>& zSpreads) const;
+        std::vector<Spread> zSpread(
+                     const std::vector<Real>& cleanPrices,
+                     const ext::shared_ptr<YieldTermStructure>& discount,
+                     Real accuracy = 1.0e-10,
+                     Size maxIterations = 100,
+                     Rate guess = 0.0) const;
+        //@}
+      private:
+        class ZSpreadFinder;
+        // zero rates of a discount curve at the discount times of
+        // each bond, preceded by those at its settlement date
+        struct CurveSample {
+            std::vector<Time> times;
+            std::vector<Rate> zeroRates;
+            // empty unless the sampling failed
+            std::vector<std::string> errors;
+        };
+        void sample(const YieldTermStructure& discount,
+                    CurveSample& curve) const;
+        Real npv(Size i, const CurveSample& curve, Spread zSpread) const;
+        // calculation for a single bond; run() calls it for each one
+        typedef ext::function<Real(Size)> BondCalculation;
+        std::vector<Real> run(const BondCalculation& f) const;
+        Real bondDirtyPrice(Size i, const std::vector<Rate>* yields) const;
+        Real bondCleanPrice(Size i, const std::vector<Rate>* yields) const;
+        Real bondYield(Size i, const std::vector<Real>* prices,
+                       Real accuracy, Size maxIterations, Rate guess,
+                       Bond::Price::Type priceType) const;
+        Real bondDuration(Size i, const std::vector<Rate>* yields,
+                          Duration::Type type) const;
+        Real bondConvexity(Size i, const std::vector<Rate>* yields) const;
+        Real bondSpreadedCleanPrice(Size i, const CurveSample* curve,
+                                    const std::vector<Spread>* zSpreads) const;
+        Real bondZSpread(Size i, const CurveSample* curve,
+                         const std::vector<Real>* cleanPrices,
+                         Real accuracy, Size maxIterations, Rate guess) const;
+        void checkSize(Size n) const;
+        void checkSample(Size i, const CurveSample& curve) const;
+
+        std::vector<CompiledLeg> legs_;
+        std::vector<Compounding> compoundings_;
+        std::vector<Frequency> frequencies_;
+        std::vector<Real> accruedAmounts_, notionals_;
+        // position of the data of each bond in a curve sample
+        std::vector<Size> offsets_;
+        Size threads_;
+        mutable std::vector<std::string> errors_;
+    };
+
+
+    // inline definitions
+
+    inline Size BatchBondFunctions::size() const {
+        return legs_.size();
+    }
+
+    inline Size BatchBondFunctions::threads() const {
+        return threads_;
+    }
+
+    inline const std::vector<std::string>&
+    BatchBondFunctions::errors() const {
+        return errors_;
+    }
+
+}
+
+#endif
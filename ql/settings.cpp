@@ -31,19 +31,48 @@ namespace QuantLib {
         return out << Date(p);
     }
 
-    Settings::Settings()
-    : includeReferenceDateEvents_(false),
-      enforcesTodaysHistoricFixings_(false) {}
+    thread_local Settings::Values* Settings::local_ = 0;
+
+    Settings::Values::Values()
+    : includeReferenceDateEvents(false),
+      enforcesTodaysHistoricFixings(false) {}
+
+    Settings::Settings() {}
 
     void Settings::anchorEvaluationDate() {
         // set to today's date if not already set.
-        if (evaluationDate_.value() == Date())
-            evaluationDate_ = Date::todaysDate();
+        DateProxy& evaluationDate = values().evaluationDate;
+        if (evaluationDate.value() == Date())
+            evaluationDate = Date::todaysDate();
         // If set, no-op since the date is already anchored.
     }
 
     void Settings::resetEvaluationDate() {
-        evaluationDate_ = Date();
+        values().evaluationDate = Date();
+    }
+
+    SettingsContext::SettingsContext() {
+        activate();
+    }
+
+    SettingsContext::SettingsContext(const Date& evaluationDate) {
+        activate();
+        values_.evaluationDate = evaluationDate;
+    }
+
+    SettingsContext::~SettingsContext() {
+        Settings::local_ = previous_;
+    }
+
+    void SettingsContext::activate() {
+        const Settings::Values& current = Settings::instance().values();
+        values_.evaluationDate = current.evaluationDate.value();
+        values_.includeReferenceDateEvents = current.includeReferenceDateEvents;
+        values_.includeTodaysCashFlows = current.includeTodaysCashFlows;
+        values_.enforcesTodaysHistoricFixings =
+            current.enforcesTodaysHistoricFixings;
+        previous_ = Settings::local_;
+        Settings::local_ = &values_;
     }
 
     SavedSettings::SavedSettings()
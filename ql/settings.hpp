@@ -33,9 +33,16 @@
 
 namespace QuantLib {
 
+    class SettingsContext;
+
     //! global repository for run-time library settings
+    /*! The settings are shared by all threads, unless a
+        SettingsContext is active on the calling thread; the
+        accessors below then return the settings of that context.
+    */
     class Settings : public Singleton<Settings> {
         friend class Singleton<Settings>;
+        friend class SettingsContext;
       private:
         Settings();
         class DateProxy : public ObservableValue<Date> {
@@ -45,6 +52,16 @@ namespace QuantLib {
             operator Date() const;
         };
         friend std::ostream& operator<<(std::ostream&, const DateProxy&);
+        struct Values {
+            Values();
+            DateProxy evaluationDate;
+            bool includeReferenceDateEvents;
+            boost::optional<bool> includeTodaysCashFlows;
+            bool enforcesTodaysHistoricFixings;
+        };
+        //! the settings in effect on the calling thread
+        Values& values();
+        const Values& values() const;
       public:
         //! the date at which pricing is to be performed.
         /*! Client code can inspect the evaluation date, as in:
@@ -108,10 +125,40 @@ namespace QuantLib {
         bool& enforcesTodaysHistoricFixings();
         bool enforcesTodaysHistoricFixings() const;
       private:
-        DateProxy evaluationDate_;
-        bool includeReferenceDateEvents_;
-        boost::optional<bool> includeTodaysCashFlows_;
-        bool enforcesTodaysHistoricFixings_;
+        Values global_;
+        // innermost context active on the calling thread, if any
+        static thread_local Values* local_;
+    };
+
+
+    //! thread-local run-time library settings
+    /*! While an instance exists, the settings accessed through
+        Settings::instance() on the thread that created it are its
+        own; they start as a copy of the settings in effect when it
+        was created.  Other threads are not affected, so that each
+        can run valuations at its own evaluation date without
+        locking.  SavedSettings created within the context save and
+        restore the settings of the context.
+
+        Contexts can be nested; they must be destroyed on the thread
+        that created them, in reverse order of creation.  Observers
+        registered with the evaluation date while a context is active
+        are notified of its changes within that context only.
+
+        \warning Settings::instance() must have been called at least
+                 once, e.g., to set the global evaluation date, before
+                 contexts are created concurrently.
+    */
+    class SettingsContext : private boost::noncopyable {
+      public:
+        SettingsContext();
+        //! starts from the given evaluation date
+        explicit SettingsContext(const Date& evaluationDate);
+        ~SettingsContext();
+      private:
+        void activate();
+        Settings::Values values_;
+        Settings::Values* previous_;
     };
 
 
@@ -142,36 +189,44 @@ namespace QuantLib {
         return *this;
     }
 
+    inline Settings::Values& Settings::values() {
+        return local_ ? *local_ : global_;
+    }
+
+    inline const Settings::Values& Settings::values() const {
+        return local_ ? *local_ : global_;
+    }
+
     inline Settings::DateProxy& Settings::evaluationDate() {
-        return evaluationDate_;
+        return values().evaluationDate;
     }
 
     inline const Settings::DateProxy& Settings::evaluationDate() const {
-        return evaluationDate_;
+        return values().evaluationDate;
     }
 
     inline bool& Settings::includeReferenceDateEvents() {
-        return includeReferenceDateEvents_;
+        return values().includeReferenceDateEvents;
     }
 
     inline bool Settings::includeReferenceDateEvents() const {
-        return includeReferenceDateEvents_;
+        return values().includeReferenceDateEvents;
     }
 
     inline boost::optional<bool>& Settings::includeTodaysCashFlows() {
-        return includeTodaysCashFlows_;
+        return values().includeTodaysCashFlows;
     }
 
     inline boost::optional<bool> Settings::includeTodaysCashFlows() const {
-        return includeTodaysCashFlows_;
+        return values().includeTodaysCashFlows;
     }
 
     inline bool& Settings::enforcesTodaysHistoricFixings() {
-        return enforcesTodaysHistoricFixings_;
+        return values().enforcesTodaysHistoricFixings;
     }
 
     inline bool Settings::enforcesTodaysHistoricFixings() const {
-        return enforcesTodaysHistoricFixings_;
+        return values().enforcesTodaysHistoricFixings;
     }
 
 }
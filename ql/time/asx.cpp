@@ -24,6 +24,8 @@
 #include <ql/time/asx.hpp>
 #include "ql_settings.hpp"
 #include "ql_utilities_dataparsers.hpp"
+#include <ql/time/futuresdatetable.hpp>
+#include <cstring>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -37,6 +39,19 @@
 //using std::string;
 
 namespace QuantLib {
+
+    namespace detail {
+
+        inline const FuturesDateTable& asxDates() {
+            // built once, on first use; thread-safe
+            static const FuturesDateTable dates(2, Friday,
+                                                QL_FUTURES_DATES_FIRST_YEAR,
+                                                QL_FUTURES_DATES_LAST_YEAR);
+            return dates;
+        }
+
+    }
+
     template <class ExtDate> inline
     bool ASX<ExtDate>::isASXdate(const ExtDate& dat, bool mainCycle) {
         auto date = to_DateLike(dat);
@@ -80,54 +95,16 @@ namespace QuantLib {
         QL_REQUIRE(isASXdate(date, false),
                    "{} is not an ASX date",date);
 
-        std::ostringstream ASXcode;
-        unsigned int y = to_DateLike(date).year() % 10;
-        switch(to_DateLike(date).month()) {
-          case January:
-            ASXcode << 'F' << y;
-            break;
-          case February:
-            ASXcode << 'G' << y;
-            break;
-          case March:
-            ASXcode << 'H' << y;
-            break;
-          case April:
-            ASXcode << 'J' << y;
-            break;
-          case May:
-            ASXcode << 'K' << y;
-            break;
-          case June:
-            ASXcode << 'M' << y;
-            break;
-          case July:
-            ASXcode << 'N' << y;
-            break;
-          case August:
-            ASXcode << 'Q' << y;
-            break;
-          case September:
-            ASXcode << 'U' << y;
-            break;
-          case October:
-            ASXcode << 'V' << y;
-            break;
-          case November:
-            ASXcode << 'X' << y;
-            break;
-          case December:
-            ASXcode << 'Z' << y;
-            break;
-          default:
-            QL_FAIL("not an ASX month (and it should have been)");
-        }
+        auto d = to_DateLike(date);
+        auto s = d.serialNumber();
+        std::string ASXcode{detail::futuresMonthCodes[d.month(s) - 1],
+                            char('0' + d.year(s) % 10)};
 
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        QL_ENSURE(isASXcode(ASXcode.str(), false),
-                  "the result {} is an invalid ASX code", ASXcode.str() );
+        QL_ENSURE(isASXcode(ASXcode, false),
+                  "the result {} is an invalid ASX code", ASXcode );
         #endif
-        return ASXcode.str();
+        return ASXcode;
     }
     template <class ExtDate> inline
     ExtDate ASX<ExtDate>::date(const std::string& asxCode,
@@ -135,65 +112,32 @@ namespace QuantLib {
         QL_REQUIRE(isASXcode(asxCode, false), "{} is not a valid ASX code", asxCode );
 
         DateLike<ExtDate> referenceExtDate{
-            (to_DateLike(refExtDate) != ExtDate() ?
+            (to_DateLike(refExtDate) != nullDate<ExtDate>() ?
                  refExtDate :
                  ExtDate(Settings<ExtDate>::instance().evaluationDate()))};
-        auto to_upper_copy = [](const std::string& s) { std::string res; for (auto i:s) res.push_back(std::toupper(i)); return res;};
-        std::string code = to_upper_copy(asxCode);
-        std::string ms = code.substr(0,1);
-        QuantLib::Month m;
-        if (ms=="F")      m = January;
-        else if (ms=="G") m = February;
-        else if (ms=="H") m = March;
-        else if (ms=="J") m = April;
-        else if (ms=="K") m = May;
-        else if (ms=="M") m = June;
-        else if (ms=="N") m = July;
-        else if (ms=="Q") m = August;
-        else if (ms=="U") m = September;
-        else if (ms=="V") m = October;
-        else if (ms=="X") m = November;
-        else if (ms=="Z") m = December;
-        else QL_FAIL("invalid ASX month letter");
-
-//        Year y = boost::lexical_cast<Year>(); // lexical_cast causes compilation errors with x64
-
-        Year y= io::to_integer(code.substr(1,1));
+        const char* ms = std::strchr(detail::futuresMonthCodes,
+                                     std::toupper(asxCode[0]));
+        QuantLib::Month m = QuantLib::Month(ms - detail::futuresMonthCodes + 1);
+
+        Year y = asxCode[1] - '0';
         /* year<1900 are not valid QuantLib years: to avoid a run-time
            exception few lines below we need to add 10 years right away */
         if (y==0 && referenceExtDate.year()<=1909) y+=10;
         Year referenceYear = (referenceExtDate.year() % 10);
         y += referenceExtDate.year() - referenceYear;
-        ExtDate result = ASX<ExtDate>::nextDate(DateAdaptor<ExtDate>::Date(1, m, y), false);
+        ExtDate result = DateAdaptor<ExtDate>::Date(detail::asxDates().date(m, y));
         if (result<referenceExtDate)
-            return ASX<ExtDate>::nextDate(DateAdaptor<ExtDate>::Date(1, m, y + 10), false);
+            return DateAdaptor<ExtDate>::Date(detail::asxDates().date(m, y + 10));
 
         return result;
     }
     template <class ExtDate> inline
     ExtDate ASX<ExtDate>::nextDate(const ExtDate& date, bool mainCycle) {
-        DateLike<ExtDate> refExtDate{(to_DateLike(date) == ExtDate() ?
+        DateLike<ExtDate> refExtDate{(to_DateLike(date) == nullDate<ExtDate>() ?
                                           ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
                                           date)};
-        Year y = refExtDate.year();
-        QuantLib::Month m = refExtDate.month();
-
-        Size offset = mainCycle ? 3 : 1;
-        Size skipMonths = offset-(m%offset);
-        if (skipMonths != offset || refExtDate.dayOfMonth() > 14) {
-            skipMonths += Size(m);
-            if (skipMonths<=12) {
-                m = QuantLib::Month(skipMonths);
-            } else {
-                m = QuantLib::Month(skipMonths-12);
-                y += 1;
-            }
-        }
-
-        ExtDate result = DateLike<ExtDate>::nthWeekday(2, Friday, m, y);
-        if (result<=refExtDate)
-            result = nextDate(DateAdaptor<ExtDate>::Date(15, m, y), mainCycle);
-        return result;
+        return DateAdaptor<ExtDate>::Date(
+            detail::asxDates().next(refExtDate.serialNumber(), mainCycle));
     }
     template <class ExtDate> inline
     ExtDate ASX<ExtDate>::nextDate(const std::string& ASXcode,
@@ -216,4 +160,29 @@ namespace QuantLib {
         return code(date);
     }
 
+    template <class ExtDate> inline
+    ExtDate ASX<ExtDate>::previousDate(const ExtDate& date, bool mainCycle) {
+        DateLike<ExtDate> refExtDate{(to_DateLike(date) == nullDate<ExtDate>() ?
+                                          ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
+                                          date)};
+        return DateAdaptor<ExtDate>::Date(
+            detail::asxDates().previous(refExtDate.serialNumber(), mainCycle));
+    }
+    template <class ExtDate> inline
+    std::vector<ExtDate> ASX<ExtDate>::nextDates(const ExtDate& date,
+                                                 Size n,
+                                                 bool mainCycle) {
+        DateLike<ExtDate> refExtDate{(to_DateLike(date) == nullDate<ExtDate>() ?
+                                          ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
+                                          date)};
+        std::vector<serial_type> serials(n);
+        detail::asxDates().next(refExtDate.serialNumber(), mainCycle,
+                                n, serials.data());
+        std::vector<ExtDate> result;
+        result.reserve(n);
+        for (serial_type s : serials)
+            result.push_back(DateAdaptor<ExtDate>::Date(s));
+        return result;
+    }
+
 }
@@ -29,6 +29,7 @@
 #define quantlib_asx_hpp
 
 #include <ql/time/date.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -63,13 +64,13 @@ namespace QuantLib {
                      string is not an ASX code
         */
         static ExtDate date(const std::string& asxCode,
-                         const ExtDate& referenceExtDate = ExtDate());
+                         const ExtDate& referenceExtDate = nullDate<ExtDate>());
 
         //! next ASX date following the given date
         /*! returns the 1st delivery date for next contract listed in the
             Australian Securities Exchange.
         */
-        static ExtDate nextDate(const ExtDate& d = ExtDate(),
+        static ExtDate nextDate(const ExtDate& d = nullDate<ExtDate>(),
                              bool mainCycle = true);
 
         //! next ASX date following the given ASX code
@@ -78,13 +79,13 @@ namespace QuantLib {
         */
         static ExtDate nextDate(const std::string& asxCode,
                              bool mainCycle = true,
-                             const ExtDate& referenceExtDate = ExtDate());
+                             const ExtDate& referenceExtDate = nullDate<ExtDate>());
 
         //! next ASX code following the given date
         /*! returns the ASX code for next contract listed in the
             Australian Securities Exchange
         */
-        static std::string nextCode(const ExtDate& d = ExtDate(),
+        static std::string nextCode(const ExtDate& d = nullDate<ExtDate>(),
                                     bool mainCycle = true);
 
         //! next ASX code following the given code
@@ -93,7 +94,16 @@ namespace QuantLib {
         */
         static std::string nextCode(const std::string& asxCode,
                                     bool mainCycle = true,
-                                    const ExtDate& referenceExtDate = ExtDate());
+                                    const ExtDate& referenceExtDate = nullDate<ExtDate>());
+
+        //! previous ASX date preceding the given date
+        static ExtDate previousDate(const ExtDate& d = nullDate<ExtDate>(),
+                                    bool mainCycle = true);
+
+        //! next \p n ASX dates following the given date
+        static std::vector<ExtDate> nextDates(const ExtDate& d,
+                                              Size n,
+                                              bool mainCycle = true);
     };
 
 }
@@ -0,0 +1,69 @@
+#include <catch2/catch.hpp>
+#include "bench_common.h"
+#include "shipped_calendars.h"
+
+using namespace QuantLib;
+
+namespace {
+
+    void benchmarkCalendar(const Calendar<eDate>& c,
+                           const std::vector<eDate>& dates,
+                           const std::string& prefix) {
+        BENCHMARK(prefix + " isBusinessDay") {
+            Size n = 0;
+            for (const auto& d : dates)
+                n += c.isBusinessDay(d);
+            return n;
+        };
+        BENCHMARK(prefix + " adjust") {
+            serial_type s = 0;
+            for (const auto& d : dates)
+                s += DAe::serialNumber(c.adjust(d, ModifiedFollowing));
+            return s;
+        };
+        BENCHMARK(prefix + " advance 2D") {
+            serial_type s = 0;
+            for (const auto& d : dates)
+                s += DAe::serialNumber(c.advance(d, 2, Days));
+            return s;
+        };
+        BENCHMARK(prefix + " advance 3M") {
+            serial_type s = 0;
+            for (const auto& d : dates)
+                s += DAe::serialNumber(c.advance(d, 3, Months, ModifiedFollowing));
+            return s;
+        };
+        std::vector<eDate> results(dates.size());
+        BENCHMARK(prefix + " batch adjust") {
+            c.adjust(dates, results, ModifiedFollowing);
+            return DAe::serialNumber(results.back());
+        };
+        BENCHMARK(prefix + " batch advance 2D") {
+            c.advance(dates, results, 2, Days);
+            return DAe::serialNumber(results.back());
+        };
+        BENCHMARK(prefix + " batch advance 3M") {
+            c.advance(dates, results, 3, Months, ModifiedFollowing);
+            return DAe::serialNumber(results.back());
+        };
+        BENCHMARK(prefix + " businessDaysBetween 1Y") {
+            serial_type s = 0;
+            for (Size i = 0; i + 365 < dates.size(); ++i)
+                s += c.businessDaysBetween(dates[i], dates[i + 365]);
+            return s;
+        };
+    }
+
+}
+
+// each benchmark runs over the dates from 2015 to 2018
+TEST_CASE("calendars", "[Calendar]") {
+    std::vector<eDate> dates = benchmarkDates();
+    for (auto& c : shippedCalendars<eDate>()) {
+        benchmarkCalendar(c, dates, c.name());
+
+        c.materialize(2014, 2020);
+        benchmarkCalendar(c, dates, c.name() + " (materialized)");
+        c.dematerialize();
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ql/time/date_like.hpp>
+#include "pseudo_dates.h"
+#include <vector>
+
+// Dates are those of the test suite, adapted from QuantLib::Date, so
+// that the timings include the cost of the DateLike conversions.
+using eDate = QuantLibDate;
+using DLe = QuantLib::DateLike<eDate>;
+using DAe = DateAdaptor<eDate>;
+
+// every calendar day from 1 January 2015 (four years by default)
+inline std::vector<eDate> benchmarkDates(QuantLib::Size n = 1461) {
+    std::vector<eDate> dates;
+    dates.reserve(n);
+    QuantLib::serial_type s = DAe::serialNumber(DAe::Date(1, QuantLib::January, 2015));
+    for (QuantLib::Size i = 0; i < n; ++i)
+        dates.push_back(DAe::Date(s + QuantLib::serial_type(i)));
+    return dates;
+}
@@ -0,0 +1,193 @@
+#include <catch2/catch.hpp>
+#include <ql/time/period.hpp>
+#include <ql/time/imm.hpp>
+#include <ql/time/asx.hpp>
+#include <ql/time/ecb.hpp>
+#include <ql/time/chrono_date_adaptor.hpp>
+#include <ql/time/calendars/target.hpp>
+#include "bench_common.h"
+
+using namespace QuantLib;
+
+// each benchmark runs over the dates from 2015 to 2018
+TEST_CASE("dates", "[DateLike]") {
+    std::vector<eDate> dates = benchmarkDates();
+    std::vector<serial_type> serials;
+    for (const auto& d : dates)
+        serials.push_back(DAe::serialNumber(d));
+
+    BENCHMARK("DateAdaptor serialNumber") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(d);
+        return s;
+    };
+    BENCHMARK("DateAdaptor Date from serial") {
+        std::vector<eDate> result;
+        result.reserve(serials.size());
+        for (auto s : serials)
+            result.push_back(DAe::Date(s));
+        return result;
+    };
+    BENCHMARK("DateAdaptor Date from day, month, year") {
+        std::vector<eDate> result;
+        result.reserve(dates.size());
+        for (const auto& d : dates) {
+            const DLe& l = to_DateLike(d);
+            result.push_back(DAe::Date(l.dayOfMonth(), l.month(), l.year()));
+        }
+        return result;
+    };
+    BENCHMARK("DateLike dayOfMonth, month, year") {
+        Integer n = 0;
+        for (const auto& d : dates) {
+            const DLe& l = to_DateLike(d);
+            n += l.dayOfMonth() + Integer(l.month()) + l.year();
+        }
+        return n;
+    };
+    BENCHMARK("DateLike weekday") {
+        Integer n = 0;
+        for (const auto& d : dates)
+            n += Integer(to_DateLike(d).weekday());
+        return n;
+    };
+    BENCHMARK("DateLike endOfMonth") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(DLe::endOfMonth(to_DateLike(d)));
+        return s;
+    };
+    BENCHMARK("DateLike plus days") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(to_DateLike(d) + 30);
+        return s;
+    };
+    BENCHMARK("DateLike plus 3M") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(to_DateLike(d) + 3 * Months);
+        return s;
+    };
+    BENCHMARK("DateLike plus 1Y") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(to_DateLike(d) + 1 * Years);
+        return s;
+    };
+}
+
+TEST_CASE("futures dates", "[DateLike]") {
+    std::vector<eDate> dates = benchmarkDates();
+    std::vector<std::string> codes;
+    for (const auto& d : dates)
+        codes.push_back(IMM<eDate>::nextCode(d));
+    // the known ECB dates end in 2017
+    std::vector<eDate> ecbDates;
+    for (const auto& d : dates)
+        if (to_DateLike(d) < DAe::Date(1, December, 2017))
+            ecbDates.push_back(d);
+
+    BENCHMARK("IMM nextDate") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(IMM<eDate>::nextDate(d));
+        return s;
+    };
+    BENCHMARK("IMM nextDates, 8 contracts") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(IMM<eDate>::nextDates(d, 8).back());
+        return s;
+    };
+    BENCHMARK("IMM code") {
+        Size n = 0;
+        for (const auto& d : dates)
+            n += IMM<eDate>::nextCode(d).size();
+        return n;
+    };
+    BENCHMARK("IMM date from code") {
+        serial_type s = 0;
+        for (Size i = 0; i < dates.size(); ++i)
+            s += DAe::serialNumber(IMM<eDate>::date(codes[i], dates[i]));
+        return s;
+    };
+    BENCHMARK("ASX nextDate") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(ASX<eDate>::nextDate(d));
+        return s;
+    };
+    BENCHMARK("ECB nextDate") {
+        serial_type s = 0;
+        for (const auto& d : ecbDates)
+            s += DAe::serialNumber(ECB<eDate>::nextDate(d));
+        return s;
+    };
+}
+
+// the same operations on the test dates and on std::chrono dates
+TEST_CASE("chrono dates", "[DateLike]") {
+    using std::chrono::sys_days;
+    using std::chrono::year_month_day;
+    std::vector<eDate> dates = benchmarkDates();
+    std::vector<sys_days> days;
+    std::vector<year_month_day> ymds;
+    for (const auto& d : dates) {
+        days.push_back(DateAdaptor<sys_days>::Date(DAe::serialNumber(d)));
+        ymds.push_back(DateAdaptor<year_month_day>::Date(DAe::serialNumber(d)));
+    }
+    Calendar<eDate> target = TARGET<eDate>();
+    Calendar<sys_days> chronoTarget = TARGET<sys_days>();
+    Calendar<year_month_day> ymdTarget = TARGET<year_month_day>();
+
+    BENCHMARK("DateLike month, test dates") {
+        Integer n = 0;
+        for (const auto& d : dates)
+            n += Integer(to_DateLike(d).month());
+        return n;
+    };
+    BENCHMARK("DateLike month, sys_days") {
+        Integer n = 0;
+        for (const auto& d : days)
+            n += Integer(to_DateLike(d).month());
+        return n;
+    };
+    BENCHMARK("DateLike month, year_month_day") {
+        Integer n = 0;
+        for (const auto& d : ymds)
+            n += Integer(to_DateLike(d).month());
+        return n;
+    };
+    BENCHMARK("TARGET isBusinessDay, test dates") {
+        Size n = 0;
+        for (const auto& d : dates)
+            n += target.isBusinessDay(d);
+        return n;
+    };
+    BENCHMARK("TARGET isBusinessDay, sys_days") {
+        Size n = 0;
+        for (const auto& d : days)
+            n += chronoTarget.isBusinessDay(d);
+        return n;
+    };
+    BENCHMARK("TARGET isBusinessDay, year_month_day") {
+        Size n = 0;
+        for (const auto& d : ymds)
+            n += ymdTarget.isBusinessDay(d);
+        return n;
+    };
+    BENCHMARK("TARGET advance 2D, test dates") {
+        serial_type s = 0;
+        for (const auto& d : dates)
+            s += DAe::serialNumber(target.advance(d, 2, Days));
+        return s;
+    };
+    BENCHMARK("TARGET advance 2D, sys_days") {
+        serial_type s = 0;
+        for (const auto& d : days)
+            s += DateAdaptor<sys_days>::serialNumber(chronoTarget.advance(d, 2, Days));
+        return s;
+    };
+}
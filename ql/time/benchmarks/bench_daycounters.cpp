@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/business252.hpp>
+#include <ql/time/daycounters/one.hpp>
+#include <ql/time/daycounters/simpledaycounter.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/daycounters/thirty365.hpp>
+#include <ql/time/calendars/brazil.hpp>
+#include "bench_common.h"
+
+using namespace QuantLib;
+
+namespace {
+
+    std::vector<DayCounter<eDate> > benchmarkDayCounters() {
+        std::vector<DayCounter<eDate> > dayCounters;
+        dayCounters.push_back(Actual360<eDate>());
+        dayCounters.push_back(Actual365Fixed<eDate>());
+        dayCounters.push_back(Actual365Fixed<eDate>(Actual365Fixed<eDate>::NoLeap));
+        dayCounters.push_back(ActualActual<eDate>(ActualActual<eDate>::ISDA));
+        dayCounters.push_back(ActualActual<eDate>(ActualActual<eDate>::ISMA));
+        dayCounters.push_back(ActualActual<eDate>(ActualActual<eDate>::AFB));
+        dayCounters.push_back(Thirty360<eDate>(Thirty360<eDate>::USA));
+        dayCounters.push_back(Thirty360<eDate>(Thirty360<eDate>::European));
+        dayCounters.push_back(Thirty360<eDate>(Thirty360<eDate>::Italian));
+        dayCounters.push_back(Thirty360<eDate>(Thirty360<eDate>::German));
+        dayCounters.push_back(Thirty365<eDate>());
+        dayCounters.push_back(SimpleDayCounter<eDate>());
+        dayCounters.push_back(OneDayCounter<eDate>());
+        dayCounters.push_back(Business252<eDate>(Brazil<eDate>()));
+        return dayCounters;
+    }
+
+}
+
+// each benchmark runs over one-year and three-month periods
+// starting on every day from 2015 to 2018
+TEST_CASE("dayCounters", "[DayCounter]") {
+    std::vector<eDate> dates = benchmarkDates(1461 + 365);
+    Size n = dates.size() - 365;
+    std::vector<eDate> start(dates.begin(), dates.begin() + n),
+                       end(dates.begin() + 365, dates.end());
+    std::vector<Time> fractions(n);
+
+    for (const auto& dc : benchmarkDayCounters()) {
+        BENCHMARK(dc.name() + " yearFraction 1Y") {
+            Time t = 0.0;
+            for (Size i = 0; i < n; ++i)
+                t += dc.yearFraction(start[i], end[i]);
+            return t;
+        };
+        BENCHMARK(dc.name() + " yearFraction 3M") {
+            Time t = 0.0;
+            for (Size i = 0; i < n; ++i)
+                t += dc.yearFraction(dates[i], dates[i + 91]);
+            return t;
+        };
+        BENCHMARK(dc.name() + " yearFractions 1Y") {
+            dc.yearFractions(std::span<const eDate>(start), std::span<const eDate>(end),
+                             std::span<Time>(fractions));
+            return fractions.back();
+        };
+    }
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+#include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/weekendsonly.hpp>
+#include "bench_common.h"
+#include <array>
+
+using namespace QuantLib;
+
+namespace {
+
+    struct ScheduleShape {
+        std::string name;
+        Period maturity, tenor;
+        Calendar<eDate> calendar;
+        BusinessDayConvention convention, terminationDateConvention;
+        DateGeneration::Rule rule;
+        bool endOfMonth;
+    };
+
+    std::vector<ScheduleShape> benchmarkShapes() {
+        return {
+            { "5Y semiannual fixed swap leg", 5 * Years, 6 * Months,
+              TARGET<eDate>(), ModifiedFollowing, ModifiedFollowing,
+              DateGeneration::Backward, false },
+            { "10Y quarterly floating swap leg", 10 * Years, 3 * Months,
+              JointCalendar<eDate>(TARGET<eDate>(),
+                                   UnitedKingdom<eDate>(UnitedKingdom<eDate>::Exchange)),
+              ModifiedFollowing, ModifiedFollowing,
+              DateGeneration::Backward, false },
+            { "30Y semiannual bond", 30 * Years, 6 * Months,
+              UnitedStates<eDate>(UnitedStates<eDate>::GovernmentBond),
+              Unadjusted, Unadjusted, DateGeneration::Backward, true },
+            { "10Y annual bond", 10 * Years, 1 * Years,
+              TARGET<eDate>(), Following, Following,
+              DateGeneration::Forward, false },
+            { "5Y quarterly CDS", 5 * Years, 3 * Months,
+              WeekendsOnly<eDate>(), Following, Unadjusted,
+              DateGeneration::CDS2015, false },
+        };
+    }
+
+}
+
+// each benchmark generates one schedule
+TEST_CASE("schedules", "[Schedule]") {
+    eDate effective = DAe::Date(17, March, 2021);
+    std::array<eDate, 256> dates;
+    std::array<bool, 256> isRegular;
+    ScheduleCache<eDate> cache;
+
+    for (const auto& s : benchmarkShapes()) {
+        eDate termination = to_DateLike(effective) + s.maturity;
+
+        BENCHMARK(std::string(s.name)) {
+            return Schedule<eDate>(effective, termination, s.tenor, s.calendar,
+                                   s.convention, s.terminationDateConvention,
+                                   s.rule, s.endOfMonth).size();
+        };
+        BENCHMARK(s.name + " (caller storage)") {
+            return generateSchedule(std::span<eDate>(dates), std::span<bool>(isRegular),
+                                    effective, termination, s.tenor, s.calendar,
+                                    s.convention, s.terminationDateConvention,
+                                    s.rule, s.endOfMonth);
+        };
+        BENCHMARK(s.name + " (cached)") {
+            return cache.schedule(effective, termination, s.tenor, s.calendar,
+                                  s.convention, s.terminationDateConvention,
+                                  s.rule, s.endOfMonth)->size();
+        };
+    }
+}
@@ -0,0 +1,39 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_DEFAULT_REPORTER "csv"
+#ifndef CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#endif
+#include <catch2/catch.hpp>
+
+// Reports one line per benchmark, times in nanoseconds, so that runs
+// can be collected and compared by scripts.  Use "-r xml" for Catch's
+// own machine-readable output, or "-r console" for a readable table.
+class CsvReporter : public Catch::StreamingReporterBase<CsvReporter> {
+  public:
+    using StreamingReporterBase::StreamingReporterBase;
+
+    static std::string getDescription() {
+        return "Reports benchmark results as comma-separated values";
+    }
+
+    void testRunStarting(Catch::TestRunInfo const& info) override {
+        StreamingReporterBase::testRunStarting(info);
+        stream << "benchmark,samples,iterations,mean_ns,mean_lower_ns,"
+                  "mean_upper_ns,std_dev_ns,outlier_variance\n";
+    }
+
+    void assertionStarting(Catch::AssertionInfo const&) override {}
+
+    bool assertionEnded(Catch::AssertionStats const&) override { return true; }
+
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override {
+        stream << '"' << stats.info.name << "\"," << stats.samples.size() << ','
+               << stats.info.iterations << ',' << stats.mean.point.count() << ','
+               << stats.mean.lower_bound.count() << ','
+               << stats.mean.upper_bound.count() << ','
+               << stats.standardDeviation.point.count() << ','
+               << stats.outlierVariance << '\n';
+    }
+};
+
+CATCH_REGISTER_REPORTER("csv", CsvReporter)
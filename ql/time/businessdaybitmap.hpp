@@ -0,0 +1,311 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file businessdaybitmap.hpp
+    \brief one-bit-per-day table of business days
+*/
+#pragma once
+#ifndef quantlib_business_day_bitmap_hpp
+#define quantlib_business_day_bitmap_hpp
+
+#include "ql_errors.hpp"
+#include <ql/time/date.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace QuantLib {
+
+    //! one-bit-per-day table of business days
+    /*! The table covers a contiguous range of serial numbers; each
+        day in the range is stored as a single bit, set if and only
+        if the day is a business day.  Alongside the bits, it keeps
+        the running count of business days at the start of each
+        64-day word, so that counting or skipping business days
+        takes a couple of lookups instead of a day-by-day walk.
+
+        It carries no calendar logic of its own: it is filled by
+        Calendar::materialize() and queried by Calendar methods.
+
+        A table can also be a read-only view on words and counts
+        stored elsewhere, e.g., in a memory-mapped file; copying it
+        then copies no data, and the first modification copies the
+        viewed data into storage of its own.
+    */
+    class BusinessDayBitmap {
+      public:
+        //! builds an empty table, covering no dates
+        BusinessDayBitmap() = default;
+        //! builds a table covering [first, last]
+        /*! \p isBusinessDay is called once for each serial number
+            in the range.
+        */
+        template <class F>
+        BusinessDayBitmap(serial_type first, serial_type last, F isBusinessDay);
+        //! builds a read-only view covering [first, last]
+        /*! \p words and \p counts must be laid out as returned by
+            words() and counts() for the same range; \p owner keeps
+            them alive as long as the view or any copy of it.
+        */
+        BusinessDayBitmap(serial_type first,
+                          serial_type last,
+                          const std::uint64_t* words,
+                          const std::int32_t* counts,
+                          std::shared_ptr<const void> owner);
+        //! \name Inspectors
+        //@{
+        bool empty() const;
+        serial_type first() const;
+        serial_type last() const;
+        //! whether the given serial number falls within the table
+        bool covers(serial_type s) const;
+        //! whether the given (covered) serial number is a business day
+        bool test(serial_type s) const;
+        //! number of business days in [first(), s] for a covered \p s
+        serial_type rank(serial_type s) const;
+        //! total number of business days in the table
+        serial_type total() const;
+        //! serial number of the <i>r</i>-th business day, for 1 <= r <= total()
+        serial_type select(serial_type r) const;
+        //! first business day on or after a covered \p s
+        /*! Returns 0 (the null date) if there is none in the table. */
+        serial_type following(serial_type s) const;
+        //! last business day on or before a covered \p s
+        /*! Returns 0 (the null date) if there is none in the table. */
+        serial_type preceding(serial_type s) const;
+        //! whether the table is a view on storage it doesn't own
+        bool isView() const;
+        //@}
+        //! \name Raw storage
+        /*! Bit <i>i</i> of the words is day first() + <i>i</i>;
+            count <i>w</i> is the number of business days before
+            word <i>w</i>, and the last count is the total.
+        */
+        //@{
+        std::span<const std::uint64_t> words() const;
+        std::span<const std::int32_t> counts() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        void set(serial_type s, bool isBusinessDay);
+        //! keeps the business days that are business days in \p other too
+        void intersect(const BusinessDayBitmap& other);
+        //! adds the business days of \p other
+        void unite(const BusinessDayBitmap& other);
+        //@}
+      private:
+        void checkSameRange(const BusinessDayBitmap& other) const;
+        void updateCounts();
+        // copies viewed storage before a modification
+        void detach();
+        std::size_t wordCount() const;
+        const std::uint64_t* bits() const;
+        const std::int32_t* cumulated() const;
+        serial_type first_ = 0;
+        std::size_t size_ = 0;
+        std::vector<std::uint64_t> bits_;
+        // business days before each word; the last entry is the total
+        std::vector<std::int32_t> counts_;
+        // viewed storage, if any, and whatever keeps it alive
+        const std::uint64_t* viewBits_ = nullptr;
+        const std::int32_t* viewCounts_ = nullptr;
+        std::shared_ptr<const void> owner_;
+    };
+
+
+    // inline definitions
+
+    template <class F>
+    inline BusinessDayBitmap::BusinessDayBitmap(serial_type first,
+                                                serial_type last,
+                                                F isBusinessDay)
+    : first_(first), size_(last >= first ? std::size_t(last - first + 1) : 0),
+      bits_((size_ + 63) / 64, 0), counts_(bits_.size() + 1, 0) {
+        QL_REQUIRE(last >= first, "empty business-day range [{}, {}]", first, last);
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (isBusinessDay(first_ + serial_type(i)))
+                bits_[i >> 6] |= std::uint64_t(1) << (i & 63);
+        }
+        updateCounts();
+    }
+
+    inline BusinessDayBitmap::BusinessDayBitmap(serial_type first,
+                                                serial_type last,
+                                                const std::uint64_t* words,
+                                                const std::int32_t* counts,
+                                                std::shared_ptr<const void> owner)
+    : first_(first), size_(last >= first ? std::size_t(last - first + 1) : 0),
+      viewBits_(words), viewCounts_(counts), owner_(std::move(owner)) {
+        QL_REQUIRE(last >= first, "empty business-day range [{}, {}]", first, last);
+        QL_REQUIRE(words && counts, "null business-day storage");
+    }
+
+    inline bool BusinessDayBitmap::empty() const {
+        return size_ == 0;
+    }
+
+    inline serial_type BusinessDayBitmap::first() const {
+        return first_;
+    }
+
+    inline serial_type BusinessDayBitmap::last() const {
+        return first_ + serial_type(size_) - 1;
+    }
+
+    inline bool BusinessDayBitmap::covers(serial_type s) const {
+        // a single unsigned comparison also rejects s < first_
+        return std::size_t(s - first_) < size_;
+    }
+
+    inline bool BusinessDayBitmap::test(serial_type s) const {
+        std::size_t i = std::size_t(s - first_);
+        return (bits()[i >> 6] >> (i & 63)) & 1U;
+    }
+
+    inline serial_type BusinessDayBitmap::rank(serial_type s) const {
+        std::size_t i = std::size_t(s - first_);
+        // bits 0 to (i & 63), both included
+        std::uint64_t mask = ~std::uint64_t(0) >> (63 - (i & 63));
+        return cumulated()[i >> 6] + std::popcount(bits()[i >> 6] & mask);
+    }
+
+    inline serial_type BusinessDayBitmap::total() const {
+        return empty() ? 0 : cumulated()[wordCount()];
+    }
+
+    inline serial_type BusinessDayBitmap::select(serial_type r) const {
+        QL_REQUIRE(r >= 1 && r <= total(),
+                   "business day #{} outside table range [1, {}]", r, total());
+        // last word starting with fewer than r business days
+        const std::int32_t* counts = cumulated();
+        const std::int32_t* it = std::lower_bound(counts, counts + wordCount() + 1, r) - 1;
+        std::size_t w = std::size_t(it - counts);
+        std::uint64_t word = bits()[w];
+        // drop the lower business days in the word
+        for (serial_type k = r - *it; k > 1; --k)
+            word &= word - 1;
+        return first_ + serial_type(w * 64 + std::countr_zero(word));
+    }
+
+    inline serial_type BusinessDayBitmap::following(serial_type s) const {
+        std::size_t i = std::size_t(s - first_), w = i >> 6;
+        const std::uint64_t* words = bits();
+        // bits (i & 63) to 63
+        std::uint64_t word = words[w] & (~std::uint64_t(0) << (i & 63));
+        while (word == 0) {
+            if (++w == wordCount())
+                return 0;
+            word = words[w];
+        }
+        return first_ + serial_type(w * 64 + std::countr_zero(word));
+    }
+
+    inline serial_type BusinessDayBitmap::preceding(serial_type s) const {
+        std::size_t i = std::size_t(s - first_), w = i >> 6;
+        const std::uint64_t* words = bits();
+        // bits 0 to (i & 63)
+        std::uint64_t word = words[w] & (~std::uint64_t(0) >> (63 - (i & 63)));
+        while (word == 0) {
+            if (w == 0)
+                return 0;
+            word = words[--w];
+        }
+        return first_ + serial_type(w * 64 + 63 - std::countl_zero(word));
+    }
+
+    inline bool BusinessDayBitmap::isView() const {
+        return viewBits_ != nullptr;
+    }
+
+    inline std::span<const std::uint64_t> BusinessDayBitmap::words() const {
+        return empty() ? std::span<const std::uint64_t>()
+                       : std::span<const std::uint64_t>(bits(), wordCount());
+    }
+
+    inline std::span<const std::int32_t> BusinessDayBitmap::counts() const {
+        return empty() ? std::span<const std::int32_t>()
+                       : std::span<const std::int32_t>(cumulated(), wordCount() + 1);
+    }
+
+    inline void BusinessDayBitmap::set(serial_type s, bool isBusinessDay) {
+        if (test(s) == isBusinessDay)
+            return;
+        detach();
+        std::size_t i = std::size_t(s - first_);
+        bits_[i >> 6] ^= std::uint64_t(1) << (i & 63);
+        std::int32_t delta = isBusinessDay ? 1 : -1;
+        for (std::size_t w = (i >> 6) + 1; w < counts_.size(); ++w)
+            counts_[w] += delta;
+    }
+
+    inline void BusinessDayBitmap::intersect(const BusinessDayBitmap& other) {
+        checkSameRange(other);
+        detach();
+        const std::uint64_t* words = other.bits();
+        for (std::size_t w = 0; w < bits_.size(); ++w)
+            bits_[w] &= words[w];
+        updateCounts();
+    }
+
+    inline void BusinessDayBitmap::unite(const BusinessDayBitmap& other) {
+        checkSameRange(other);
+        detach();
+        const std::uint64_t* words = other.bits();
+        for (std::size_t w = 0; w < bits_.size(); ++w)
+            bits_[w] |= words[w];
+        updateCounts();
+    }
+
+    inline void BusinessDayBitmap::checkSameRange(const BusinessDayBitmap& other) const {
+        QL_REQUIRE(first_ == other.first_ && size_ == other.size_,
+                   "business-day ranges [{}, {}] and [{}, {}] differ",
+                   first(), last(), other.first(), other.last());
+    }
+
+    inline void BusinessDayBitmap::updateCounts() {
+        for (std::size_t w = 0; w < bits_.size(); ++w)
+            counts_[w + 1] = counts_[w] + std::popcount(bits_[w]);
+    }
+
+    inline void BusinessDayBitmap::detach() {
+        if (!isView())
+            return;
+        bits_.assign(viewBits_, viewBits_ + wordCount());
+        counts_.assign(viewCounts_, viewCounts_ + wordCount() + 1);
+        viewBits_ = nullptr;
+        viewCounts_ = nullptr;
+        owner_.reset();
+    }
+
+    inline std::size_t BusinessDayBitmap::wordCount() const {
+        return (size_ + 63) / 64;
+    }
+
+    inline const std::uint64_t* BusinessDayBitmap::bits() const {
+        return viewBits_ ? viewBits_ : bits_.data();
+    }
+
+    inline const std::int32_t* BusinessDayBitmap::cumulated() const {
+        return viewCounts_ ? viewCounts_ : counts_.data();
+    }
+
+}
+
+#endif
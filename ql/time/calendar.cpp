@@ -24,6 +24,10 @@
 
 #include <ql/time/calendar.hpp>
 #include "ql_errors.hpp"
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace QuantLib {
     template <class ExtDate> inline 
@@ -42,6 +46,11 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+        // either way, it's a holiday now
+        serial_type s = to_DateLike(_d).serialNumber();
+        if (impl_->materialized.covers(s))
+            impl_->materialized.set(s, false);
+        impl_->edits.fetch_add(1, std::memory_order_relaxed);
     }
     template <class ExtDate> inline 
     void Calendar<ExtDate>::removeHoliday(const ExtDate& d) {
@@ -59,92 +68,377 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+        // either way, it's a business day now
+        serial_type s = to_DateLike(_d).serialNumber();
+        if (impl_->materialized.covers(s))
+            impl_->materialized.set(s, true);
+        impl_->edits.fetch_add(1, std::memory_order_relaxed);
     }
-    template <class ExtDate> inline 
-    ExtDate Calendar<ExtDate>::adjust(const ExtDate& dd,
-                          BusinessDayConvention c) const {
-        auto d = to_DateLike(dd);
-        QL_REQUIRE(d != ExtDate(), "null date");
-
-        if (c == Unadjusted)
-            return d;
-
-        DateLike<ExtDate> d1 = d;
-        if (c == Following || c == ModifiedFollowing 
-            || c == HalfMonthModifiedFollowing) {
-            while (isHoliday(d1))
-                ++d1;
-            if (c == ModifiedFollowing 
+    template <class ExtDate> inline
+    void Calendar<ExtDate>::materialize(Year firstYear, Year lastYear) {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(firstYear <= lastYear,
+                   "first year ({}) must not be later than last year ({})",
+                   firstYear, lastYear);
+
+        serial_type first =
+            to_DateLike(DateAdaptor<ExtDate>::Date(1, January, firstYear)).serialNumber();
+        serial_type last =
+            to_DateLike(DateAdaptor<ExtDate>::Date(31, December, lastYear)).serialNumber();
+
+        // fill the table aside, so that the current one (if any)
+        // doesn't shortcut the calculation
+        BusinessDayBitmap materialized = impl_->businessDays(first, last);
+        impl_->materialized = std::move(materialized);
+        impl_->materializedEdits = impl_->dependencyEdits();
+    }
+    template <class ExtDate> inline
+    BusinessDayBitmap Calendar<ExtDate>::Impl::businessDays(serial_type first,
+                                                            serial_type last) const {
+        return BusinessDayBitmap(first, last, [this](serial_type s) {
+            const ExtDate d = DateAdaptor<ExtDate>::Date(s);
+            if (addedHolidays.find(d) != addedHolidays.end())
+                return false;
+            if (removedHolidays.find(d) != removedHolidays.end())
+                return true;
+            return isBusinessDay(d);
+        });
+    }
+    template <class ExtDate> inline
+    unsigned long Calendar<ExtDate>::Impl::dependencyEdits() const {
+        unsigned long n = 0;
+        for (const auto& i : dependencies)
+            n += i->edits.load(std::memory_order_relaxed) +
+                 i->dependencyEdits();
+        return n;
+    }
+    template <class ExtDate> inline
+    void Calendar<ExtDate>::dematerialize() {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        impl_->materialized = BusinessDayBitmap();
+    }
+    namespace detail {
+
+        /* The algorithms below only need the calendar to provide
+           isHoliday(), isBusinessDay(), isEndOfMonth(), endOfMonth()
+           and adjust(), so that they can be shared by Calendar and
+           StaticCalendar. */
+
+        template <class ExtDate, class Cal> inline
+        ExtDate calendarAdjust(const Cal& calendar, const ExtDate& dd,
+                               BusinessDayConvention c) {
+            auto d = to_DateLike(dd);
+            QL_REQUIRE(d != nullDate<ExtDate>(), "null date");
+
+            if (c == Unadjusted)
+                return d;
+
+            DateLike<ExtDate> d1 = d;
+            if (c == Following || c == ModifiedFollowing 
                 || c == HalfMonthModifiedFollowing) {
-                if (d1.month() != d.month()) {
-                    return adjust(d, Preceding);
+                while (calendar.isHoliday(d1))
+                    ++d1;
+                if (c == ModifiedFollowing 
+                    || c == HalfMonthModifiedFollowing) {
+                    if (d1.month() != d.month()) {
+                        return calendar.adjust(d, Preceding);
+                    }
+                    if (c == HalfMonthModifiedFollowing) {
+                        if (d.dayOfMonth() <= 15 && d1.dayOfMonth() > 15) {
+                            return calendar.adjust(d, Preceding);
+                        }
+                    }
+                }
+            } else if (c == Preceding || c == ModifiedPreceding) {
+                while (calendar.isHoliday(d1))
+                    --d1;
+                if (c == ModifiedPreceding && d1.month() != d.month()) {
+                    return calendar.adjust(d,Following);
                 }
-                if (c == HalfMonthModifiedFollowing) {
-                    if (d.dayOfMonth() <= 15 && d1.dayOfMonth() > 15) {
-                        return adjust(d, Preceding);
+            } else if (c == Nearest) {
+                DateLike<ExtDate> d2 = d;
+                while (calendar.isHoliday(d1) && calendar.isHoliday(d2))
+                {
+                    ++d1;
+                    --d2;
+                }
+                if (calendar.isHoliday(d1))
+                    return d2;
+                else
+                    return d1;
+            } else {
+                QL_FAIL("unknown business-day convention");
+            }
+            return d1;
+        }
+
+        template <class ExtDate, class Cal> inline
+        ExtDate calendarAdvance(const Cal& calendar,
+                                const BusinessDayBitmap& materialized,
+                                const ExtDate& d,
+                                Integer n, TimeUnit unit,
+                                BusinessDayConvention c,
+                                bool endOfMonth) {
+            QL_REQUIRE(to_DateLike(d)!=nullDate<ExtDate>(), "null date");
+            if (n == 0) {
+                return calendar.adjust(d,c);
+            } else if (unit == Days) {
+                serial_type s = to_DateLike(d).serialNumber();
+                if (materialized.covers(s)) {
+                    // rank of the target among the business days in the table
+                    serial_type r = n > 0 ? materialized.rank(s) + n
+                                          : materialized.rank(s) - (materialized.test(s) ? 1 : 0) + n + 1;
+                    if (r >= 1 && r <= materialized.total())
+                        return DateAdaptor<ExtDate>::Date(materialized.select(r));
+                    // otherwise, the target is outside the table: walk to it
+                }
+                DateLike<ExtDate> d1{d};
+                if (n > 0) {
+                    while (n > 0) {
+                        ++d1;
+                        while (calendar.isHoliday(d1))
+                            ++d1;
+                        --n;
+                    }
+                } else {
+                    while (n < 0) {
+                        --d1;
+                        while(calendar.isHoliday(d1))
+                            --d1;
+                        ++n;
+                    }
+                }
+                return d1;
+            } else if (unit == Weeks) {
+                ExtDate d1 = to_DateLike(d) + n*unit;
+                return calendar.adjust(d1,c);
+            } else {
+                ExtDate d1 = to_DateLike(d) + n*unit;
+
+                // we are sure the unit is Months or Years
+                if (endOfMonth && calendar.isEndOfMonth(d))
+                    return calendar.endOfMonth(d1);
+
+                return calendar.adjust(d1, c);
+            }
+        }
+
+        template <class ExtDate, class Cal> inline
+        serial_type calendarBusinessDaysBetween(const Cal& calendar,
+                                                const BusinessDayBitmap& materialized,
+                                                const ExtDate& fro,
+                                                const ExtDate& t,
+                                                bool includeFirst,
+                                                bool includeLast) {
+            serial_type wd = 0;
+            const DateLike<ExtDate>& from = to_DateLike(fro);
+            const DateLike<ExtDate>& to = to_DateLike(t);
+            if (from != to) {
+                const DateLike<ExtDate>& lo = (from < to) ? from : to;
+                const DateLike<ExtDate>& hi = (from < to) ? to : from;
+                serial_type slo = lo.serialNumber(), shi = hi.serialNumber();
+                if (materialized.covers(slo) && materialized.covers(shi)) {
+                    // business days in [lo, hi]
+                    wd = materialized.rank(shi) - materialized.rank(slo)
+                        + (materialized.test(slo) ? 1 : 0);
+                } else {
+                    // the last one is treated separately to avoid
+                    // incrementing ExtDate::maxDate()
+                    for (auto d = lo; d < hi; ++d) {
+                        if (calendar.isBusinessDay(d))
+                            ++wd;
                     }
+                    if (calendar.isBusinessDay(hi))
+                        ++wd;
                 }
+
+                if (calendar.isBusinessDay(from) && !includeFirst)
+                    --wd;
+                if (calendar.isBusinessDay(to) && !includeLast)
+                    --wd;
+
+                if (from > to)
+                    wd = -wd;
+            } else if (includeFirst && includeLast && calendar.isBusinessDay(from)) {
+                wd = 1;
             }
-        } else if (c == Preceding || c == ModifiedPreceding) {
-            while (isHoliday(d1))
-                --d1;
-            if (c == ModifiedPreceding && d1.month() != d.month()) {
-                return adjust(d,Following);
+
+            return wd;
+        }
+
+        /* Batch counterparts of the algorithms above.  Business days
+           are looked up in the given table; the table functions below
+           return 0 when the result can't be read from it, in which
+           case the date goes through the scalar methods of the
+           calendar instead. */
+
+        inline serial_type tableFollowing(const BusinessDayBitmap& table,
+                                          serial_type s) {
+            return table.covers(s) ? table.following(s) : 0;
+        }
+
+        inline serial_type tablePreceding(const BusinessDayBitmap& table,
+                                          serial_type s) {
+            return table.covers(s) ? table.preceding(s) : 0;
+        }
+
+        template <BusinessDayConvention c> inline
+        serial_type tableAdjust(const BusinessDayBitmap& table, serial_type s) {
+            if constexpr (c == Unadjusted) {
+                return s;
+            } else if constexpr (c == Following) {
+                return tableFollowing(table, s);
+            } else if constexpr (c == ModifiedFollowing ||
+                                 c == HalfMonthModifiedFollowing) {
+                serial_type f = tableFollowing(table, s);
+                if (f == 0 || f == s)
+                    return f;
+                if (month(f) != month(s))
+                    return tablePreceding(table, s);
+                if (c == HalfMonthModifiedFollowing &&
+                    dayOfMonth(s) <= 15 && dayOfMonth(f) > 15)
+                    return tablePreceding(table, s);
+                return f;
+            } else if constexpr (c == Preceding) {
+                return tablePreceding(table, s);
+            } else if constexpr (c == ModifiedPreceding) {
+                serial_type p = tablePreceding(table, s);
+                if (p != 0 && p != s && month(p) != month(s))
+                    return tableFollowing(table, s);
+                return p;
+            } else {
+                static_assert(c == Nearest, "unknown business-day convention");
+                serial_type f = tableFollowing(table, s),
+                            p = tablePreceding(table, s);
+                if (f == 0 || p == 0)
+                    return 0;
+                return f - s <= s - p ? f : p;
             }
-        } else if (c == Nearest) {
-            DateLike<ExtDate> d2 = d;
-            while (isHoliday(d1) && isHoliday(d2))
-            {
-                ++d1;
-                --d2;
+        }
+
+        // for short distances, stepping through the next set bits
+        // is cheaper than the rank and select used by calendarAdvance
+        inline serial_type tableAdvanceDays(const BusinessDayBitmap& table,
+                                            serial_type s, Integer n) {
+            if (s == 0 || std::abs(n) > 32)
+                return 0;
+            for (; n > 0 && s != 0; --n)
+                s = tableFollowing(table, s + 1);
+            for (; n < 0 && s != 0; ++n)
+                s = tablePreceding(table, s - 1);
+            return s;
+        }
+
+        //! calls f with the convention as a compile-time constant
+        template <class F> inline
+        void withConvention(BusinessDayConvention c, F f) {
+            switch (c) {
+              case Following:
+                return f(std::integral_constant<BusinessDayConvention, Following>());
+              case ModifiedFollowing:
+                return f(std::integral_constant<BusinessDayConvention, ModifiedFollowing>());
+              case HalfMonthModifiedFollowing:
+                return f(std::integral_constant<BusinessDayConvention,
+                                                HalfMonthModifiedFollowing>());
+              case Preceding:
+                return f(std::integral_constant<BusinessDayConvention, Preceding>());
+              case ModifiedPreceding:
+                return f(std::integral_constant<BusinessDayConvention, ModifiedPreceding>());
+              case Unadjusted:
+                return f(std::integral_constant<BusinessDayConvention, Unadjusted>());
+              case Nearest:
+                return f(std::integral_constant<BusinessDayConvention, Nearest>());
+              default:
+                QL_FAIL("unknown business-day convention");
             }
-            if (isHoliday(d1))
-                return d2;
-            else
-                return d1;
-        } else {
-            QL_FAIL("unknown business-day convention");
         }
-        return d1;
+
+        //! smallest and largest serial numbers of the non-null dates
+        /*! Returns an empty range (last < first) if there are none. */
+        template <class ExtDate> inline
+        std::pair<serial_type, serial_type> serialRange(std::span<const ExtDate> dates) {
+            serial_type first = std::numeric_limits<serial_type>::max(), last = 0;
+            for (const ExtDate& d : dates) {
+                serial_type s = to_DateLike(d).serialNumber();
+                if (s != 0) {
+                    first = std::min(first, s);
+                    last = std::max(last, s);
+                }
+            }
+            return {first, last};
+        }
+
+        template <class ExtDate, class Cal> inline
+        void calendarAdjustAll(const Cal& calendar,
+                               const BusinessDayBitmap& table,
+                               std::span<const ExtDate> dates,
+                               std::span<ExtDate> adjusted,
+                               BusinessDayConvention c) {
+            withConvention(c, [&](auto convention) {
+                for (std::size_t i = 0; i < dates.size(); ++i) {
+                    // a copy, since adjusted might be the same array
+                    const ExtDate d = dates[i];
+                    serial_type s = to_DateLike(d).serialNumber();
+                    serial_type r = tableAdjust<decltype(convention)::value>(table, s);
+                    adjusted[i] = r == 0 ? calendar.adjust(d, c)
+                                : r == s ? d
+                                : DateAdaptor<ExtDate>::Date(r);
+                }
+            });
+        }
+
+        // for n != 0 and unit among Weeks, Months and Years
+        template <class ExtDate, class Cal> inline
+        void calendarAdvanceAll(const Cal& calendar,
+                                const BusinessDayBitmap& table,
+                                std::span<const ExtDate> dates,
+                                std::span<ExtDate> advanced,
+                                Integer n, TimeUnit unit,
+                                BusinessDayConvention c,
+                                bool endOfMonth) {
+            // as in calendarAdvance, weeks ignore the end-of-month rule
+            const bool checkEndOfMonth = endOfMonth && unit != Weeks;
+            withConvention(c, [&](auto convention) {
+                for (std::size_t i = 0; i < dates.size(); ++i) {
+                    const ExtDate d = dates[i];
+                    serial_type s = to_DateLike(d).serialNumber();
+                    serial_type s1 = s != 0 ? advance(s, n, unit) : 0, r = 0;
+                    if (s1 == 0) {
+                        // null date or out of range: left to the scalar method
+                    } else if (!checkEndOfMonth) {
+                        r = tableAdjust<decltype(convention)::value>(table, s1);
+                    } else if (serial_type f = tableFollowing(table, s + 1); f != 0) {
+                        if (month(f) != month(s)) {
+                            // d is at the end of its month, and so is the result
+                            Month m = month(s1);
+                            Year y = year(s1);
+                            r = tablePreceding(table,
+                                               serialNumber(Day(monthLength(m, isLeap(y))), m, y));
+                        } else {
+                            r = tableAdjust<decltype(convention)::value>(table, s1);
+                        }
+                    }
+                    advanced[i] = r != 0 ? DateAdaptor<ExtDate>::Date(r)
+                                         : calendar.advance(d, n, unit, c, endOfMonth);
+                }
+            });
+        }
+
+    }
+
+    template <class ExtDate> inline 
+    ExtDate Calendar<ExtDate>::adjust(const ExtDate& d,
+                          BusinessDayConvention c) const {
+        return detail::calendarAdjust(*this, d, c);
     }
     template <class ExtDate> inline 
     ExtDate Calendar<ExtDate>::advance(const ExtDate& d,
                            Integer n, TimeUnit unit,
                            BusinessDayConvention c,
                            bool endOfMonth) const {
-        QL_REQUIRE(to_DateLike(d)!=ExtDate(), "null date");
-        if (n == 0) {
-            return adjust(d,c);
-        } else if (unit == Days) {
-            DateLike<ExtDate> d1{d};
-            if (n > 0) {
-                while (n > 0) {
-                    ++d1;
-                    while (isHoliday(d1))
-                        ++d1;
-                    --n;
-                }
-            } else {
-                while (n < 0) {
-                    --d1;
-                    while(isHoliday(d1))
-                        --d1;
-                    ++n;
-                }
-            }
-            return d1;
-        } else if (unit == Weeks) {
-            ExtDate d1 = to_DateLike(d) + n*unit;
-            return adjust(d1,c);
-        } else {
-            ExtDate d1 = to_DateLike(d) + n*unit;
-
-            // we are sure the unit is Months or Years
-            if (endOfMonth && isEndOfMonth(d))
-                return Calendar<ExtDate>::endOfMonth(d1);
-
-            return adjust(d1, c);
-        }
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        return detail::calendarAdvance(*this, materializedTable(),
+                                       d, n, unit, c, endOfMonth);
     }
     template <class ExtDate> inline 
     ExtDate Calendar<ExtDate>::advance(const ExtDate & d,
@@ -153,57 +447,115 @@ namespace QuantLib {
                            bool endOfMonth) const {
         return advance(d, p.length(), p.units(), c, endOfMonth);
     }
+    template <class ExtDate> inline
+    const BusinessDayBitmap& Calendar<ExtDate>::batchTable(serial_type first,
+                                                           serial_type last,
+                                                           Size count,
+                                                           BusinessDayBitmap& local) const {
+        const BusinessDayBitmap& materialized = materializedTable();
+        if (materialized.covers(first) && materialized.covers(last))
+            return materialized;
+        first = std::max(first, DateLike<ExtDate>::minDate().serialNumber());
+        last = std::min(last, DateLike<ExtDate>::maxDate().serialNumber());
+        // a table of our own pays off when it has no more days than
+        // the scalar methods would check, i.e., about two per date
+        if (last >= first && Size(last - first + 1) <= 2 * count) {
+            local = impl_->businessDays(first, last);
+            return local;
+        }
+        return materialized;
+    }
+    template <class ExtDate> inline
+    void Calendar<ExtDate>::adjust(std::span<const ExtDate> dates,
+                                   std::span<ExtDate> adjusted,
+                                   BusinessDayConvention c) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(adjusted.size() == dates.size(),
+                   "{} dates given, {} results expected", dates.size(), adjusted.size());
+        auto [first, last] = detail::serialRange(dates);
+        // margins for the business days around the first and last date
+        BusinessDayBitmap local;
+        const BusinessDayBitmap& table = batchTable(first - 7, last + 7, dates.size(), local);
+        detail::calendarAdjustAll(*this, table, dates, adjusted, c);
+    }
+    template <class ExtDate> inline
+    void Calendar<ExtDate>::advance(std::span<const ExtDate> dates,
+                                    std::span<ExtDate> advanced,
+                                    Integer n, TimeUnit unit,
+                                    BusinessDayConvention c,
+                                    bool endOfMonth) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(advanced.size() == dates.size(),
+                   "{} dates given, {} results expected", dates.size(), advanced.size());
+        if (n == 0) {
+            adjust(dates, advanced, c);
+            return;
+        }
+        auto [first, last] = detail::serialRange(dates);
+        BusinessDayBitmap local;
+        if (unit == Days) {
+            // about seven calendar days for each five business days,
+            // plus some room for holidays
+            serial_type margin = 2 * std::abs(n) + 7;
+            const BusinessDayBitmap& table =
+                batchTable(n > 0 ? first : first - margin,
+                           n > 0 ? last + margin : last,
+                           dates.size(), local);
+            for (std::size_t i = 0; i < dates.size(); ++i) {
+                const ExtDate d = dates[i];
+                serial_type r = detail::tableAdvanceDays(
+                    table, to_DateLike(d).serialNumber(), n);
+                advanced[i] = r != 0 ? DateAdaptor<ExtDate>::Date(r)
+                                     : detail::calendarAdvance(*this, table, d, n, unit,
+                                                               c, endOfMonth);
+            }
+        } else if (unit == Weeks || unit == Months || unit == Years) {
+            // the table must cover both the dates (for the end-of-month
+            // check) and their targets
+            serial_type shift = 0;
+            if (last >= first) {
+                serial_type target = detail::advance(first, n, unit);
+                shift = target != 0 ? target - first : 0;
+            }
+            const BusinessDayBitmap& table =
+                batchTable(std::min(first, first + shift) - 7,
+                           std::max(last, last + shift) + 7,
+                           dates.size(), local);
+            detail::calendarAdvanceAll(*this, table, dates, advanced,
+                                       n, unit, c, endOfMonth);
+        } else {
+            for (std::size_t i = 0; i < dates.size(); ++i) {
+                const ExtDate d = dates[i];
+                advanced[i] = advance(d, n, unit, c, endOfMonth);
+            }
+        }
+    }
+    template <class ExtDate> inline
+    void Calendar<ExtDate>::advance(std::span<const ExtDate> dates,
+                                    std::span<ExtDate> advanced,
+                                    const Period& p,
+                                    BusinessDayConvention c,
+                                    bool endOfMonth) const {
+        advance(dates, advanced, p.length(), p.units(), c, endOfMonth);
+    }
     template <class ExtDate>
     inline 
-    serial_type Calendar<ExtDate>::businessDaysBetween(const ExtDate& fro,
+    serial_type Calendar<ExtDate>::businessDaysBetween(const ExtDate& from,
                                                     const ExtDate& to,
                                                     bool includeFirst,
                                                     bool includeLast) const {
-        serial_type wd = 0;
-        auto from = to_DateLike(fro);
-        if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing ExtDate::maxDate()
-                for (auto d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (auto d = to_DateLike(to); d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
-            }
-
-            if (isBusinessDay(from) && !includeFirst)
-                --wd;
-            if (isBusinessDay(to) && !includeLast)
-                --wd;
-
-            if (from > to)
-                wd = -wd;
-        } else if (includeFirst && includeLast && isBusinessDay(from)) {
-            wd = 1;
-        }
-
-        return wd;
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        return detail::calendarBusinessDaysBetween(*this, materializedTable(),
+                                                   from, to,
+                                                   includeFirst, includeLast);
     }
 
 
 
-   // Western calendars
-    template <class ExtDate> inline 
-    bool Calendar<ExtDate>::WesternImpl::isWeekend(Weekday w) const {
-        return w == Saturday || w == Sunday;
-    }
-    template <class ExtDate> inline 
-    Day Calendar<ExtDate>::WesternImpl::easterMonday(Year y) {
-        static const Day EasterMonday[] = {
+    namespace detail {
+
+        // Easter Mondays for 1901-2199, expressed relative to first day of year
+        inline constexpr Day WesternEasterMonday[] = {
                   98,  90, 103,  95, 114, 106,  91, 111, 102,   // 1901-1909
              87, 107,  99,  83, 103,  95, 115,  99,  91, 111,   // 1910-1919
              96,  87, 107,  92, 112, 103,  95, 108, 100,  91,   // 1920-1929
@@ -235,17 +587,8 @@ namespace QuantLib {
             108,  92, 112, 104,  89, 108, 100,  85, 105,  96,   // 2180-2189
             116, 101,  93, 112,  97,  89, 109, 100,  85, 105    // 2190-2199
         };
-        return EasterMonday[y-1901];
-    }
 
-    // Orthodox calendars
-    template <class ExtDate> inline 
-    bool Calendar<ExtDate>::OrthodoxImpl::isWeekend(Weekday w) const {
-        return w == Saturday || w == Sunday;
-    }
-    template <class ExtDate> inline 
-    Day Calendar<ExtDate>::OrthodoxImpl::easterMonday(Year y) {
-        static const Day EasterMonday[] = {
+        inline constexpr Day OrthodoxEasterMonday[] = {
                  105, 118, 110, 102, 121, 106, 126, 118, 102,   // 1901-1909
             122, 114,  99, 118, 110,  95, 115, 106, 126, 111,   // 1910-1919
             103, 122, 107,  99, 119, 110, 123, 115, 107, 126,   // 1920-1929
@@ -277,20 +620,41 @@ namespace QuantLib {
             108,  99, 119, 104, 124, 115, 100, 120, 112, 103,   // 2180-2189
             116, 108, 128, 119, 104, 124, 116, 100, 120, 112    // 2190-2199
         };
-        return EasterMonday[y-1901];
+
+        constexpr Day westernEasterMonday(Year y) {
+            return WesternEasterMonday[y-1901];
+        }
+
+        constexpr Day orthodoxEasterMonday(Year y) {
+            return OrthodoxEasterMonday[y-1901];
+        }
+
+    }
+
+   // Western calendars
+    template <class ExtDate> inline 
+    bool Calendar<ExtDate>::WesternImpl::isWeekend(Weekday w) const {
+        return w == Saturday || w == Sunday;
+    }
+    template <class ExtDate> inline 
+    constexpr Day Calendar<ExtDate>::WesternImpl::easterMonday(Year y) {
+        return detail::westernEasterMonday(y);
+    }
+
+    // Orthodox calendars
+    template <class ExtDate> inline 
+    bool Calendar<ExtDate>::OrthodoxImpl::isWeekend(Weekday w) const {
+        return w == Saturday || w == Sunday;
+    }
+    template <class ExtDate> inline 
+    constexpr Day Calendar<ExtDate>::OrthodoxImpl::easterMonday(Year y) {
+        return detail::orthodoxEasterMonday(y);
     }
     template <class ExtDate> inline 
     std::vector<ExtDate> Calendar<ExtDate>::holidayList(const Calendar& calendar,
         const ExtDate& from, const ExtDate& to, bool includeWeekEnds) {
 
-        QL_REQUIRE(to>from, "'from' date ({}) must be earlier than 'to' date ({})",from,to);
-        std::vector<ExtDate> result;
-        for (ExtDate d = from; d <= to; ++d) {
-            if (calendar.isHoliday(d)
-                && (includeWeekEnds || !calendar.isWeekend(d.weekday())))
-                result.push_back(d);
-       }
-       return result;
+        return calendar.holidayList(from, to, includeWeekEnds);
     }
     template <class ExtDate> inline 
     std::vector<ExtDate> Calendar<ExtDate>::holidayList(
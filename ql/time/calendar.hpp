@@ -31,14 +31,19 @@
 #include "ql_errors.hpp"
 #include <ql/time/date_like.hpp>
 #include <ql/time/businessdayconvention.hpp>
+#include <ql/time/businessdaybitmap.hpp>
 //#include <ql/shared_ptr.hpp>
+#include <atomic>
+#include <memory>
 #include <set>
+#include <span>
 #include <vector>
 #include <string>
 
 namespace QuantLib {
 
     class Period;
+    template <class ExtDate> class StaticCalendar;
 
     //! %calendar class
     /*! This class provides methods for determining whether a date is a
@@ -60,6 +65,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Calendar {
+        friend class StaticCalendar<ExtDate>;
       public:
         using setExtDate = std::set<ExtDate, Less<ExtDate> >;
 
@@ -71,9 +77,43 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const ExtDate&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            //! business days in [first, last], edits included
+            /*! The default implementation checks the rules and the
+                added and removed holidays day by day.
+            */
+            virtual BusinessDayBitmap businessDays(serial_type first,
+                                                   serial_type last) const;
+            //! total number of holiday edits of the dependencies
+            unsigned long dependencyEdits() const;
             setExtDate addedHolidays, removedHolidays;
+            //! number of calls to addHoliday() and removeHoliday()
+            /*! Atomic, since caches such as Business252 read it on
+                other threads.  It doesn't guard the holiday sets:
+                calendars must still not be edited while they are
+                used on other threads.
+            */
+            std::atomic<unsigned long> edits{0};
+            //! implementations whose holidays this one is built on
+            std::vector<std::shared_ptr<const Impl> > dependencies;
+            //! precomputed business days, see Calendar::materialize()
+            BusinessDayBitmap materialized;
+            //! dependencyEdits() when the table was built
+            unsigned long materializedEdits = 0;
         };
         std::shared_ptr<Impl> impl_;
+        //! the implementation of another calendar
+        /*! To be used by calendars built on others, such as
+            JointCalendar, to fill their dependencies.
+        */
+        static std::shared_ptr<const Impl> implementation(const Calendar& c);
+      private:
+        //! the precomputed table, or an empty one if it is out of date
+        const BusinessDayBitmap& materializedTable() const;
+        //! the table to be used for a batch of dates in [first, last]
+        const BusinessDayBitmap& batchTable(serial_type first,
+                                            serial_type last,
+                                            Size count,
+                                            BusinessDayBitmap& local) const;
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -121,6 +161,52 @@ namespace QuantLib {
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const ExtDate&);
 
+        /*! Precomputes one bit per day, from January 1st of the first
+            year to December 31st of the last one, so that
+            isBusinessDay() becomes a single bit test within that
+            range.  Dates outside the range are still checked against
+            the calendar rules.  Added and removed holidays are
+            included in the table and kept in sync by addHoliday()
+            and removeHoliday().
+
+            The table also indexes the cumulative number of business
+            days, so that businessDaysBetween() and advance() by a
+            number of days take a couple of lookups when the dates
+            involved fall within the range.
+
+            For calendars built on others, such as JointCalendar,
+            the table is combined from those of the underlying
+            calendars.  It goes out of date, and is no longer used,
+            as soon as holidays are added to or removed from any of
+            the underlying calendars; materialize() must then be
+            called again to rebuild it.
+
+            \note Like added holidays, the table is shared by all the
+                  instances linked to the same implementation.
+                  Results are unchanged; only their cost is.
+        */
+        void materialize(Year firstYear, Year lastYear);
+        /*! Discards the precomputed business days, if any. */
+        void dematerialize();
+        /*! Returns <tt>true</tt> iff business days were precomputed
+            and are up to date.
+        */
+        bool isMaterialized() const;
+        /*! Returns an owner of the calendar implementation, for use
+            as a key by caches of calendar-dependent results.
+            Calendars share their holidays, including the added and
+            removed ones, iff they share their implementation; unlike
+            name(), this tells apart different calendars reporting
+            the same name.  The returned pointer doesn't keep the
+            implementation alive.
+        */
+        std::weak_ptr<const void> id() const;
+        /*! Returns the number of holidays added to or removed from
+            the calendar, and from the calendars it is built on, so
+            far; it changes whenever their business days do.
+        */
+        unsigned long holidayEdits() const;
+
         /*! Returns the holidays between two dates.
 
             \deprecated Use the non-static overload.
@@ -162,6 +248,41 @@ namespace QuantLib {
                      const Period& period,
                      BusinessDayConvention convention = Following,
                      bool endOfMonth = false) const;
+        /*! Adjusts each of the given dates as the scalar overload
+            would, and writes the results in \p adjusted, which must
+            have the same size; the two can be the same array.
+
+            The convention is resolved once for the whole batch, and
+            business days are found by scanning the precomputed
+            table (see materialize()) for the next or previous set
+            bit.  If the calendar is not materialized and the dates
+            are dense enough, a table covering them is built for the
+            occasion, so that the holiday rules are checked once per
+            day rather than once per date.  Dates that fall outside
+            the table go through the scalar methods.
+        */
+        void adjust(std::span<const ExtDate> dates,
+                    std::span<ExtDate> adjusted,
+                    BusinessDayConvention convention = Following) const;
+        /*! Advances each of the given dates as the scalar overload
+            would, and writes the results in \p advanced, which must
+            have the same size; the two can be the same array.  See
+            the batch adjust() for details.
+        */
+        void advance(std::span<const ExtDate> dates,
+                     std::span<ExtDate> advanced,
+                     Integer n,
+                     TimeUnit unit,
+                     BusinessDayConvention convention = Following,
+                     bool endOfMonth = false) const;
+        /*! Advances each of the given dates as specified by the given
+            period; see the batch adjust() for details.
+        */
+        void advance(std::span<const ExtDate> dates,
+                     std::span<ExtDate> advanced,
+                     const Period& period,
+                     BusinessDayConvention convention = Following,
+                     bool endOfMonth = false) const;
         /*! Calculates the number of business days between two given
             dates and returns the result.
         */
@@ -181,7 +302,7 @@ namespace QuantLib {
           public:
             bool isWeekend(Weekday) const;
             //! expressed relative to first day of year
-            static Day easterMonday(Year);
+            static constexpr Day easterMonday(Year);
         };
         //! partial calendar implementation
         /*! This class provides the means of determining the Orthodox
@@ -192,7 +313,7 @@ namespace QuantLib {
           public:
             bool isWeekend(Weekday) const;
             //! expressed relative to first day of year
-            static Day easterMonday(Year);
+            static constexpr Day easterMonday(Year);
         };
     };
 
@@ -246,6 +367,13 @@ namespace QuantLib {
         const ExtDate& _d = d;
 #endif
 
+        const BusinessDayBitmap& materialized = materializedTable();
+        if (!materialized.empty()) {
+            serial_type s = to_DateLike(_d).serialNumber();
+            if (materialized.covers(s))
+                return materialized.test(s);
+        }
+
         if (!impl_->addedHolidays.empty() &&
             impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
             return false;
@@ -257,6 +385,41 @@ namespace QuantLib {
         return impl_->isBusinessDay(_d);
     }
 
+    template <class ExtDate> inline  bool Calendar<ExtDate>::isMaterialized() const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        return !materializedTable().empty();
+    }
+
+    template <class ExtDate> inline
+    std::weak_ptr<const void> Calendar<ExtDate>::id() const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        return impl_;
+    }
+
+    template <class ExtDate> inline
+    unsigned long Calendar<ExtDate>::holidayEdits() const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        return impl_->edits.load(std::memory_order_relaxed) +
+            impl_->dependencyEdits();
+    }
+
+    template <class ExtDate> inline
+    const BusinessDayBitmap& Calendar<ExtDate>::materializedTable() const {
+        // only an existing table can be out of date
+        if (impl_->materialized.empty() || impl_->dependencies.empty() ||
+            impl_->dependencyEdits() == impl_->materializedEdits)
+            return impl_->materialized;
+        static const BusinessDayBitmap outOfDate;
+        return outOfDate;
+    }
+
+    template <class ExtDate> inline
+    std::shared_ptr<const typename Calendar<ExtDate>::Impl>
+    Calendar<ExtDate>::implementation(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no calendar implementation provided");
+        return c.impl_;
+    }
+
     template <class ExtDate> inline  bool Calendar<ExtDate>::isEndOfMonth(const ExtDate& d) const {
         auto dd = to_DateLike(d);
         return (dd.month() != to_DateLike(adjust(dd+1)).month());
@@ -290,4 +453,6 @@ namespace QuantLib {
 
 }
 #include "calendar.cpp"
+#include "externtemplates.hpp"
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Calendar)
 #endif
@@ -65,4 +65,6 @@ namespace QuantLib {
 }
 
 #include "bespokecalendar.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::BespokeCalendar)
 #endif
@@ -76,6 +76,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Brazil : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -98,5 +99,7 @@ namespace QuantLib {
 }
 
 #include "brazil.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Brazil)
 #endif
 
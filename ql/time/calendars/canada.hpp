@@ -70,6 +70,7 @@ namespace QuantLib {
         \ingroup calendars
     */template <class ExtDate=Date>
     class Canada : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -91,4 +92,6 @@ namespace QuantLib {
 }
 #include "canada.cpp"
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Canada)
 #endif
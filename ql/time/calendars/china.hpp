@@ -57,6 +57,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class China : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SseImpl : public Calendar<ExtDate>::Impl {
           public:
@@ -84,4 +85,6 @@ namespace QuantLib {
 }
 
 #include "china.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::China)
 #endif
@@ -111,6 +111,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Germany : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -152,4 +153,6 @@ namespace QuantLib {
 }
 
 #include "germany.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Germany)
 #endif
@@ -35,11 +35,13 @@ namespace QuantLib {
         }
     }
     template <class ExtDate> inline
-    bool HongKong<ExtDate>::HkexImpl::isBusinessDay(const ExtDate& date) const {
-        Weekday w = date.weekday();
-        Day d = date.dayOfMonth(), dd = date.dayOfYear();
-        Month m = date.month();
-        Year y = date.year();
+    bool HongKong<ExtDate>::HkexImpl::isBusinessDay(const ExtDate& edate) const {
+        auto& date = to_DateLike(edate);
+        auto sn = date.serialNumber();
+        Weekday w = date.weekday(sn);
+        Day d = date.dayOfMonth(sn), dd = date.dayOfYear(sn);
+        Month m = date.month(sn);
+        Year y = date.year(sn);
         Day em = this->easterMonday(y);
 
         if (this->isWeekend(w)
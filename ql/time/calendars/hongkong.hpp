@@ -61,6 +61,7 @@ namespace QuantLib {
         \ingroup Calendar<ExtDate>s
     */template <class ExtDate=Date>
     class HongKong : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class HkexImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -76,4 +77,6 @@ namespace QuantLib {
 }
 #include "hongkong.cpp"
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::HongKong)
 #endif
@@ -69,6 +69,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Italy : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -91,4 +92,6 @@ namespace QuantLib {
 }
 
 #include "italy.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Italy)
 #endif
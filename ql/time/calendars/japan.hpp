@@ -61,6 +61,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Japan : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class Impl : public Calendar<ExtDate>::Impl {
           public:
@@ -75,4 +76,6 @@ namespace QuantLib {
 }
 
 #include "japan.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Japan)
 #endif
@@ -28,37 +28,29 @@ namespace QuantLib {
     JointCalendar<ExtDate>::Impl::Impl(const Calendar<ExtDate>& c1,
                               const Calendar<ExtDate>& c2,
                               JointCalendarRule r)
-    : rule_(r), calendars_(2) {
-        calendars_[0] = c1;
-        calendars_[1] = c2;
-    }
+    : Impl(std::vector<Calendar<ExtDate>>{c1, c2}, r) {}
 
     template <class ExtDate> inline
     JointCalendar<ExtDate>::Impl::Impl(const Calendar<ExtDate>& c1,
                               const Calendar<ExtDate>& c2,
                               const Calendar<ExtDate>& c3,
                               JointCalendarRule r)
-    : rule_(r), calendars_(3) {
-        calendars_[0] = c1;
-        calendars_[1] = c2;
-        calendars_[2] = c3;
-    }
+    : Impl(std::vector<Calendar<ExtDate>>{c1, c2, c3}, r) {}
     template <class ExtDate> inline
     JointCalendar<ExtDate>::Impl::Impl(const Calendar<ExtDate>& c1,
                               const Calendar<ExtDate>& c2,
                               const Calendar<ExtDate>& c3,
                               const Calendar<ExtDate>& c4,
                               JointCalendarRule r)
-    : rule_(r), calendars_(4) {
-        calendars_[0] = c1;
-        calendars_[1] = c2;
-        calendars_[2] = c3;
-        calendars_[3] = c4;
-    }
+    : Impl(std::vector<Calendar<ExtDate>>{c1, c2, c3, c4}, r) {}
     template <class ExtDate> inline
     JointCalendar<ExtDate>::Impl::Impl(const std::vector<Calendar<ExtDate>> &cv,
                               JointCalendarRule r)
     : rule_(r), calendars_(cv){
+        QL_REQUIRE(!calendars_.empty(), "no calendars given for joint calendar");
+        // edits to any of these put the materialized table out of date
+        for (const auto& c : calendars_)
+            this->dependencies.push_back(Calendar<ExtDate>::implementation(c));
     }
     template <class ExtDate> inline
     std::string JointCalendar<ExtDate>::Impl::name() const {
@@ -121,6 +113,38 @@ namespace QuantLib {
         }
     }
 
+    template <class ExtDate> inline
+    BusinessDayBitmap JointCalendar<ExtDate>::Impl::businessDays(serial_type first,
+                                                                 serial_type last) const {
+        // combine the tables of the given calendars word by word...
+        auto i = this->dependencies.begin();
+        BusinessDayBitmap table = (*i)->businessDays(first, last);
+        for (++i; i != this->dependencies.end(); ++i) {
+            switch (rule_) {
+              case JoinHolidays:
+                table.intersect((*i)->businessDays(first, last));
+                break;
+              case JoinBusinessDays:
+                table.unite((*i)->businessDays(first, last));
+                break;
+              default:
+                QL_FAIL("unknown joint calendar rule");
+            }
+        }
+        // ...then apply the edits to the joint calendar itself
+        for (const auto& d : this->addedHolidays) {
+            serial_type s = to_DateLike(d).serialNumber();
+            if (table.covers(s))
+                table.set(s, false);
+        }
+        for (const auto& d : this->removedHolidays) {
+            serial_type s = to_DateLike(d).serialNumber();
+            if (table.covers(s))
+                table.set(s, true);
+        }
+        return table;
+    }
+
     template <class ExtDate> inline
     JointCalendar<ExtDate>::JointCalendar(const Calendar<ExtDate>& c1,
                                  const Calendar<ExtDate>& c2,
@@ -47,6 +47,15 @@ namespace QuantLib {
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
 
+        When materialized, the business days of the given calendars
+        are precomputed and combined once over the whole range, so
+        that checking a date no longer queries each of them in turn.
+        The precomputed table follows holidays added to or removed
+        from the joint calendar; holidays added to or removed from
+        any of the given calendars put it out of date instead, and
+        the calendar goes back to querying them until it is
+        materialized again.
+
         \ingroup calendars
 
         \test the correctness of the returned results is tested by
@@ -69,6 +78,8 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const ExtDate&) const;
+            BusinessDayBitmap businessDays(serial_type first,
+                                           serial_type last) const override;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar<ExtDate>> calendars_;
@@ -90,4 +101,6 @@ namespace QuantLib {
 
 
 #include "jointcalendar.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::JointCalendar)
 #endif
@@ -37,6 +37,7 @@ namespace QuantLib {
     */
     template <class ExtDate = Date>
     class NullCalendar : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class Impl : public Calendar<ExtDate>::Impl {
           public:
@@ -53,4 +54,6 @@ namespace QuantLib {
 }
 
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::NullCalendar)
 #endif
@@ -57,6 +57,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class Russia : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::OrthodoxImpl {
           public:
@@ -79,4 +80,6 @@ namespace QuantLib {
 }
 
 #include "russia.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Russia)
 #endif
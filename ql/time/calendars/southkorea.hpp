@@ -75,6 +75,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class SouthKorea : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::Impl {
           public:
@@ -97,4 +98,6 @@ namespace QuantLib {
 }
 
 #include "southkorea.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::SouthKorea)
 #endif
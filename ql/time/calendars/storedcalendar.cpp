@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/calendars/storedcalendar.hpp>
+
+namespace QuantLib {
+
+    template <class ExtDate> inline
+    StoredCalendar<ExtDate>::Impl::Impl(const HolidayStore& store,
+                                        Size index,
+                                        const Calendar<ExtDate>& fallback)
+    : name_(store.name(index)), weekend_(0), stored_(store.businessDays(index)),
+      fallback_(fallback) {
+        for (Integer w = Sunday; w <= Saturday; ++w) {
+            if (store.isWeekend(index, Weekday(w)))
+                weekend_ |= std::uint32_t(1) << w;
+        }
+    }
+    template <class ExtDate> inline
+    std::string StoredCalendar<ExtDate>::Impl::name() const {
+        return name_;
+    }
+    template <class ExtDate> inline
+    bool StoredCalendar<ExtDate>::Impl::isWeekend(Weekday w) const {
+        return (weekend_ >> Integer(w)) & 1U;
+    }
+    template <class ExtDate> inline
+    bool StoredCalendar<ExtDate>::Impl::isBusinessDay(const ExtDate& date) const {
+        serial_type s = to_DateLike(date).serialNumber();
+        if (stored_.covers(s))
+            return stored_.test(s);
+        if (!fallback_.empty())
+            return fallback_.isBusinessDay(date);
+        return !isWeekend(to_DateLike(date).weekday());
+    }
+
+    template <class ExtDate> inline
+    StoredCalendar<ExtDate>::StoredCalendar(const HolidayStore& store,
+                                            const std::string& name,
+                                            const Calendar<ExtDate>& fallback) {
+        Size i = store.find(name);
+        QL_REQUIRE(i < store.size(), "calendar {} not found in {}", name, store.path());
+        auto impl = std::make_shared<StoredCalendar<ExtDate>::Impl>(store, i, fallback);
+        // the mapped table is used as is, and copied on the first edit
+        impl->materialized = impl->stored();
+        this->impl_ = impl;
+    }
+
+}
@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file storedcalendar.hpp
+    \brief Calendar read from a holiday store
+*/
+#pragma once
+#ifndef quantlib_stored_calendar_hpp
+#define quantlib_stored_calendar_hpp
+
+#include <ql/time/calendar.hpp>
+#include <ql/time/holidaystore.hpp>
+
+namespace QuantLib {
+
+    //! Calendar read from a holiday store
+    /*! Within the range of the store, business days are those
+        written in the store; the calendar is materialized on the
+        mapped table, which is neither copied nor parsed.  Outside
+        the range, they are those of the fallback calendar if one is
+        given, and all days but the stored weekend days otherwise.
+
+        A calendar written with overrides, i.e., holidays added to or
+        removed from a predefined calendar, can be stored under the
+        name of the latter and read back with the latter as
+        fallback; the two then compare as equal.
+
+        Holidays can still be added and removed; the first edit
+        copies the table, and the store itself is never modified.
+
+        \ingroup calendars
+    */
+    template <class ExtDate=Date>
+    class StoredCalendar : public Calendar<ExtDate> {
+      private:
+        class Impl : public Calendar<ExtDate>::Impl {
+          public:
+            Impl(const HolidayStore& store, Size index, const Calendar<ExtDate>& fallback);
+            std::string name() const;
+            bool isWeekend(Weekday) const;
+            bool isBusinessDay(const ExtDate&) const;
+            const BusinessDayBitmap& stored() const { return stored_; }
+          private:
+            std::string name_;
+            std::uint32_t weekend_;
+            BusinessDayBitmap stored_;
+            Calendar<ExtDate> fallback_;
+        };
+      public:
+        StoredCalendar(const HolidayStore& store,
+                       const std::string& name,
+                       const Calendar<ExtDate>& fallback = Calendar<ExtDate>());
+    };
+
+}
+
+#include "storedcalendar.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::StoredCalendar)
+#endif
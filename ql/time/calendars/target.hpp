@@ -49,6 +49,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class TARGET : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class Impl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -62,4 +63,6 @@ namespace QuantLib {
 }
 
 #include "target.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::TARGET)
 #endif
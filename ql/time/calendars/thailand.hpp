@@ -66,6 +66,7 @@ namespace QuantLib {
         \ingroup calendars
     */    template <class ExtDate=Date>
     class Thailand : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SetImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -79,4 +80,6 @@ namespace QuantLib {
 }
 
 #include "thailand.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Thailand)
 #endif
@@ -87,6 +87,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class UnitedKingdom : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -115,4 +116,6 @@ namespace QuantLib {
 }
 
 #include "unitedkingdom.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::UnitedKingdom)
 #endif
@@ -130,6 +130,7 @@ namespace QuantLib {
     */
     template <class ExtDate=Date>
     class UnitedStates : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class SettlementImpl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -176,4 +177,6 @@ namespace QuantLib {
 }
 
 #include "unitedstates.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::UnitedStates)
 #endif
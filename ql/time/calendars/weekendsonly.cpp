@@ -28,7 +28,7 @@ namespace QuantLib {
     }
     template <class ExtDate> inline
     bool WeekendsOnly<ExtDate>::Impl::isBusinessDay(const ExtDate& date) const {
-        return !isWeekend(date.weekday());
+        return !this->isWeekend(to_DateLike(date).weekday());
     }
 
 }
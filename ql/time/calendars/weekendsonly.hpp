@@ -37,6 +37,7 @@ namespace QuantLib {
     */
     template <class ExtDate = Date>
     class WeekendsOnly : public Calendar<ExtDate> {
+        friend class StaticCalendar<ExtDate>;
       private:
         class Impl : public Calendar<ExtDate>::WesternImpl {
           public:
@@ -50,4 +51,6 @@ namespace QuantLib {
 }
 #include "weekendsonly.cpp"
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::WeekendsOnly)
 #endif
@@ -0,0 +1,179 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file chrono_date_adaptor.hpp
+    \brief std::chrono calendar types as external dates
+
+    With this file included, std::chrono::sys_days and
+    std::chrono::year_month_day can be used as ExtDate, e.g.,
+    Calendar<std::chrono::sys_days>.
+
+    sys_days counts days from January 1st, 1970, so that its serial
+    number is a constant offset away; year_month_day stores its
+    fields, which are returned as they are.  In both cases the
+    day-of-month, month, year and weekday inspectors use chrono
+    arithmetic instead of the serial-number tables.
+
+    For year_month_day, the null date is the default-constructed
+    value, which is not a valid date.  For sys_days, the default value
+    is January 1st, 1970, a valid date; the null date is
+    sys_days::min() instead, as returned by nullDate<sys_days>(), and
+    must be used wherever ql_time expects a null date.
+*/
+#pragma once
+#ifndef quantlib_chrono_date_adaptor_hpp
+#define quantlib_chrono_date_adaptor_hpp
+
+#include <ql/time/date_like.hpp>
+#include <chrono>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! serial number of January 1st, 1970
+        constexpr serial_type unixEpochSerialNumber = serialNumber(1, January, 1970);
+
+        constexpr Weekday weekday(std::chrono::weekday w) {
+            // chrono: Sunday = 0; QuantLib: Sunday = 1
+            return Weekday(w.c_encoding() + 1);
+        }
+
+    }
+
+}
+
+template <>
+struct DateAdaptor<std::chrono::sys_days> {
+    using T = std::chrono::sys_days;
+    // the default value is the Unix epoch, a valid date
+    static constexpr T null() {
+        return T::min();
+    }
+    static constexpr T Date(std::int_fast32_t i) {
+        return i == 0 ? null() :
+            T(std::chrono::days(i - QuantLib::detail::unixEpochSerialNumber));
+    }
+    static constexpr T Date(QuantLib::Day d, QuantLib::Month m, QuantLib::Year y) {
+        return T(std::chrono::year_month_day(std::chrono::year(y),
+                                             std::chrono::month(unsigned(m)),
+                                             std::chrono::day(unsigned(d))));
+    }
+    static constexpr std::int_fast32_t serialNumber(const T& d) {
+        return d == null() ? 0 :
+            std::int_fast32_t(d.time_since_epoch().count()) +
+            QuantLib::detail::unixEpochSerialNumber;
+    }
+};
+
+template <>
+struct DateAdaptor<std::chrono::year_month_day> {
+    using T = std::chrono::year_month_day;
+    static constexpr T Date(std::int_fast32_t i) {
+        return i == 0 ? T() :
+            T(std::chrono::sys_days(
+                  std::chrono::days(i - QuantLib::detail::unixEpochSerialNumber)));
+    }
+    static constexpr T Date(QuantLib::Day d, QuantLib::Month m, QuantLib::Year y) {
+        return T(std::chrono::year(y),
+                 std::chrono::month(unsigned(m)),
+                 std::chrono::day(unsigned(d)));
+    }
+    static constexpr std::int_fast32_t serialNumber(const T& d) {
+        return d == T() ? 0 :
+            std::chrono::sys_days(d).time_since_epoch().count() +
+            QuantLib::detail::unixEpochSerialNumber;
+    }
+};
+
+namespace QuantLib {
+
+    // sys_days: weekday and fields by chrono arithmetic
+
+    template <>
+    inline Weekday DateLike<std::chrono::sys_days>::weekday() const {
+        return detail::weekday(std::chrono::weekday(asExtDate()));
+    }
+
+    template <>
+    inline Day DateLike<std::chrono::sys_days>::dayOfMonth() const {
+        return Day(unsigned(std::chrono::year_month_day(asExtDate()).day()));
+    }
+
+    template <>
+    inline Month DateLike<std::chrono::sys_days>::month() const {
+        return Month(unsigned(std::chrono::year_month_day(asExtDate()).month()));
+    }
+
+    template <>
+    inline Year DateLike<std::chrono::sys_days>::year() const {
+        return Year(int(std::chrono::year_month_day(asExtDate()).year()));
+    }
+
+    // year_month_day: fields as stored
+
+    template <>
+    inline Weekday DateLike<std::chrono::year_month_day>::weekday() const {
+        return detail::weekday(
+            std::chrono::weekday(std::chrono::sys_days(asExtDate())));
+    }
+
+    template <>
+    inline Day DateLike<std::chrono::year_month_day>::dayOfMonth() const {
+        return Day(unsigned(asExtDate().day()));
+    }
+
+    template <>
+    inline Month DateLike<std::chrono::year_month_day>::month() const {
+        return Month(unsigned(asExtDate().month()));
+    }
+
+    template <>
+    inline Year DateLike<std::chrono::year_month_day>::year() const {
+        return Year(int(asExtDate().year()));
+    }
+
+}
+
+template <>
+struct fmt::formatter<std::chrono::year_month_day> : formatter<std::string> {
+    // parse is inherited from formatter<string_view>.
+    template <typename FormatContext>
+    auto format(const std::chrono::year_month_day& d, FormatContext& ctx) {
+        if (d == std::chrono::year_month_day())
+            return formatter<std::string>::format("null date", ctx);
+        return formatter<std::string>::format(
+            fmt::format("{:04}-{:02}-{:02}", int(d.year()),
+                        unsigned(d.month()), unsigned(d.day())),
+            ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<std::chrono::sys_days>
+    : fmt::formatter<std::chrono::year_month_day> {
+    template <typename FormatContext>
+    auto format(const std::chrono::sys_days& d, FormatContext& ctx) {
+        return fmt::formatter<std::chrono::year_month_day>::format(
+            d == QuantLib::nullDate<std::chrono::sys_days>()
+                ? std::chrono::year_month_day()
+                : std::chrono::year_month_day(d),
+            ctx);
+    }
+};
+
+#endif
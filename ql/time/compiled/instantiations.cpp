@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/* Explicit instantiations for the ql_time_compiled library: with
+   QL_TIME_INSTANTIATE_TEMPLATES defined, the extern template
+   declarations at the end of each header become instantiation
+   definitions for the date types listed in QL_TIME_EXTERN_DATES.
+   See externtemplates.hpp.
+*/
+
+#define QL_TIME_INSTANTIATE_TEMPLATES
+
+#include <ql/time/calendar.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/time/calendars/brazil.hpp>
+#include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/china.hpp>
+#include <ql/time/calendars/germany.hpp>
+#include <ql/time/calendars/hongkong.hpp>
+#include <ql/time/calendars/italy.hpp>
+#include <ql/time/calendars/japan.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/russia.hpp>
+#include <ql/time/calendars/southkorea.hpp>
+#include <ql/time/calendars/storedcalendar.hpp>
+#include <ql/time/calendars/switzerland.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/thailand.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/weekendsonly.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/business252.hpp>
+#include <ql/time/daycounters/one.hpp>
+#include <ql/time/daycounters/simpledaycounter.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/daycounters/thirty365.hpp>
+#include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
+#include <ql/time/staticcalendar.hpp>
+#include <ql/time/staticdaycounter.hpp>
+
+#if !defined(QL_TIME_EXTERN_DATES)
+#   error QL_TIME_EXTERN_DATES must be defined to build ql_time_compiled
+#endif
@@ -46,163 +46,10 @@ using boost::posix_time::time_duration;
 
 
 namespace QuantLib {
-#ifndef QL_HIGH_RESOLUTION_DATE
-    // constructors
-    //DateLike<ExtDate>::Date()
-    //: serialNumber_(typename DateLike<ExtDate>::serial_type(0)) {}
-
-    //DateLike<ExtDate>::Date(typename DateLike<ExtDate>::serial_type serialNumber)
-    //: serialNumber_(serialNumber) {
-    //    checkSerialNumber(serialNumber);
-    //}
 
-    //DateLike<ExtDate>::Date(Day d, Month m, Year y) {
-    //    QL_REQUIRE(y > 1900 && y < 2200,
-    //               "year " << y << " out of bound. It must be in [1901,2199]");
-    //    QL_REQUIRE(Integer(m) > 0 && Integer(m) < 13,
-    //               "month " << Integer(m)
-    //               << " outside January-December range [1,12]");
+    namespace detail {
 
-    //    bool leap = isLeap(y);
-    //    Day len = monthLength(m,leap), offset = monthOffset(m,leap);
-    //    QL_REQUIRE(d <= len && d > 0,
-    //               "day outside month (" << Integer(m) << ") day-range "
-    //               << "[1," << len << "]");
-
-    //    serialNumber_ = d + offset + yearOffset(y);
-    //}
-    template <class ExtDate>
-    inline Month DateLike<ExtDate>::month(serial_type s) const {
-        Day d = dayOfYear(s); // dayOfYear is 1 based
-        Integer m = d / 30 + 1;
-        bool leap = isLeap(year(s));
-        while (d <= monthOffset(Month(m), leap))
-            --m;
-        while (d > monthOffset(Month(m + 1), leap)) // NOLINT(misc-misplaced-widening-cast)
-            ++m;
-        return Month(m);
-    }
-    template <class ExtDate>
-    inline
-    Month DateLike<ExtDate>::month() const {
-        auto s = serialNumber();
-        return month(s);
-    }
-    template <class ExtDate>
-    inline Year DateLike<ExtDate>::year(std::int_fast32_t serialNumber_) const {
-        Year y = (serialNumber_ / 365) + 1900;
-        // yearOffset(y) is December 31st of the preceding year
-        if (serialNumber_ <= yearOffset(y))
-            --y;
-        return y;
-    }
-    template <class ExtDate>
-    inline
-    Year DateLike<ExtDate>::year() const {
-        auto s = serialNumber();
-        return year(s);
-    }
-    template <class ExtDate>
-    inline YearMonth DateLike<ExtDate> :: year_month() const {
-        auto s = serialNumber();
-        return {year(s), month(s)};
-    }
-    template <class ExtDate>
-    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator+=(typename DateLike<ExtDate>::serial_type days) {
-        serial_type serial = serialNumber() + days;
-        checkSerialNumber(serial);
-        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator+=(const Period& p) {
-        auto serial = advance(*this,p.length(),p.units()).serialNumber();
-        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator-=(typename DateLike<ExtDate>::serial_type days) {
-        typename DateLike<ExtDate>::serial_type serial = serialNumber() - days;
-        checkSerialNumber(serial);
-        serialNumber() = serial;
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator-=(const Period& p) {
-        auto serial = advance(*this,-p.length(),p.units()).serialNumber();
-        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator++() {
-        typename DateLike<ExtDate>::serial_type serial = serialNumber() + 1;
-        checkSerialNumber(serial);
-        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate>& DateLike<ExtDate>::operator--() {
-        typename DateLike<ExtDate>::serial_type serial = serialNumber() - 1;
-        checkSerialNumber(serial);
-        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
-        return *this;
-    }
-    template <class ExtDate>    inline
-    DateLike<ExtDate> DateLike<ExtDate>::advance(const DateLike<ExtDate>& date, Integer n, TimeUnit units) {
-        switch (units) {
-          case Days:
-            return date + n;
-          case Weeks:
-            return date + 7*n;
-          case Months: {
-            auto s = date.serialNumber();
-            Day d = date.dayOfMonth(s);
-            Integer m = Integer(date.month(s))+n;
-            Year y = date.year(s);
-            while (m > 12) {
-                m -= 12;
-                y += 1;
-            }
-            while (m < 1) {
-                m += 12;
-                y -= 1;
-            }
-
-            QL_ENSURE(y >= 1900 && y <= 2199,
-                      "year {} out of bounds. It must be in [1901,2199]",y);
-
-            Integer length = monthLength(Month(m), isLeap(y));
-            if (d > length)
-                d = length;
-
-            auto tmp = DateAdaptor<ExtDate>::Date(d, Month(m), y);
-            DateLike<ExtDate> res{tmp};
-            return res;
-          }
-          case Years: {
-              auto s = date.serialNumber();
-              Day d = date.dayOfMonth(s);
-              Month m = date.month(s);
-              Year y = date.year(s)+n;
-
-            QL_ENSURE(y >= 1900 && y <= 2199,
-                      "year {} out of bounds. It must be in [1901,2199]",y);
-
-              if (d == 29 && m == February && !isLeap(y))
-                  d = 28;
-
-            auto tmp = DateAdaptor<ExtDate>::Date(d, m, y);
-            DateLike<ExtDate> res{tmp};
-            return res;
-          }
-          default:
-            QL_FAIL("undefined time units");
-        }
-    }
-    template <class ExtDate>    inline
-    bool DateLike<ExtDate>::isLeap(Year y) {
-        static const bool YearIsLeap[] = {
+        inline constexpr bool YearIsLeap[] = {
             // 1900 is leap in agreement with Excel's bug
             // 1900 is out of valid date range anyway
             // 1900-1909
@@ -268,39 +115,28 @@ namespace QuantLib {
             // 2200
             false
         };
-        QL_REQUIRE(y>=1900 && y<=2200, "year outside valid range");
-        return YearIsLeap[y-1900];
-    }
 
-    template <class ExtDate>    inline
-    Integer DateLike<ExtDate>::monthLength(Month m, bool leapYear) {
-        static const Integer MonthLength[] = {
+        inline constexpr Integer MonthLength[] = {
             31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
         };
-        static const Integer MonthLeapLength[] = {
+        inline constexpr Integer MonthLeapLength[] = {
             31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
         };
-        return (leapYear? MonthLeapLength[m-1] : MonthLength[m-1]);
-    }
-    template <class ExtDate>    inline
-    Integer DateLike<ExtDate>::monthOffset(Month m, bool leapYear) {
-        static const Integer MonthOffset[] = {
+
+        inline constexpr Integer MonthOffset[] = {
               0,  31,  59,  90, 120, 151,   // Jan - Jun
             181, 212, 243, 273, 304, 334,   // Jun - Dec
             365     // used in dayOfMonth to bracket day
         };
-        static const Integer MonthLeapOffset[] = {
+        inline constexpr Integer MonthLeapOffset[] = {
               0,  31,  60,  91, 121, 152,   // Jan - Jun
             182, 213, 244, 274, 305, 335,   // Jun - Dec
             366     // used in dayOfMonth to bracket day
         };
-        return (leapYear? MonthLeapOffset[m-1] : MonthOffset[m-1]);
-    }
-    template <class ExtDate>    inline
-    typename DateLike<ExtDate>::serial_type DateLike<ExtDate>::yearOffset(Year y) {
+
         // the list of all December 31st in the preceding year
         // e.g. for 1901 yearOffset[1] is 366, that is, December 31 1900
-        static const typename DateLike<ExtDate>::serial_type YearOffset[] = {
+        inline constexpr serial_type YearOffset[] = {
             // 1900-1909
                 0,  366,  731, 1096, 1461, 1827, 2192, 2557, 2922, 3288,
             // 1910-1919
@@ -364,7 +200,231 @@ namespace QuantLib {
             // 2200
             109574
         };
-        return YearOffset[y-1900];
+
+        constexpr bool isLeap(Year y) {
+            return YearIsLeap[y-1900];
+        }
+
+        constexpr Integer monthLength(Month m, bool leapYear) {
+            return (leapYear? MonthLeapLength[m-1] : MonthLength[m-1]);
+        }
+
+        constexpr Integer monthOffset(Month m, bool leapYear) {
+            return (leapYear? MonthLeapOffset[m-1] : MonthOffset[m-1]);
+        }
+
+        constexpr serial_type yearOffset(Year y) {
+            return YearOffset[y-1900];
+        }
+
+        constexpr Year year(serial_type s) {
+            Year y = (s / 365) + 1900;
+            // yearOffset(y) is December 31st of the preceding year
+            if (s <= yearOffset(y))
+                --y;
+            return y;
+        }
+
+        constexpr Day dayOfYear(serial_type s) {
+            return s - yearOffset(year(s));
+        }
+
+        constexpr Month month(serial_type s) {
+            Day d = dayOfYear(s); // dayOfYear is 1 based
+            Integer m = d / 30 + 1;
+            bool leap = isLeap(year(s));
+            while (d <= monthOffset(Month(m), leap))
+                --m;
+            while (d > monthOffset(Month(m + 1), leap)) // NOLINT(misc-misplaced-widening-cast)
+                ++m;
+            return Month(m);
+        }
+
+        constexpr Day dayOfMonth(serial_type s) {
+            return dayOfYear(s) - monthOffset(month(s), isLeap(year(s)));
+        }
+
+        constexpr Weekday weekday(serial_type s) {
+            Integer w = s % 7;
+            return Weekday(w == 0 ? 7 : w);
+        }
+
+        constexpr serial_type serialNumber(Day d, Month m, Year y) {
+            return d + monthOffset(m, isLeap(y)) + yearOffset(y);
+        }
+
+        constexpr serial_type advance(serial_type s, Integer n, TimeUnit units) {
+            switch (units) {
+              case Days:
+                return s + n;
+              case Weeks:
+                return s + 7*n;
+              case Months:
+              case Years: {
+                Day d = dayOfMonth(s);
+                Integer m = Integer(month(s));
+                Year y = year(s);
+                if (units == Months) {
+                    m += n;
+                    while (m > 12) {
+                        m -= 12;
+                        y += 1;
+                    }
+                    while (m < 1) {
+                        m += 12;
+                        y -= 1;
+                    }
+                } else {
+                    y += n;
+                }
+                if (y < 1900 || y > 2199)
+                    return 0;
+                Integer length = monthLength(Month(m), isLeap(y));
+                if (d > length)
+                    d = length;
+                return serialNumber(d, Month(m), y);
+              }
+              default:
+                return 0;
+            }
+        }
+
+        constexpr Day nthWeekday(Size nth, Weekday dayOfWeek, Month m, Year y) {
+            Weekday first = weekday(serialNumber(1, m, y));
+            Size skip = nth - (dayOfWeek>=first ? 1 : 0);
+            return Day((1 + dayOfWeek + skip * 7) - first);
+        }
+
+    }
+
+#ifndef QL_HIGH_RESOLUTION_DATE
+    // constructors
+    //DateLike<ExtDate>::Date()
+    //: serialNumber_(typename DateLike<ExtDate>::serial_type(0)) {}
+
+    //DateLike<ExtDate>::Date(typename DateLike<ExtDate>::serial_type serialNumber)
+    //: serialNumber_(serialNumber) {
+    //    checkSerialNumber(serialNumber);
+    //}
+
+    //DateLike<ExtDate>::Date(Day d, Month m, Year y) {
+    //    QL_REQUIRE(y > 1900 && y < 2200,
+    //               "year " << y << " out of bound. It must be in [1901,2199]");
+    //    QL_REQUIRE(Integer(m) > 0 && Integer(m) < 13,
+    //               "month " << Integer(m)
+    //               << " outside January-December range [1,12]");
+
+    //    bool leap = isLeap(y);
+    //    Day len = monthLength(m,leap), offset = monthOffset(m,leap);
+    //    QL_REQUIRE(d <= len && d > 0,
+    //               "day outside month (" << Integer(m) << ") day-range "
+    //               << "[1," << len << "]");
+
+    //    serialNumber_ = d + offset + yearOffset(y);
+    //}
+    template <class ExtDate>
+    inline Month DateLike<ExtDate>::month(serial_type s) const {
+        return detail::month(s);
+    }
+    template <class ExtDate>
+    inline
+    Month DateLike<ExtDate>::month() const {
+        auto s = serialNumber();
+        return month(s);
+    }
+    template <class ExtDate>
+    inline Year DateLike<ExtDate>::year(std::int_fast32_t serialNumber_) const {
+        return detail::year(serialNumber_);
+    }
+    template <class ExtDate>
+    inline
+    Year DateLike<ExtDate>::year() const {
+        auto s = serialNumber();
+        return year(s);
+    }
+    template <class ExtDate>
+    inline YearMonth DateLike<ExtDate> :: year_month() const {
+        auto s = serialNumber();
+        return {year(s), month(s)};
+    }
+    template <class ExtDate>
+    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator+=(typename DateLike<ExtDate>::serial_type days) {
+        serial_type serial = serialNumber() + days;
+        checkSerialNumber(serial);
+        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator+=(const Period& p) {
+        auto serial = advance(*this,p.length(),p.units()).serialNumber();
+        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator-=(typename DateLike<ExtDate>::serial_type days) {
+        typename DateLike<ExtDate>::serial_type serial = serialNumber() - days;
+        checkSerialNumber(serial);
+        serialNumber() = serial;
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator-=(const Period& p) {
+        auto serial = advance(*this,-p.length(),p.units()).serialNumber();
+        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator++() {
+        typename DateLike<ExtDate>::serial_type serial = serialNumber() + 1;
+        checkSerialNumber(serial);
+        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate>& DateLike<ExtDate>::operator--() {
+        typename DateLike<ExtDate>::serial_type serial = serialNumber() - 1;
+        checkSerialNumber(serial);
+        *static_cast<ExtDate*>(this) = DateAdaptor<ExtDate>::Date(serial);
+        return *this;
+    }
+    template <class ExtDate>    inline
+    DateLike<ExtDate> DateLike<ExtDate>::advance(const DateLike<ExtDate>& date, Integer n, TimeUnit units) {
+        switch (units) {
+          case Days:
+            return date + n;
+          case Weeks:
+            return date + 7*n;
+          case Months:
+          case Years: {
+            auto serial = detail::advance(date.serialNumber(), n, units);
+            QL_ENSURE(serial != 0,
+                      "year out of bounds. It must be in [1901,2199]");
+            auto tmp = DateAdaptor<ExtDate>::Date(serial);
+            DateLike<ExtDate> res{tmp};
+            return res;
+          }
+          default:
+            QL_FAIL("undefined time units");
+        }
+    }
+    template <class ExtDate>    inline
+    bool DateLike<ExtDate>::isLeap(Year y) {
+        QL_REQUIRE(y>=1900 && y<=2200, "year outside valid range");
+        return detail::isLeap(y);
+    }
+
+    template <class ExtDate>    inline
+    Integer DateLike<ExtDate>::monthLength(Month m, bool leapYear) {
+        return detail::monthLength(m, leapYear);
+    }
+    template <class ExtDate>    inline
+    Integer DateLike<ExtDate>::monthOffset(Month m, bool leapYear) {
+        return detail::monthOffset(m, leapYear);
+    }
+    template <class ExtDate>    inline
+    typename DateLike<ExtDate>::serial_type DateLike<ExtDate>::yearOffset(Year y) {
+        return detail::yearOffset(y);
     }
 
 #else
@@ -790,7 +850,7 @@ namespace QuantLib {
         std::time_t t;
 
         if (std::time(&t) == std::time_t(-1)) // -1 means time() didn't work
-            return DateLike<ExtDate>();
+            return to_DateLike(nullDate<ExtDate>());
         std::tm lt;
         localtime_s(&lt,&t);
         ExtDate res(DateAdaptor<ExtDate>::Date(Day(lt.tm_mday),
@@ -810,11 +870,7 @@ namespace QuantLib {
                    "zeroth day of week in a given (month, year) is undefined");
         QL_REQUIRE(nth<6,
                    "no more than 5 weekday in a given (month, year)");
-        //Weekday first = static_cast<DateLike<ExtDate>>(DateAdaptor<ExtDate>::Date(1, m, y)).weekday();
-        Weekday first =
-            Date(1, m, y).weekday();
-        Size skip = nth - (dayOfWeek>=first ? 1 : 0);
-        auto tmp = DateAdaptor<ExtDate>::Date((1 + dayOfWeek + skip * 7) - first, m, y);
+        auto tmp = DateAdaptor<ExtDate>::Date(detail::nthWeekday(nth, dayOfWeek, m, y), m, y);
         DateLike<ExtDate> res{tmp};
         return res;
     }
@@ -905,7 +961,7 @@ namespace QuantLib {
         std::ostream& operator<<(std::ostream& out,
                                  const short_date_holder<ExtDate>& holder) {
             const DateLike<ExtDate>& d = holder.d;
-            if (d == DateLike<ExtDate>()) {
+            if (d == nullDate<ExtDate>()) {
                 out << "null date";
             } else {
                 FormatResetter resetter(out);
@@ -923,7 +979,7 @@ namespace QuantLib {
         std::ostream& operator<<(std::ostream& out,
                                  const long_date_holder<ExtDate>& holder) {
             const DateLike<ExtDate>& d = holder.d;
-            if (d == DateLike<ExtDate>()) {
+            if (d == nullDate<ExtDate>()) {
                 out << "null date";
             } else {
                 FormatResetter resetter(out);
@@ -937,7 +993,7 @@ namespace QuantLib {
         std::ostream& operator<<(std::ostream& out,
                                  const iso_date_holder<ExtDate>& holder) {
             const DateLike<ExtDate>& d = holder.d;
-            if (d == DateLike<ExtDate>()) {
+            if (d == nullDate<ExtDate>()) {
                 out << "null date";
             } else {
                 FormatResetter resetter(out);
@@ -955,7 +1011,7 @@ namespace QuantLib {
             QL_FAIL("don't want to use boost");
             //using namespace boost::gregorian;
             //const DateLike<ExtDate>& d = holder.d;
-            //if (d == DateLike<ExtDate>()) {
+            //if (d == nullDate<ExtDate>()) {
             //    out << "null date";
             //} else {
             //    FormatResetter resetter(out);
@@ -45,6 +45,17 @@
 
 #include "date_adaptor.h"
 
+namespace QuantLib {
+    template <class ExtDate> class DateLike;
+}
+
+// declared here, so that they are found for external date types
+// outside the global namespace, such as the std::chrono ones
+template <class ExtDate>
+QuantLib::DateLike<ExtDate>& to_DateLike(ExtDate& e);
+template <class ExtDate>
+const QuantLib::DateLike<ExtDate>& to_DateLike(const ExtDate& e);
+
 namespace QuantLib {
 
 #ifdef QL_HIGH_RESOLUTION_DATE
@@ -71,6 +82,49 @@ namespace QuantLib {
         Microsecond;
 #endif
 
+    namespace detail {
+
+        /*! \name Serial-number arithmetic
+            Constant-expression counterparts of the DateLike
+            calculations, working directly on serial numbers so that
+            they can be evaluated at compile time.  No range checks
+            are performed; advance() returns 0 (the null date) when
+            the resulting year falls outside [1900,2199].
+        */
+        //@{
+        constexpr bool isLeap(Year y);
+        constexpr Integer monthLength(Month m, bool leapYear);
+        constexpr Integer monthOffset(Month m, bool leapYear);
+        constexpr serial_type yearOffset(Year y);
+        constexpr Year year(serial_type s);
+        constexpr Day dayOfYear(serial_type s);
+        constexpr Month month(serial_type s);
+        constexpr Day dayOfMonth(serial_type s);
+        constexpr Weekday weekday(serial_type s);
+        constexpr serial_type serialNumber(Day d, Month m, Year y);
+        constexpr serial_type advance(serial_type s, Integer n, TimeUnit units);
+        //! day of month of the n-th given weekday in the given month and year
+        constexpr Day nthWeekday(Size n, Weekday w, Month m, Year y);
+        //@}
+
+    }
+
+    //! null date of the given date type
+    /*! This is the default-constructed value, unless the DateAdaptor
+        of the type provides a null() method; the latter is needed by
+        date types whose default value is a valid date, such as
+        std::chrono::sys_days.  Null dates have serial number 0.
+
+        \ingroup datetime
+    */
+    template <class ExtDate>
+    constexpr ExtDate nullDate() {
+        if constexpr (requires { DateAdaptor<ExtDate>::null(); })
+            return DateAdaptor<ExtDate>::null();
+        else
+            return ExtDate();
+    }
+
     //! Concrete date class
     /*! This class provides methods to inspect dates as well as methods and
         operators which implement a limited date algebra (increasing and
@@ -480,7 +534,7 @@ template <class ExtDate>
     // ==
     template <class ExtDate>
     inline bool operator==(const DateLike<ExtDate>& d1, const DateLike<ExtDate>& d2) {
-        return !(d1 > d2) && !(d2 < d1);
+        return !(d1 < d2) && !(d2 < d1);
     }
     template <class ExtDate>
     inline bool operator==(const DateLike<ExtDate>& d1, const ExtDate& d2) {
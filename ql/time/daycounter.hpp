@@ -27,9 +27,38 @@
 
 #include <ql/time/date.hpp>
 #include "ql_errors.hpp"
+#include <algorithm>
+#include <span>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // batch kernels convert dates to serial numbers in chunks of this size
+        constexpr std::size_t dayCounterChunkSize = 256;
+
+        /* Converts the K parallel date arrays to serial numbers one
+           chunk at a time and calls f(offset, size, serials) on each
+           chunk, where serials[j][k] is the serial number of
+           dates[j][offset+k].  The arrays must have the same size.
+        */
+        template <class ExtDate, std::size_t K, class F>
+        inline void forEachSerialChunk(const std::span<const ExtDate> (&dates)[K], F f) {
+            const std::size_t size = dates[0].size();
+            serial_type serials[K][dayCounterChunkSize];
+            for (std::size_t i = 0; i < size; i += dayCounterChunkSize) {
+                std::size_t n = std::min(dayCounterChunkSize, size - i);
+                for (std::size_t j = 0; j < K; ++j)
+                    for (std::size_t k = 0; k < n; ++k)
+                        serials[j][k] = DateAdaptor<ExtDate>::serialNumber(dates[j][i + k]);
+                f(i, n, serials);
+            }
+        }
+
+    }
+
+    template <class ExtDate> class StaticDayCounter;
+
     //! day counter class
     /*! This class provides methods for determining the length of a time
         period according to given market convention, both as a number
@@ -41,6 +70,7 @@ namespace QuantLib {
         \ingroup datetime
     */template <class ExtDate=Date>
     class DayCounter {
+        friend class StaticDayCounter<ExtDate>;
       protected:
         //! abstract base class for day counter implementations
         class Impl {
@@ -56,6 +86,32 @@ namespace QuantLib {
                                       const ExtDate& d2,
                                       const ExtDate& refPeriodStart,
                                       const ExtDate& refPeriodEnd) const = 0;
+            //! \name Batch versions
+            /*! The defaults loop over the scalar methods; day
+                counters with a simple formula override them with a
+                kernel working on serial numbers, which skips the
+                per-date virtual calls.  Sizes are checked by the caller;
+                empty reference-period spans stand for null dates.
+            */
+            //@{
+            virtual void dayCounts(std::span<const ExtDate> d1,
+                                   std::span<const ExtDate> d2,
+                                   std::span<serial_type> result) const {
+                for (std::size_t i = 0; i < d1.size(); ++i)
+                    result[i] = dayCount(d1[i], d2[i]);
+            }
+            virtual void yearFractions(std::span<const ExtDate> d1,
+                                       std::span<const ExtDate> d2,
+                                       std::span<const ExtDate> refPeriodStart,
+                                       std::span<const ExtDate> refPeriodEnd,
+                                       std::span<Time> result) const {
+                for (std::size_t i = 0; i < d1.size(); ++i)
+                    result[i] = yearFraction(
+                        d1[i], d2[i],
+                        refPeriodStart.empty() ? nullDate<ExtDate>() : refPeriodStart[i],
+                        refPeriodEnd.empty() ? nullDate<ExtDate>() : refPeriodEnd[i]);
+            }
+            //@}
         };
         std::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -84,8 +140,30 @@ namespace QuantLib {
                                    const ExtDate&) const;
         //! Returns the period between two dates as a fraction of year.
         Time yearFraction(const ExtDate&, const ExtDate&,
-                          const ExtDate& refPeriodStart = ExtDate(),
-                          const ExtDate& refPeriodEnd = ExtDate()) const;
+                          const ExtDate& refPeriodStart = nullDate<ExtDate>(),
+                          const ExtDate& refPeriodEnd = nullDate<ExtDate>()) const;
+        //@}
+        //! \name Batch interface
+        /*! These fill \p result with the same values as the scalar
+            methods above applied element-wise to the parallel date
+            arrays, but avoid a virtual call per element and use
+            specialized kernels where available.
+        */
+        //@{
+        //! Returns the number of days between each pair of dates.
+        void dayCounts(std::span<const ExtDate> d1,
+                       std::span<const ExtDate> d2,
+                       std::span<serial_type> result) const;
+        //! Returns the periods between each pair of dates as fractions of year.
+        /*! The reference periods can be left empty, which is the
+            same as passing null dates to yearFraction(); otherwise
+            they must have the same size as the dates.
+        */
+        void yearFractions(std::span<const ExtDate> d1,
+                           std::span<const ExtDate> d2,
+                           std::span<Time> result,
+                           std::span<const ExtDate> refPeriodStart = {},
+                           std::span<const ExtDate> refPeriodEnd = {}) const;
         //@}
     };
 
@@ -129,6 +207,34 @@ namespace QuantLib {
             QL_REQUIRE(impl_, "no day counter implementation provided");
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
+    template <class ExtDate>
+    inline void DayCounter<ExtDate>::dayCounts(std::span<const ExtDate> d1,
+                                               std::span<const ExtDate> d2,
+                                               std::span<serial_type> result) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        QL_REQUIRE(d1.size() == d2.size() && d1.size() == result.size(),
+                   "mismatched sizes: {} start dates, {} end dates, {} results",
+                   d1.size(), d2.size(), result.size());
+        impl_->dayCounts(d1, d2, result);
+    }
+    template <class ExtDate>
+    inline void DayCounter<ExtDate>::yearFractions(std::span<const ExtDate> d1,
+                                                   std::span<const ExtDate> d2,
+                                                   std::span<Time> result,
+                                                   std::span<const ExtDate> refPeriodStart,
+                                                   std::span<const ExtDate> refPeriodEnd) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        QL_REQUIRE(d1.size() == d2.size() && d1.size() == result.size(),
+                   "mismatched sizes: {} start dates, {} end dates, {} results",
+                   d1.size(), d2.size(), result.size());
+        QL_REQUIRE(refPeriodStart.empty() || refPeriodStart.size() == d1.size(),
+                   "{} reference-period start dates given for {} periods",
+                   refPeriodStart.size(), d1.size());
+        QL_REQUIRE(refPeriodEnd.empty() || refPeriodEnd.size() == d1.size(),
+                   "{} reference-period end dates given for {} periods",
+                   refPeriodEnd.size(), d1.size());
+        impl_->yearFractions(d1, d2, refPeriodStart, refPeriodEnd, result);
+    }
 
     template <class ExtDate> 
     inline bool operator==(const DayCounter<ExtDate>& d1, const DayCounter<ExtDate>& d2) {
@@ -146,4 +252,6 @@ namespace QuantLib {
 
 }
 
+#include "externtemplates.hpp"
+QL_TIME_EXTERN_TEMPLATE(QuantLib::DayCounter)
 #endif
@@ -35,6 +35,7 @@ namespace QuantLib {
         \ingroup daycounters
     */template <class ExtDate=Date>
     class Actual360 : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       private:
         class Impl : public DayCounter<ExtDate>::Impl {
           private:
@@ -58,6 +59,28 @@ namespace QuantLib {
                 return (daysBetween<ExtDate>(to_DateLike(d1),to_DateLike(d2))
                         + (includeLastDay_ ? 1.0 : 0.0))/360.0;
             }
+            void dayCounts(std::span<const ExtDate> d1,
+                           std::span<const ExtDate> d2,
+                           std::span<serial_type> result) const override {
+                serial_type extra = includeLastDay_ ? 1 : 0;
+                detail::forEachSerialChunk<ExtDate, 2>(
+                    {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                        for (std::size_t k = 0; k < n; ++k)
+                            result[i + k] = s[1][k] - s[0][k] + extra;
+                    });
+            }
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate>,
+                               std::span<const ExtDate>,
+                               std::span<Time> result) const override {
+                Time extra = includeLastDay_ ? 1.0 : 0.0;
+                detail::forEachSerialChunk<ExtDate, 2>(
+                    {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                        for (std::size_t k = 0; k < n; ++k)
+                            result[i + k] = (Time(s[1][k] - s[0][k]) + extra) / 360.0;
+                    });
+            }
         };
       public:
         explicit Actual360(const bool includeLastDay = false)
@@ -67,4 +90,6 @@ namespace QuantLib {
 
 }
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Actual360)
 #endif
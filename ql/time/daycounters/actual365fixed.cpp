@@ -41,15 +41,26 @@ namespace QuantLib {
                                                const ExtDate& d2,
                                                const ExtDate& refPeriodStart,
                                                const ExtDate& refPeriodEnd) const {
-        if (to_DateLike(d1) == d2)
+        return yearFraction(to_DateLike(d1).serialNumber(),
+                            to_DateLike(d2).serialNumber(),
+                            to_DateLike(refPeriodStart).serialNumber(),
+                            to_DateLike(refPeriodEnd).serialNumber());
+    }
+    template <class ExtDate> inline
+    Time Actual365Fixed<ExtDate>::CA_Impl::yearFraction(serial_type d1,
+                                                        serial_type d2,
+                                                        serial_type refPeriodStart,
+                                                        serial_type refPeriodEnd) {
+        if (d1 == d2)
             return 0.0;
 
         // We need the period to calculate the frequency
-        QL_REQUIRE(to_DateLike(refPeriodStart) != ExtDate(), "invalid refPeriodStart");
-        QL_REQUIRE(to_DateLike(refPeriodEnd) != ExtDate(), "invalid refPeriodEnd");
+        const serial_type null = DateAdaptor<ExtDate>::serialNumber(nullDate<ExtDate>());
+        QL_REQUIRE(refPeriodStart != null, "invalid refPeriodStart");
+        QL_REQUIRE(refPeriodEnd != null, "invalid refPeriodEnd");
 
-        Time dcs = daysBetween(to_DateLike(d1),to_DateLike(d2));
-        Time dcc = daysBetween(to_DateLike(refPeriodStart),to_DateLike(refPeriodEnd));
+        Time dcs = d2 - d1;
+        Time dcc = refPeriodEnd - refPeriodStart;
         Integer months = Integer(std::lround(12*dcc/365));
         QL_REQUIRE(months != 0,
                    "invalid reference period for Act/365 Canadian; "
@@ -63,29 +74,30 @@ namespace QuantLib {
 
     }
     template <class ExtDate> inline
+    void Actual365Fixed<ExtDate>::CA_Impl::yearFractions(std::span<const ExtDate> d1,
+                                                         std::span<const ExtDate> d2,
+                                                         std::span<const ExtDate> refPeriodStart,
+                                                         std::span<const ExtDate> refPeriodEnd,
+                                                         std::span<Time> result) const {
+        // without reference periods, the scalar version gives the same
+        // zeros for null periods and the same errors for the others
+        if (refPeriodStart.empty() || refPeriodEnd.empty()) {
+            DayCounter<ExtDate>::Impl::yearFractions(d1, d2, refPeriodStart,
+                                                     refPeriodEnd, result);
+            return;
+        }
+        detail::forEachSerialChunk<ExtDate, 4>(
+            {d1, d2, refPeriodStart, refPeriodEnd},
+            [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k)
+                    result[i + k] = yearFraction(s[0][k], s[1][k], s[2][k], s[3][k]);
+            });
+    }
+    template <class ExtDate> inline
     serial_type Actual365Fixed<ExtDate>::NL_Impl::dayCount(const ExtDate& dd1,
                                                         const ExtDate& dd2) const {
-        auto d1 = to_DateLike(dd1);
-        auto d2 = to_DateLike(dd2);
-        static const Integer MonthOffset[] = {
-            0,  31,  59,  90, 120, 151,  // Jan - Jun
-            181, 212, 243, 273, 304, 334   // Jun - Dec
-        };
-
-        serial_type s1 = d1.dayOfMonth()
-                             + MonthOffset[d1.month()-1] + (d1.year() * 365);
-        serial_type s2 = d2.dayOfMonth()
-                             + MonthOffset[d2.month()-1] + (d2.year() * 365);
-
-        if (d1.month() == Feb && d1.dayOfMonth() == 29) {
-            --s1;
-        }
-
-        if (d2.month() == Feb && d2.dayOfMonth() == 29) {
-            --s2;
-        }
-
-        return s2 - s1;
+        return noLeapSerial(to_DateLike(dd2).serialNumber()) -
+            noLeapSerial(to_DateLike(dd1).serialNumber());
     }
     template <class ExtDate> inline
     Time Actual365Fixed<ExtDate>::NL_Impl::yearFraction(const ExtDate& d1,
@@ -94,6 +106,40 @@ namespace QuantLib {
                                                const ExtDate& d4) const {
         return dayCount(d1, d2)/365.0;
     }
+    template <class ExtDate> inline
+    serial_type Actual365Fixed<ExtDate>::NL_Impl::noLeapSerial(serial_type s) {
+        static constexpr Integer MonthOffset[] = {
+            0,  31,  59,  90, 120, 151,  // Jan - Jun
+            181, 212, 243, 273, 304, 334   // Jun - Dec
+        };
+        Year y = detail::year(s);
+        Month m = detail::month(s);
+        Day d = detail::dayOfMonth(s);
+        return d + MonthOffset[m-1] + y*365 - (m == February && d == 29 ? 1 : 0);
+    }
+    template <class ExtDate> inline
+    void Actual365Fixed<ExtDate>::NL_Impl::dayCounts(std::span<const ExtDate> d1,
+                                                     std::span<const ExtDate> d2,
+                                                     std::span<serial_type> result) const {
+        detail::forEachSerialChunk<ExtDate, 2>(
+            {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k)
+                    result[i + k] = noLeapSerial(s[1][k]) - noLeapSerial(s[0][k]);
+            });
+    }
+    template <class ExtDate> inline
+    void Actual365Fixed<ExtDate>::NL_Impl::yearFractions(std::span<const ExtDate> d1,
+                                                         std::span<const ExtDate> d2,
+                                                         std::span<const ExtDate>,
+                                                         std::span<const ExtDate>,
+                                                         std::span<Time> result) const {
+        detail::forEachSerialChunk<ExtDate, 2>(
+            {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k)
+                    result[i + k] =
+                        (noLeapSerial(s[1][k]) - noLeapSerial(s[0][k]))/365.0;
+            });
+    }
 
 }
 
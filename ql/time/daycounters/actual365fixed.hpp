@@ -43,6 +43,7 @@ namespace QuantLib {
         \ingroup daycounters
     */template <class ExtDate=Date>
     class Actual365Fixed : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       public:
         enum Convention { Standard, Canadian, NoLeap };
         explicit Actual365Fixed(Convention c = Actual365Fixed::Standard)
@@ -58,6 +59,17 @@ namespace QuantLib {
                               const ExtDate&) const {
                 return daysBetween(to_DateLike(d1),to_DateLike(d2))/365.0;
             }
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate>,
+                               std::span<const ExtDate>,
+                               std::span<Time> result) const override {
+                detail::forEachSerialChunk<ExtDate, 2>(
+                    {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                        for (std::size_t k = 0; k < n; ++k)
+                            result[i + k] = Time(s[1][k] - s[0][k]) / 365.0;
+                    });
+            }
         };
         class CA_Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -68,6 +80,18 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate& refPeriodStart,
                               const ExtDate& refPeriodEnd) const;
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate> refPeriodStart,
+                               std::span<const ExtDate> refPeriodEnd,
+                               std::span<Time> result) const override;
+          private:
+            // year fraction between serial numbers, shared by the
+            // scalar and batch versions
+            static Time yearFraction(serial_type d1,
+                                     serial_type d2,
+                                     serial_type refPeriodStart,
+                                     serial_type refPeriodEnd);
         };
         class NL_Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -80,10 +104,23 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate& refPeriodStart,
                               const ExtDate& refPeriodEnd) const;
+            void dayCounts(std::span<const ExtDate> d1,
+                           std::span<const ExtDate> d2,
+                           std::span<serial_type> result) const override;
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate> refPeriodStart,
+                               std::span<const ExtDate> refPeriodEnd,
+                               std::span<Time> result) const override;
+          private:
+            // day count from a fixed origin, skipping February 29th
+            static serial_type noLeapSerial(serial_type s);
         };
         static std::shared_ptr<typename DayCounter<ExtDate>::Impl> implementation(Convention);
     };
 
 }
 #include "actual365fixed.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Actual365Fixed)
 #endif
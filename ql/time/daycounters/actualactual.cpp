@@ -148,6 +148,49 @@ namespace QuantLib {
         return yearFractionSum;
     }
 
+    template <class ExtDate> inline
+    void ActualActual<ExtDate>::ISMA_Impl::yearFractions(std::span<const ExtDate> d1,
+                                                         std::span<const ExtDate> d2,
+                                                         std::span<const ExtDate>,
+                                                         std::span<const ExtDate>,
+                                                         std::span<Time> result) const {
+        // the reference periods only depend on the schedule; build them once
+        std::vector<ExtDate> couponDates =
+            getListOfPeriodDatesIncludingQuasiPayments<ExtDate>(schedule_);
+        std::vector<serial_type> coupons(couponDates.size());
+        std::transform(couponDates.begin(), couponDates.end(), coupons.begin(),
+                       [](const ExtDate& d) { return DateAdaptor<ExtDate>::serialNumber(d); });
+
+        detail::forEachSerialChunk<ExtDate, 2>(
+            {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    serial_type s1 = std::min(s[0][k], s[1][k]);
+                    serial_type s2 = std::max(s[0][k], s[1][k]);
+                    Real yearFractionSum = 0.0;
+                    for (Size j = 0; j + 1 < coupons.size(); j++) {
+                        serial_type start = coupons[j], end = coupons[j + 1];
+                        if (s1 >= end || s2 <= start)
+                            continue;
+                        serial_type from = std::max(s1, start), to = std::min(s2, end);
+                        Real referenceDayCount = Real(end - start);
+                        if (referenceDayCount < 16) {
+                            // rare enough to take the scalar path
+                            yearFractionSum += yearFractionWithReferenceDates(
+                                *this, DateAdaptor<ExtDate>::Date(from),
+                                DateAdaptor<ExtDate>::Date(to),
+                                couponDates[j], couponDates[j + 1]);
+                            continue;
+                        }
+                        Integer months = (Integer)std::lround(12 * referenceDayCount / 365.0);
+                        Integer couponsPerYear = (Integer)std::lround(12.0 / Real(months));
+                        yearFractionSum +=
+                            Real(to - from) / (referenceDayCount * couponsPerYear);
+                    }
+                    result[i + k] = s[1][k] < s[0][k] ? -yearFractionSum : yearFractionSum;
+                }
+            });
+    }
+
     template <class ExtDate> inline
     Time ActualActual<ExtDate>::Old_ISMA_Impl::yearFraction(const ExtDate& d1,
                                                    const ExtDate& d2,
@@ -161,8 +204,8 @@ namespace QuantLib {
 
         // when the reference period is not specified, try taking
         // it equal to (d1,d2)
-        ExtDate refPeriodStart = (to_DateLike(d3) != ExtDate() ? d3 : d1);
-        ExtDate refPeriodEnd = (to_DateLike(d4) != ExtDate() ? d4 : d2);
+        ExtDate refPeriodStart = (to_DateLike(d3) != nullDate<ExtDate>() ? d3 : d1);
+        ExtDate refPeriodEnd = (to_DateLike(d4) != nullDate<ExtDate>() ? d4 : d2);
 
         QL_REQUIRE(to_DateLike(refPeriodEnd) > to_DateLike(refPeriodStart) && to_DateLike(refPeriodEnd) > d1,
                    "invalid reference period: date 1: {}, date 2: {}"
@@ -246,6 +289,43 @@ namespace QuantLib {
         }
     }
 
+    template <class ExtDate> inline
+    void ActualActual<ExtDate>::Old_ISMA_Impl::yearFractions(std::span<const ExtDate> d1,
+                                                             std::span<const ExtDate> d2,
+                                                             std::span<const ExtDate> refPeriodStart,
+                                                             std::span<const ExtDate> refPeriodEnd,
+                                                             std::span<Time> result) const {
+        if (refPeriodStart.empty() || refPeriodEnd.empty()) {
+            DayCounter<ExtDate>::Impl::yearFractions(d1, d2, refPeriodStart,
+                                                     refPeriodEnd, result);
+            return;
+        }
+        // the kernel handles regular coupons, i.e., refPeriodStart <=
+        // d1 < d2 <= refPeriodEnd; stubs and irregular periods take
+        // the scalar path, as do null reference dates.
+        const serial_type null = DateAdaptor<ExtDate>::serialNumber(nullDate<ExtDate>());
+        detail::forEachSerialChunk<ExtDate, 4>(
+            {d1, d2, refPeriodStart, refPeriodEnd},
+            [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    serial_type s1 = s[0][k], s2 = s[1][k];
+                    serial_type start = s[2][k], end = s[3][k];
+                    Integer months = (Integer)std::lround(12*Real(end-start)/365);
+                    if (s1 == s2) {
+                        result[i + k] = 0.0;
+                    } else if (start != null && end != null && s1 < s2 &&
+                               start <= s1 && s2 <= end && months != 0) {
+                        Time period = Real(months)/12.0;
+                        result[i + k] = period*Real(s2-s1) / Real(end-start);
+                    } else {
+                        result[i + k] = yearFraction(d1[i + k], d2[i + k],
+                                                     refPeriodStart[i + k],
+                                                     refPeriodEnd[i + k]);
+                    }
+                }
+            });
+    }
+
     template <class ExtDate> inline
     Time ActualActual<ExtDate>::ISDA_Impl::yearFraction(const ExtDate& dd1,
                                                const ExtDate& dd2,
@@ -257,7 +337,7 @@ namespace QuantLib {
             return 0.0;
 
         if (d1 > d2)
-            return -yearFraction(d2,d1,ExtDate(),ExtDate());
+            return -yearFraction(d2,d1,nullDate<ExtDate>(),nullDate<ExtDate>());
 
         Integer y1 = d1.year(), y2 = d2.year();
         Real dib1 = (DateLike<ExtDate>::isLeap(y1) ? 366.0 : 365.0),
@@ -270,6 +350,29 @@ namespace QuantLib {
         return sum;
     }
 
+    template <class ExtDate> inline
+    void ActualActual<ExtDate>::ISDA_Impl::yearFractions(std::span<const ExtDate> d1,
+                                                         std::span<const ExtDate> d2,
+                                                         std::span<const ExtDate>,
+                                                         std::span<const ExtDate>,
+                                                         std::span<Time> result) const {
+        detail::forEachSerialChunk<ExtDate, 2>(
+            {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    serial_type s1 = std::min(s[0][k], s[1][k]);
+                    serial_type s2 = std::max(s[0][k], s[1][k]);
+                    Year y1 = detail::year(s1), y2 = detail::year(s2);
+                    Real dib1 = (detail::isLeap(y1) ? 366.0 : 365.0),
+                         dib2 = (detail::isLeap(y2) ? 366.0 : 365.0);
+
+                    Time sum = y2 - y1 - 1;
+                    sum += Real(detail::serialNumber(1, January, y1+1) - s1)/dib1;
+                    sum += Real(s2 - detail::serialNumber(1, January, y2))/dib2;
+                    result[i + k] = s1 == s2 ? 0.0 : (s[1][k] < s[0][k] ? -sum : sum);
+                }
+            });
+    }
+
     template <class ExtDate> inline
     Time ActualActual<ExtDate>::AFB_Impl::yearFraction(const ExtDate& dd1,
                                               const ExtDate& dd2,
@@ -281,7 +384,7 @@ namespace QuantLib {
             return 0.0;
 
         if (d1 > d2)
-            return -yearFraction(d2,d1,ExtDate(),ExtDate());
+            return -yearFraction(d2,d1,nullDate<ExtDate>(),nullDate<ExtDate>());
 
         auto newD2=d2, temp=d2;
         Time sum = 0.0;
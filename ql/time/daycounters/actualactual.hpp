@@ -48,6 +48,7 @@ namespace QuantLib {
               good values.
     */template <class ExtDate=Date>
     class ActualActual : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       public:
         enum Convention { ISMA, Bond,
                           ISDA, Historical, Actual365,
@@ -65,6 +66,11 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate& refPeriodStart,
                               const ExtDate& refPeriodEnd) const;
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate> refPeriodStart,
+                               std::span<const ExtDate> refPeriodEnd,
+                               std::span<Time> result) const override;
           private:
             Schedule<ExtDate> schedule_;
         };
@@ -77,6 +83,11 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate& refPeriodStart,
                               const ExtDate& refPeriodEnd) const;
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate> refPeriodStart,
+                               std::span<const ExtDate> refPeriodEnd,
+                               std::span<Time> result) const override;
         };
         class ISDA_Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -87,6 +98,11 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate&,
                               const ExtDate&) const;
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate> refPeriodStart,
+                               std::span<const ExtDate> refPeriodEnd,
+                               std::span<Time> result) const override;
         };
         class AFB_Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -109,4 +125,6 @@ namespace QuantLib {
 
 }
 #include "actualactual.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::ActualActual)
 #endif
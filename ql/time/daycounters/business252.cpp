@@ -20,54 +20,97 @@
 
 #include <ql/time/daycounters/business252.hpp>
 #include <map>
+#include <mutex>
+#include <sstream>
+#include <tuple>
 
 namespace QuantLib {
 
-    namespace {
+    namespace detail {
 
-        typedef std::map<Year, std::map<Month, serial_type> > Cache;
-        typedef std::map<Year, serial_type> OuterCache;
-        
-        std::map<std::string, Cache> monthlyFigures_;
-        std::map<std::string, OuterCache> yearlyFigures_;
         template <class ExtDate> inline
-        bool sameYear(const ExtDate& d1, const ExtDate& d2) {
-            return d1.year() == d2.year();
+        Business252Figures<ExtDate>::Business252Figures(const Calendar<ExtDate>& calendar,
+                                                        Year firstYear,
+                                                        Year lastYear)
+        : firstYear_(firstYear), lastYear_(lastYear) {
+            QL_REQUIRE(firstYear <= lastYear,
+                       "first year ({}) must not be later than last year ({})",
+                       firstYear, lastYear);
+            cumulated_.reserve(Size(lastYear - firstYear + 1) * 12 + 1);
+            cumulated_.push_back(0);
+            ExtDate d1 = DateAdaptor<ExtDate>::Date(1, January, firstYear);
+            for (Year y = firstYear; y <= lastYear; ++y) {
+                for (Integer m = 1; m <= 12; ++m) {
+                    ExtDate d2 = to_DateLike(d1) + 1*Months;
+                    cumulated_.push_back(cumulated_.back() +
+                                         calendar.businessDaysBetween(d1, d2));
+                    d1 = d2;
+                }
+            }
         }
+
         template <class ExtDate> inline
-        bool sameMonth(const ExtDate& d1, const ExtDate& d2) {
-            return to_DateLike(d1).year() == to_DateLike(d2).year() && to_DateLike(d1).month() == to_DateLike(d2).month();
+        Size Business252Figures<ExtDate>::index(Month m, Year y) const {
+            return Size(y - firstYear_) * 12 + Size(m) - 1;
         }
+
         template <class ExtDate> inline
-        serial_type businessDays(Cache& cache,
-                                       const Calendar<ExtDate>& calendar,
-                                       Month month, Year year) {
-            if (cache[year][month] == 0) {
-                // calculate and store.
-                ExtDate d1 = DateAdaptor<ExtDate>::Date(1,month,year);
-                ExtDate d2 = to_DateLike(d1) + 1*Months;
-                cache[year][month] = calendar.businessDaysBetween(d1, d2);
-            }
-            return cache[year][month];
+        bool Business252Figures<ExtDate>::covers(Month m, Year y) const {
+            return y >= firstYear_ && index(m, y) < cumulated_.size();
+        }
+
+        template <class ExtDate> inline
+        serial_type Business252Figures<ExtDate>::businessDaysBetween(Month m1, Year y1,
+                                                                     Month m2, Year y2) const {
+            return cumulated_[index(m2, y2)] - cumulated_[index(m1, y1)];
         }
+
         template <class ExtDate> inline
-        serial_type businessDays(OuterCache& outerCache,
-                                       Cache& cache,
-                                       const Calendar<ExtDate>& calendar,
-                                       Year year) {
-            if (outerCache[year] == 0) {
-                // calculate and store.
-                serial_type total = 0;
-                for (Integer i=1; i<=12; ++i) {
-                    total += businessDays(cache,calendar,
-                                          Month(i), year);
-                }
-                outerCache[year] = total;
+        std::shared_ptr<const Business252Figures<ExtDate> >
+        business252Figures(const Calendar<ExtDate>& calendar,
+                           Year firstYear,
+                           Year lastYear) {
+            // calendars are identified by implementation rather than
+            // by name, and by the holiday edits they went through
+            typedef std::tuple<const void*, unsigned long, Year, Year> Key;
+            struct Entry {
+                // tells whether the address in the key was reused
+                std::weak_ptr<const void> calendar;
+                std::shared_ptr<const Business252Figures<ExtDate> > figures;
+            };
+            static std::map<Key, Entry> figures;
+            static std::mutex mutex;
+
+            std::weak_ptr<const void> id = calendar.id();
+            const void* impl = id.lock().get();
+            unsigned long edits = calendar.holidayEdits();
+            Key key(impl, edits, firstYear, lastYear);
+
+            // only construction goes through here; once returned,
+            // the figures are read without any locking.
+            std::lock_guard<std::mutex> lock(mutex);
+            auto i = figures.find(key);
+            if (i != figures.end() && !i->second.calendar.expired())
+                return i->second.figures;
+
+            // drop the figures of calendars which are gone or were
+            // modified since
+            for (auto j = figures.begin(); j != figures.end(); ) {
+                if (j->second.calendar.expired() ||
+                    (std::get<0>(j->first) == impl && std::get<1>(j->first) != edits))
+                    j = figures.erase(j);
+                else
+                    ++j;
             }
-            return outerCache[year];
+
+            auto f = std::make_shared<const Business252Figures<ExtDate> >(calendar, firstYear,
+                                                                         lastYear);
+            figures[key] = Entry{id, f};
+            return f;
         }
 
     }
+
     template <class ExtDate> inline
     std::string Business252<ExtDate>::Impl::name() const {
         std::ostringstream out;
@@ -77,62 +120,32 @@ namespace QuantLib {
     template <class ExtDate> inline
     serial_type Business252<ExtDate>::Impl::dayCount(const ExtDate& dd1,
                                                   const ExtDate& dd2) const {
-        auto d1 = to_DateLike(dd1);
-        auto d2 = to_DateLike(dd2);
-        if (sameMonth(d1.asExtDate(), d2.asExtDate()) || d1 >= d2) {
-            // we treat the case of d1 > d2 here, since we'd need a
-            // second cache to get it right (our cached figures are
-            // for first included, last excluded and might have to be
-            // changed going the other way.)
+        const DateLike<ExtDate>& d1 = to_DateLike(dd1);
+        const DateLike<ExtDate>& d2 = to_DateLike(dd2);
+        if (calendar_.holidayEdits() != edits_) {
+            // the figures no longer match the calendar
+            return calendar_.businessDaysBetween(d1, d2);
+        }
+        YearMonth ym1 = d1.year_month(), ym2 = d2.year_month();
+        if ((ym1.year == ym2.year && ym1.month == ym2.month) || d1 >= d2) {
+            // we treat the case of d1 > d2 here, since the figures
+            // are for first included, last excluded and might have
+            // to be changed going the other way.
             return calendar_.businessDaysBetween(d1, d2);
-        } else if (sameYear(d1,d2)) {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            serial_type total = 0;
-            // first, we get to the beginning of next month.
-            auto dd1 = d1.year_month();
-            auto d = to_DateLike(DateAdaptor<ExtDate>::Date(1,dd1.month,dd1.year)) + 1*Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // then, we add any whole months (whose figures might be
-            // cached already) in the middle of our period.
-            while (!sameMonth(d.asExtDate(), d2.asExtDate())) {
-                total += businessDays(cache, calendar_,
-                                      d.month(), d.year());
-                d += 1*Months;
-            }
-            // finally, we get to the end of the period.
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
-        } else {
-            Cache& cache = monthlyFigures_[calendar_.name()];
-            OuterCache& outerCache = yearlyFigures_[calendar_.name()];
-            serial_type total = 0;
-            // first, we get to the beginning of next year.
-            // The first bit gets us to the end of this month...
-            auto d = to_DateLike(DateAdaptor<ExtDate>::Date(1, d1.month(), d1.year())) + 1 * Months;
-            total += calendar_.businessDaysBetween(d1, d);
-            // ...then we add any remaining months, possibly cached
-            for (Integer m = Integer(d1.month())+1; m <= 12; ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d.year());
-            }
-            // then, we add any whole year in the middle of our period.
-            d = to_DateLike(DateAdaptor<ExtDate>::Date(1, January, d1.year() + 1));
-            while (!sameYear(d,d2)) {
-                total += businessDays(outerCache, cache,
-                                      calendar_, d.year());
-                d += 1*Years;
-            }
-            // finally, we get to the end of the period.
-            // First, we add whole months...
-            for (Integer m = 1; m<Integer(d2.month()); ++m) {
-                total += businessDays(cache, calendar_,
-                                      Month(m), d2.year());
-            }
-            // ...then the last bit.
-            d = to_DateLike(DateAdaptor<ExtDate>::Date(1, d2.month(), d2.year()));
-            total += calendar_.businessDaysBetween(d, d2);
-            return total;
         }
+
+        // the start of the month following d1...
+        Month m = (ym1.month == December) ? January : Month(ym1.month + 1);
+        Year y = (ym1.month == December) ? ym1.year + 1 : ym1.year;
+        if (!figures_->covers(m, y) || !figures_->covers(ym2.month, ym2.year))
+            return calendar_.businessDaysBetween(d1, d2);
+
+        // ...and the start of the month of d2
+        ExtDate start1 = DateAdaptor<ExtDate>::Date(1, m, y);
+        ExtDate start2 = DateAdaptor<ExtDate>::Date(1, ym2.month, ym2.year);
+        return calendar_.businessDaysBetween(d1, start1)
+            + figures_->businessDaysBetween(m, y, ym2.month, ym2.year)
+            + calendar_.businessDaysBetween(start2, d2);
     }
     template <class ExtDate> inline
     Time Business252<ExtDate>::Impl::yearFraction(const ExtDate& d1,
@@ -28,18 +28,73 @@
 #include <ql/time/calendar.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/daycounter.hpp>
+#include <memory>
 #include <utility>
-#pragma once
+#include <vector>
+
 namespace QuantLib {
 
+    namespace detail {
+
+        //! business days per month of a calendar over a range of years
+        /*! The figures are computed once at construction and never
+            modified afterwards, so that a single instance can be
+            shared by any number of day counters and threads.
+        */
+        template <class ExtDate>
+        class Business252Figures {
+          public:
+            Business252Figures(const Calendar<ExtDate>& calendar,
+                               Year firstYear,
+                               Year lastYear);
+            //! whether the start of the given month is in the table
+            bool covers(Month m, Year y) const;
+            //! business days from the start of the first month (included)
+            //! to the start of the second one (excluded)
+            serial_type businessDaysBetween(Month m1, Year y1,
+                                            Month m2, Year y2) const;
+          private:
+            Size index(Month m, Year y) const;
+            Year firstYear_, lastYear_;
+            // business days before the start of each month
+            std::vector<serial_type> cumulated_;
+        };
+
+        //! returns the figures for the given calendar and years
+        /*! Figures are shared among all the day counters using the
+            same calendar implementation (see Calendar::id()) with the
+            same holidays and years.
+        */
+        template <class ExtDate>
+        std::shared_ptr<const Business252Figures<ExtDate> >
+        business252Figures(const Calendar<ExtDate>& calendar,
+                           Year firstYear,
+                           Year lastYear);
+
+    }
+
     //! Business/252 day count convention
-    /*! \ingroup daycounters */
+    /*! Business days in whole months between the given years are
+        precomputed at construction; other periods are counted on the
+        calendar directly.
+
+        \note once holidays are added to or removed from the
+              calendar, the precomputed months are no longer used
+              and all periods are counted on the calendar; the day
+              counter must be built again to precompute them anew.
+
+        \ingroup daycounters
+    */
     template <class ExtDate = Date>
     class Business252 : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       private:
         class Impl : public DayCounter<ExtDate>::Impl {
           private:
             Calendar<ExtDate> calendar_;
+            // holiday edits of the calendar when the figures were taken
+            unsigned long edits_;
+            std::shared_ptr<const detail::Business252Figures<ExtDate> > figures_;
           public:
             std::string name() const;
             serial_type dayCount(const ExtDate& d1,
@@ -48,14 +103,21 @@ namespace QuantLib {
                               const ExtDate& d2,
                               const ExtDate&,
                               const ExtDate&) const;
-            explicit Impl(const Calendar<ExtDate>& c) : calendar_(c) {}
+            Impl(const Calendar<ExtDate>& c, Year firstYear, Year lastYear)
+            : calendar_(c), edits_(c.holidayEdits()),
+              figures_(detail::business252Figures(c, firstYear, lastYear)) {}
         };
       public:
-        Business252(const Calendar<ExtDate>& c = Brazil<ExtDate>())
-        : DayCounter<ExtDate>(
-              std::shared_ptr<typename DayCounter<ExtDate>::Impl>(new Business252::Impl(c))) {}
+        Business252(const Calendar<ExtDate>& c = Brazil<ExtDate>(),
+                    Year firstYear = 1990,
+                    Year lastYear = 2100)
+        : DayCounter<ExtDate>(std::shared_ptr<typename DayCounter<ExtDate>::Impl>(
+              new Business252::Impl(c, firstYear, lastYear))) {}
     };
 
 }
 #include "business252.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::detail::Business252Figures)
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Business252)
 #endif
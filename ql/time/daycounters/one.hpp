@@ -32,6 +32,7 @@ namespace QuantLib {
     /*! \ingroup daycounters */
     template <class ExtDate = Date>
     class OneDayCounter : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       private:
         class Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -55,4 +56,6 @@ namespace QuantLib {
 
 }
 
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::OneDayCounter)
 #endif
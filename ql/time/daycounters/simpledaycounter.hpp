@@ -45,6 +45,7 @@ namespace QuantLib {
     */
     template <class ExtDate = Date>
     class SimpleDayCounter : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       private:
         class Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -65,4 +66,6 @@ namespace QuantLib {
 
 }
 #include "simpledaycounter.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::SimpleDayCounter)
 #endif
@@ -20,6 +20,7 @@
 
 #include <ql/time/daycounters/thirty360.hpp>
 #include <algorithm>
+#include <type_traits>
 
 namespace QuantLib {
     template <class ExtDate> inline std::shared_ptr<typename DayCounter<ExtDate>::Impl>
@@ -40,63 +41,55 @@ namespace QuantLib {
             QL_FAIL("unknown 30/360 convention");
         }
     }
-    template <class ExtDate> inline
-    serial_type Thirty360<ExtDate>::US_Impl::dayCount(const ExtDate& ed1,
-                                                   const ExtDate& ed2) const {
-        auto d1 = to_DateLike(ed1);
-        auto d2 = to_DateLike(ed2);
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Integer mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
-
-        if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
-
+    template <class ExtDate>
+    template <class Derived>
+    inline Integer Thirty360<ExtDate>::BatchImpl<Derived>::count(serial_type s1,
+                                                                 serial_type s2) const {
+        Integer yy1 = detail::year(s1), mm1 = detail::month(s1), dd1 = detail::dayOfMonth(s1);
+        Integer yy2 = detail::year(s2), mm2 = detail::month(s2), dd2 = detail::dayOfMonth(s2);
+        static_cast<const Derived&>(*this).adjust(yy1, mm1, dd1, yy2, mm2, dd2);
         return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
             std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
     }
-    template <class ExtDate> inline
-    serial_type Thirty360<ExtDate>::EU_Impl::dayCount(const ExtDate& ed1,
-                                                   const ExtDate& ed2) const {
-        auto d1 = to_DateLike(ed1);
-        auto d2 = to_DateLike(ed2);
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    template <class ExtDate>
+    template <class Derived>
+    template <class T>
+    inline void Thirty360<ExtDate>::BatchImpl<Derived>::kernel(std::span<const ExtDate> d1,
+                                                               std::span<const ExtDate> d2,
+                                                               std::span<T> result) const {
+        detail::forEachSerialChunk<ExtDate, 2>(
+            {d1, d2}, [&](std::size_t i, std::size_t n, const auto& s) {
+                for (std::size_t k = 0; k < n; ++k) {
+                    Integer c = count(s[0][k], s[1][k]);
+                    if constexpr (std::is_same_v<T, Time>)
+                        result[i + k] = c/360.0;
+                    else
+                        result[i + k] = c;
+                }
+            });
     }
     template <class ExtDate> inline
-    serial_type Thirty360<ExtDate>::IT_Impl::dayCount(const ExtDate& ed1,
-                                                   const ExtDate& ed2) const {
-        auto d1 = to_DateLike(ed1);
-        auto d2 = to_DateLike(ed2);
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
-
+    void Thirty360<ExtDate>::US_Impl::adjust(Integer&, Integer&, Integer& dd1,
+                                             Integer&, Integer& mm2, Integer& dd2) const {
+        if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
+    }
+    template <class ExtDate> inline
+    void Thirty360<ExtDate>::EU_Impl::adjust(Integer&, Integer&, Integer&,
+                                             Integer&, Integer&, Integer&) const {}
+    template <class ExtDate> inline
+    void Thirty360<ExtDate>::IT_Impl::adjust(Integer&, Integer& mm1, Integer& dd1,
+                                             Integer&, Integer& mm2, Integer& dd2) const {
         if (mm1 == 2 && dd1 > 27) dd1 = 30;
         if (mm2 == 2 && dd2 > 27) dd2 = 30;
-
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
     }
     template <class ExtDate> inline
-    serial_type Thirty360<ExtDate>::GER_Impl::dayCount(const ExtDate& ed1,
-                                                    const ExtDate& ed2) const {
-        auto d1 = to_DateLike(ed1);
-        auto d2 = to_DateLike(ed2);
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
-
-        if (mm1 == 2 && dd1 == 28 + (DateLike<ExtDate>::isLeap(yy1) ? 1 : 0))
+    void Thirty360<ExtDate>::GER_Impl::adjust(Integer& yy1, Integer& mm1, Integer& dd1,
+                                              Integer& yy2, Integer& mm2, Integer& dd2) const {
+        if (mm1 == 2 && dd1 == 28 + (detail::isLeap(yy1) ? 1 : 0))
             dd1 = 30;
-        if (!isLastPeriod_ && mm2 == 2 && dd2 == 28 + (DateLike<ExtDate>::isLeap(yy2) ? 1 : 0))
+        if (!isLastPeriod_ && mm2 == 2 && dd2 == 28 + (detail::isLeap(yy2) ? 1 : 0))
             dd2 = 30;
-
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
     }
 
 }
@@ -58,52 +58,70 @@ namespace QuantLib {
         \ingroup daycounters
     */template <class ExtDate=Date>
     class Thirty360 : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       public:
         enum Convention { USA, BondBasis,
                           European, EurobondBasis,
                           Italian,
                           German };
       private:
-        class US_Impl : public DayCounter<ExtDate>::Impl {
+        /* common scalar and batch calculations; Derived provides an
+           adjust() method applying its end-of-month rules to the date
+           fields */
+        template <class Derived>
+        class BatchImpl : public DayCounter<ExtDate>::Impl {
           public:
-            std::string name() const override { return std::string("30/360 (Bond Basis)"); }
-            serial_type dayCount(const ExtDate& d1, const ExtDate& d2) const override;
+            serial_type dayCount(const ExtDate& d1, const ExtDate& d2) const override {
+                return count(to_DateLike(d1).serialNumber(),
+                             to_DateLike(d2).serialNumber());
+            }
             Time yearFraction(const ExtDate& d1,
                               const ExtDate& d2,
                               const ExtDate&, const ExtDate&) const override {
                 return dayCount(d1,d2)/360.0; }
+            void dayCounts(std::span<const ExtDate> d1,
+                           std::span<const ExtDate> d2,
+                           std::span<serial_type> result) const override {
+                kernel(d1, d2, result);
+            }
+            void yearFractions(std::span<const ExtDate> d1,
+                               std::span<const ExtDate> d2,
+                               std::span<const ExtDate>,
+                               std::span<const ExtDate>,
+                               std::span<Time> result) const override {
+                kernel(d1, d2, result);
+            }
+          private:
+            Integer count(serial_type s1, serial_type s2) const;
+            template <class T>
+            void kernel(std::span<const ExtDate> d1,
+                        std::span<const ExtDate> d2,
+                        std::span<T> result) const;
+        };
+        class US_Impl : public BatchImpl<US_Impl> {
+          public:
+            std::string name() const override { return std::string("30/360 (Bond Basis)"); }
+            void adjust(Integer& yy1, Integer& mm1, Integer& dd1,
+                        Integer& yy2, Integer& mm2, Integer& dd2) const;
         };
-        class EU_Impl : public DayCounter<ExtDate>::Impl {
+        class EU_Impl : public BatchImpl<EU_Impl> {
           public:
             std::string name() const { return std::string("30E/360 (Eurobond Basis)");}
-            serial_type dayCount(const ExtDate& d1,
-                                       const ExtDate& d2) const;
-            Time yearFraction(const ExtDate& d1,
-                              const ExtDate& d2,
-                              const ExtDate&,
-                              const ExtDate&) const {
-                return dayCount(d1,d2)/360.0; }
+            void adjust(Integer& yy1, Integer& mm1, Integer& dd1,
+                        Integer& yy2, Integer& mm2, Integer& dd2) const;
         };
-        class IT_Impl : public DayCounter<ExtDate>::Impl {
+        class IT_Impl : public BatchImpl<IT_Impl> {
           public:
             std::string name() const { return std::string("30/360 (Italian)");}
-            serial_type dayCount(const ExtDate& d1, const ExtDate& d2) const;
-            Time yearFraction(const ExtDate& d1,
-                              const ExtDate& d2,
-                              const ExtDate&,
-                              const ExtDate&) const {
-                return dayCount(d1,d2)/360.0; }
+            void adjust(Integer& yy1, Integer& mm1, Integer& dd1,
+                        Integer& yy2, Integer& mm2, Integer& dd2) const;
         };
-        class GER_Impl : public DayCounter<ExtDate>::Impl {
+        class GER_Impl : public BatchImpl<GER_Impl> {
           public:
             explicit GER_Impl(bool isLastPeriod) : isLastPeriod_(isLastPeriod) {}
             std::string name() const { return std::string("30/360 (German)");}
-            serial_type dayCount(const ExtDate& d1, const ExtDate& d2) const;
-            Time yearFraction(const ExtDate& d1,
-                              const ExtDate& d2,
-                              const ExtDate&,
-                              const ExtDate&) const {
-                return dayCount(d1,d2)/360.0; }
+            void adjust(Integer& yy1, Integer& mm1, Integer& dd1,
+                        Integer& yy2, Integer& mm2, Integer& dd2) const;
         private:
             bool isLastPeriod_;
         };
@@ -117,4 +135,6 @@ namespace QuantLib {
 
 }
 #include "thirty360.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Thirty360)
 #endif
@@ -32,6 +32,7 @@ namespace QuantLib {
     /*! \ingroup daycounters */
     template <class ExtDate = Date>
     class Thirty365 : public DayCounter<ExtDate> {
+        friend class StaticDayCounter<ExtDate>;
       private:
         class Impl : public DayCounter<ExtDate>::Impl {
           public:
@@ -50,4 +51,6 @@ namespace QuantLib {
 
 }
 #include "thirty365.cpp"
+#include <ql/time/externtemplates.hpp>
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Thirty365)
 #endif
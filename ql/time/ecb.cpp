@@ -30,60 +30,120 @@
 #pragma GCC diagnostic pop
 #endif
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
 
 //using boost::algorithm::to_upper_copy;
 //using std::string;
 
 namespace QuantLib {
 
-    template <class ExtDate>
-    struct knownDateSet {
-        static setExtDate<ExtDate>& get() {
-            static setExtDate<ExtDate> res;
-            return res;
-        }
-    };
-    template <class ExtDate> inline 
-    const setExtDate<ExtDate>& ECB<ExtDate>::knownDates() {
-
-        // one-off inizialization
-        static const serial_type knownDatesArray[] = {
-              38371, 38391, 38420, 38455, 38483, 38511, 38546, 38574, 38602, 38637, 38665, 38692 // 2005
-            , 38735, 38756, 38784, 38819, 38847, 38883, 38910, 38938, 38966, 39001, 39029, 39064 // 2006
-            , 39099, 39127, 39155, 39190, 39217, 39246, 39274, 39302, 39337, 39365, 39400, 39428 // 2007
-            , 39463, 39491, 39519, 39554, 39582, 39610, 39638, 39673, 39701, 39729, 39764, 39792 // 2008
-            , 39834, 39855, 39883, 39911, 39946, 39974, 40002, 40037, 40065, 40100, 40128, 40155 // 2009
-            , 40198, 40219, 40247, 40282, 40310, 40345, 40373, 40401, 40429, 40464, 40492, 40520 // 2010
-            , 40562, 40583, 40611, 40646, 40674, 40709, 40737, 40765, 40800, 40828, 40856, 40891 // 2011
-            // http://www.ecb.europa.eu/press/pr/date/2011/html/pr110520.en.html
-            , 40926, 40954, 40982, 41010, 41038, 41073, 41101, 41129, 41164, 41192, 41227, 41255 // 2012
-            , 41290, 41318, 41346, 41374, 41402, 41437, 41465, 41493, 41528, 41556, 41591, 41619 // 2013
-            // http://www.ecb.europa.eu/press/pr/date/2013/html/pr130610.en.html
-            , 41654, 41682, 41710, 41738, 41773, 41801, 41829, 41864, 41892, 41920, 41955, 41983 // 2014
-            // http://www.ecb.europa.eu/press/pr/date/2014/html/pr140717_1.en.html
-            , 42032, 42074, 42116, 42165, 42207, 42256, 42305, 42347// 2015
-            // https://www.ecb.europa.eu/press/pr/date/2015/html/pr150622.en.html
-            , 42396, 42445, 42487, 42529, 42578, 42627, 42669, 42718 // 2016
-            // https://www.ecb.europa.eu/press/calendars/reserve/html/index.en.html
-            , 42760, 42809, 42858, 42900, 42942, 42991, 43040, 43089 //2017
+    namespace detail {
+
+        /* The known dates are kept as a sorted array of serial
+           numbers.  The instance is built on first use, which is
+           thread-safe; lookups and copies can run concurrently, and
+           addDate and removeDate take an exclusive lock.
+        */
+        template <class ExtDate>
+        class ECBKnownDates {
+          public:
+            static ECBKnownDates& instance() {
+                static ECBKnownDates dates;
+                return dates;
+            }
+            setExtDate<ExtDate> dates() const {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                setExtDate<ExtDate> result;
+                for (serial_type s : serials_)
+                    result.insert(result.end(), DateAdaptor<ExtDate>::Date(s));
+                return result;
+            }
+            void add(const ExtDate& d) {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                auto i = std::lower_bound(serials_.begin(), serials_.end(),
+                                          serialOf(d));
+                if (i == serials_.end() || *i != serialOf(d))
+                    serials_.insert(i, serialOf(d));
+            }
+            void remove(const ExtDate& d) {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                auto i = std::lower_bound(serials_.begin(), serials_.end(),
+                                          serialOf(d));
+                if (i != serials_.end() && *i == serialOf(d))
+                    serials_.erase(i);
+            }
+            //! the known dates strictly after the given one, at most \p n
+            template <class F>
+            void after(const ExtDate& d, Size n, F f) const {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                QL_REQUIRE(!serials_.empty(), "no ECB dates are known");
+                auto i = std::upper_bound(serials_.begin(), serials_.end(),
+                                          serialOf(d));
+                QL_REQUIRE(i != serials_.end(),
+                           "ECB dates after {} are unknown",
+                           DateAdaptor<ExtDate>::Date(serials_.back()));
+                for (; i != serials_.end() && n > 0; ++i, --n)
+                    f(DateAdaptor<ExtDate>::Date(*i));
+            }
+            //! the last known date strictly before the given one
+            ExtDate before(const ExtDate& d) const {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                QL_REQUIRE(!serials_.empty(), "no ECB dates are known");
+                auto i = std::lower_bound(serials_.begin(), serials_.end(),
+                                          serialOf(d));
+                QL_REQUIRE(i != serials_.begin(),
+                           "ECB dates before {} are unknown",
+                           DateAdaptor<ExtDate>::Date(serials_.front()));
+                return DateAdaptor<ExtDate>::Date(*(i - 1));
+            }
+          private:
+            ECBKnownDates() {
+                static const serial_type knownDatesArray[] = {
+                      38371, 38391, 38420, 38455, 38483, 38511, 38546, 38574, 38602, 38637, 38665, 38692 // 2005
+                    , 38735, 38756, 38784, 38819, 38847, 38883, 38910, 38938, 38966, 39001, 39029, 39064 // 2006
+                    , 39099, 39127, 39155, 39190, 39217, 39246, 39274, 39302, 39337, 39365, 39400, 39428 // 2007
+                    , 39463, 39491, 39519, 39554, 39582, 39610, 39638, 39673, 39701, 39729, 39764, 39792 // 2008
+                    , 39834, 39855, 39883, 39911, 39946, 39974, 40002, 40037, 40065, 40100, 40128, 40155 // 2009
+                    , 40198, 40219, 40247, 40282, 40310, 40345, 40373, 40401, 40429, 40464, 40492, 40520 // 2010
+                    , 40562, 40583, 40611, 40646, 40674, 40709, 40737, 40765, 40800, 40828, 40856, 40891 // 2011
+                    // http://www.ecb.europa.eu/press/pr/date/2011/html/pr110520.en.html
+                    , 40926, 40954, 40982, 41010, 41038, 41073, 41101, 41129, 41164, 41192, 41227, 41255 // 2012
+                    , 41290, 41318, 41346, 41374, 41402, 41437, 41465, 41493, 41528, 41556, 41591, 41619 // 2013
+                    // http://www.ecb.europa.eu/press/pr/date/2013/html/pr130610.en.html
+                    , 41654, 41682, 41710, 41738, 41773, 41801, 41829, 41864, 41892, 41920, 41955, 41983 // 2014
+                    // http://www.ecb.europa.eu/press/pr/date/2014/html/pr140717_1.en.html
+                    , 42032, 42074, 42116, 42165, 42207, 42256, 42305, 42347// 2015
+                    // https://www.ecb.europa.eu/press/pr/date/2015/html/pr150622.en.html
+                    , 42396, 42445, 42487, 42529, 42578, 42627, 42669, 42718 // 2016
+                    // https://www.ecb.europa.eu/press/calendars/reserve/html/index.en.html
+                    , 42760, 42809, 42858, 42900, 42942, 42991, 43040, 43089 //2017
+                };
+                serials_.assign(std::begin(knownDatesArray),
+                                std::end(knownDatesArray));
+            }
+            static serial_type serialOf(const ExtDate& d) {
+                return to_DateLike(d).serialNumber();
+            }
+            std::vector<serial_type> serials_;
+            mutable std::shared_mutex mutex_;
         };
-        if (knownDateSet<ExtDate>::get().empty()) {
-            Size n = sizeof(knownDatesArray)/sizeof(serial_type);
-            for (Size i=0; i<n; ++i)
-                knownDateSet<ExtDate>::get().insert(DateAdaptor<ExtDate>::Date(knownDatesArray[i]));
-        }
 
-        return knownDateSet<ExtDate>::get();
+    }
+
+    template <class ExtDate> inline
+    setExtDate<ExtDate> ECB<ExtDate>::knownDates() {
+        return detail::ECBKnownDates<ExtDate>::instance().dates();
     }
     template <class ExtDate> inline
     void ECB<ExtDate>::addDate(const ExtDate& d) {
-        knownDates(); // just to ensure inizialization
-        knownDateSet<ExtDate>::get().insert(d);
+        detail::ECBKnownDates<ExtDate>::instance().add(d);
     }
     template <class ExtDate> inline
     void ECB<ExtDate>::removeDate(const ExtDate& d) {
-        knownDates(); // just to ensure inizialization
-        knownDateSet<ExtDate>::get().erase(d);
+        detail::ECBKnownDates<ExtDate>::instance().remove(d);
     }
     template <class ExtDate> inline
     ExtDate ECB<ExtDate>::date(const std::string& ecbCode,
@@ -112,7 +172,7 @@ namespace QuantLib {
         //Year y = boost::lexical_cast<Year>(code.substr(3, 2));
 
         Year y = io::to_integer(code.substr(3, 2));
-        ExtDate referenceDate = (refDate != ExtDate() ?
+        ExtDate referenceDate = (refDate != nullDate<ExtDate>() ?
                               refDate :
                               ExtDate(Settings<ExtDate>::instance().evaluationDate()));
         Year referenceYear = (referenceDate.year() % 100);
@@ -182,29 +242,37 @@ namespace QuantLib {
 
     template <class ExtDate> inline
     ExtDate ECB<ExtDate>::nextDate(const ExtDate& date) {
-        ExtDate d = (to_DateLike<ExtDate>(date) == ExtDate() ?
+        ExtDate d = (to_DateLike<ExtDate>(date) == nullDate<ExtDate>() ?
                   Settings<ExtDate>::instance().evaluationDate() :
                   date);
 
-        typename setExtDate<ExtDate>::const_iterator i =
-            std::upper_bound(knownDates().begin(), knownDates().end(), d, Less<ExtDate>());
+        ExtDate result = nullDate<ExtDate>();
+        detail::ECBKnownDates<ExtDate>::instance().after(
+            d, 1, [&result](const ExtDate& e) { result = e; });
+        return result;
+    }
+    template <class ExtDate> inline
+    ExtDate ECB<ExtDate>::previousDate(const ExtDate& date) {
+        ExtDate d = (to_DateLike<ExtDate>(date) == nullDate<ExtDate>() ?
+                  Settings<ExtDate>::instance().evaluationDate() :
+                  date);
 
-        QL_REQUIRE(i!=knownDates().end(), "ECB dates after {} are unknown",
-                   *(--knownDates().end()) ) ;
-        return ExtDate(*i);
+        return detail::ECBKnownDates<ExtDate>::instance().before(d);
     }
     template <class ExtDate> inline
     std::vector<ExtDate> ECB<ExtDate>::nextDates(const ExtDate& date) {
-        ExtDate d = (to_DateLike<ExtDate>(date) == ExtDate() ?
+        return nextDates(date, std::numeric_limits<Size>::max());
+    }
+    template <class ExtDate> inline
+    std::vector<ExtDate> ECB<ExtDate>::nextDates(const ExtDate& date, Size n) {
+        ExtDate d = (to_DateLike<ExtDate>(date) == nullDate<ExtDate>() ?
                   Settings<ExtDate>::instance().evaluationDate() :
                   date);
 
-        typename setExtDate<ExtDate>::const_iterator i = std::upper_bound(
-            knownDates().begin(), knownDates().end(), d, Less<ExtDate>());
-
-        QL_REQUIRE(i!=knownDates().end(), "ECB dates after {} are unknown",
-                    *knownDates().end());
-        return std::vector<ExtDate>(i, knownDates().end());
+        std::vector<ExtDate> result;
+        detail::ECBKnownDates<ExtDate>::instance().after(
+            d, n, [&result](const ExtDate& e) { result.push_back(e); });
+        return result;
     }
 
     template <class ExtDate> inline
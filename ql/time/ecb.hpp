@@ -33,9 +33,13 @@ namespace QuantLib {
     using setExtDate = std::set<ExtDate, Less<ExtDate> >;
 
     //! European Central Bank reserve maintenance dates
+    /*! The known dates can be looked up, added and removed
+        concurrently from several threads.
+    */
     template <class ExtDate>
     struct ECB {
-        static const setExtDate<ExtDate>& knownDates();
+        //! a copy of the known dates at the time of the call
+        static setExtDate<ExtDate> knownDates();
         static void addDate(const ExtDate& d);
         static void removeDate(const ExtDate& d);
 
@@ -50,7 +54,7 @@ namespace QuantLib {
                      string is not an ECB code
         */
         static ExtDate date(const std::string& ecbCode,
-                         const ExtDate& referenceDate = ExtDate());
+                         const ExtDate& referenceDate = nullDate<ExtDate>());
 
         /*! returns the ECB code for the given date
             (e.g. MAR10 for March xxth, 2010).
@@ -61,20 +65,27 @@ namespace QuantLib {
         static std::string code(const ExtDate& ecbDate);
 
         //! next maintenance period start date following the given date
-        static ExtDate nextDate(const ExtDate& d = ExtDate());
+        static ExtDate nextDate(const ExtDate& d = nullDate<ExtDate>());
+
+        //! last maintenance period start date preceding the given date
+        static ExtDate previousDate(const ExtDate& d = nullDate<ExtDate>());
 
         //! next maintenance period start date following the given ECB code
         static ExtDate nextDate(const std::string& ecbCode,
-                             const ExtDate& referenceDate = ExtDate()) {
+                             const ExtDate& referenceDate = nullDate<ExtDate>()) {
             return nextDate(date(ecbCode, referenceDate));
         }
 
         //! next maintenance period start dates following the given date
-        static std::vector<ExtDate> nextDates(const ExtDate& d = ExtDate());
+        static std::vector<ExtDate> nextDates(const ExtDate& d = nullDate<ExtDate>());
+
+        //! next \p n maintenance period start dates following the given date
+        /*! Fewer than \p n dates are returned if not enough are known. */
+        static std::vector<ExtDate> nextDates(const ExtDate& d, Size n);
 
         //! next maintenance period start dates following the given code
         static std::vector<ExtDate> nextDates(const std::string& ecbCode,
-                                           const ExtDate& referenceDate = ExtDate()) {
+                                           const ExtDate& referenceDate = nullDate<ExtDate>()) {
             return nextDates(date(ecbCode, referenceDate));
         }
 
@@ -89,7 +100,7 @@ namespace QuantLib {
         static bool isECBcode(const std::string& in);
 
         //! next ECB code following the given date
-        static std::string nextCode(const ExtDate& d = ExtDate()) {
+        static std::string nextCode(const ExtDate& d = nullDate<ExtDate>()) {
             return code(nextDate(d));
         }
 
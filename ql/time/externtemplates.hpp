@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file externtemplates.hpp
+    \brief explicit instantiation of the ql_time class templates
+
+    By default, ql_time is header-only and this file does nothing.
+
+    When QL_TIME_EXTERN_DATES_HEADER is defined, it names a header
+    which defines the QL_TIME_EXTERN_DATES(X, Template) macro,
+    expanding to X(Template, ExtDate) for each date type, e.g.,
+
+    \code
+    #include <mydate.hpp>
+    #define QL_TIME_EXTERN_DATES(X, Template) \
+        X(Template, QuantLib::Date) X(Template, MyDate)
+    \endcode
+
+    Calendars, day counters and schedules are then declared as
+    explicitly instantiated (extern template) for those types, so
+    that including their headers doesn't instantiate them again in
+    every translation unit; the ql_time_compiled library, which
+    defines QL_TIME_INSTANTIATE_TEMPLATES, provides the
+    instantiations.  The CMake option ql_time_BUILD_COMPILED
+    generates the header and builds the library.
+
+    The headers listed for the date types must not include the
+    ql_time calendar, day-counter or schedule headers.
+*/
+#pragma once
+#ifndef quantlib_extern_templates_hpp
+#define quantlib_extern_templates_hpp
+
+#if defined(QL_TIME_EXTERN_DATES_HEADER)
+#   include QL_TIME_EXTERN_DATES_HEADER
+#endif
+
+#if defined(QL_TIME_EXTERN_DATES)
+#   if defined(QL_TIME_INSTANTIATE_TEMPLATES)
+#       define QL_TIME_EXTERN_TEMPLATE_FOR(Template, ExtDate) \
+            template class Template<ExtDate>;
+#   else
+#       define QL_TIME_EXTERN_TEMPLATE_FOR(Template, ExtDate) \
+            extern template class Template<ExtDate>;
+#   endif
+#   define QL_TIME_EXTERN_TEMPLATE(Template) \
+        QL_TIME_EXTERN_DATES(QL_TIME_EXTERN_TEMPLATE_FOR, Template)
+#else
+#   define QL_TIME_EXTERN_TEMPLATE(Template)
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/futuresdatetable.hpp>
+#include "ql_errors.hpp"
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        inline FuturesDateTable::FuturesDateTable(Size nth, Weekday weekday,
+                                                  Year firstYear, Year lastYear)
+        : nth_(nth), weekday_(weekday),
+          first_(serialNumber(1, January, firstYear)),
+          last_(serialNumber(31, December, lastYear)) {
+            QL_REQUIRE(nth > 0 && nth < 5,
+                       "invalid weekday number ({})", nth);
+            QL_REQUIRE(firstYear <= lastYear,
+                       "invalid futures date range [{}, {}]",
+                       firstYear, lastYear);
+            all_.reserve(12 * (lastYear - firstYear + 1));
+            main_.reserve(4 * (lastYear - firstYear + 1));
+            for (Year y = firstYear; y <= lastYear; ++y) {
+                for (Integer m = January; m <= December; ++m) {
+                    std::int32_t d = std::int32_t(date(Month(m), y));
+                    all_.push_back(d);
+                    if (m % 3 == 0)
+                        main_.push_back(d);
+                }
+            }
+        }
+
+        inline serial_type FuturesDateTable::date(Month m, Year y) const {
+            return serialNumber(nthWeekday(nth_, weekday_, m, y), m, y);
+        }
+
+        inline const std::vector<std::int32_t>&
+        FuturesDateTable::dates(bool mainCycle) const {
+            return mainCycle ? main_ : all_;
+        }
+
+        inline serial_type FuturesDateTable::next(serial_type s,
+                                                  bool mainCycle) const {
+            const std::vector<std::int32_t>& v = dates(mainCycle);
+            if (s >= first_) {
+                auto i = std::upper_bound(v.begin(), v.end(), s);
+                if (i != v.end())
+                    return *i;
+            }
+            // outside the table: the date in the month of s, or the
+            // first one in the following months
+            Year y = year(s);
+            Integer m = month(s);
+            for (;;) {
+                if (!mainCycle || m % 3 == 0) {
+                    serial_type d = date(Month(m), y);
+                    if (d > s)
+                        return d;
+                }
+                if (++m > December) {
+                    m = January;
+                    ++y;
+                }
+            }
+        }
+
+        inline serial_type FuturesDateTable::previous(serial_type s,
+                                                      bool mainCycle) const {
+            const std::vector<std::int32_t>& v = dates(mainCycle);
+            if (s <= last_) {
+                auto i = std::lower_bound(v.begin(), v.end(), s);
+                if (i != v.begin())
+                    return *(i - 1);
+            }
+            Year y = year(s);
+            Integer m = month(s);
+            for (;;) {
+                if (!mainCycle || m % 3 == 0) {
+                    serial_type d = date(Month(m), y);
+                    if (d < s)
+                        return d;
+                }
+                if (--m < January) {
+                    m = December;
+                    --y;
+                }
+            }
+        }
+
+        inline void FuturesDateTable::next(serial_type s, bool mainCycle,
+                                           Size n, serial_type* out) const {
+            const std::vector<std::int32_t>& v = dates(mainCycle);
+            Size i = 0;
+            if (n > 0 && s >= first_) {
+                auto j = std::upper_bound(v.begin(), v.end(), s);
+                Size available = std::min<Size>(n, v.end() - j);
+                std::copy(j, j + available, out);
+                i = available;
+                if (i > 0)
+                    s = out[i - 1];
+            }
+            for (; i < n; ++i)
+                s = out[i] = next(s, mainCycle);
+        }
+
+    }
+
+}
@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file futuresdatetable.hpp
+    \brief precomputed monthly futures dates
+*/
+#pragma once
+#ifndef quantlib_futures_date_table_hpp
+#define quantlib_futures_date_table_hpp
+
+#include <ql/time/date_like.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! futures month codes, January to December
+        inline constexpr char futuresMonthCodes[] = "FGHJKMNQUVXZ";
+
+        //! precomputed n-th weekday of each month
+        /*! Futures delivery dates such as the IMM (third Wednesday)
+            and ASX (second Friday) dates fall on the n-th given
+            weekday of each month; the main cycle is made of the
+            March, June, September and December ones.  The table
+            holds the serial numbers of these dates over the years
+            [firstYear, lastYear], sorted, so that the next or
+            previous date is found by binary search; outside that
+            range, dates are calculated month by month.
+
+            The table is immutable after construction and can be
+            shared between threads.
+        */
+        class FuturesDateTable {
+          public:
+            FuturesDateTable(Size nth, Weekday weekday,
+                             Year firstYear, Year lastYear);
+            //! the <i>n</i>-th date of the month
+            serial_type date(Month m, Year y) const;
+            //! first date strictly after the given one
+            serial_type next(serial_type s, bool mainCycle) const;
+            //! last date strictly before the given one
+            serial_type previous(serial_type s, bool mainCycle) const;
+            //! writes the first \p n dates strictly after the given one
+            void next(serial_type s, bool mainCycle,
+                      Size n, serial_type* out) const;
+          private:
+            const std::vector<std::int32_t>& dates(bool mainCycle) const;
+            Size nth_;
+            Weekday weekday_;
+            // serial numbers of the first and last day covered
+            serial_type first_, last_;
+            std::vector<std::int32_t> all_, main_;
+        };
+
+    }
+
+}
+
+#include "futuresdatetable.cpp"
+#endif
@@ -0,0 +1,207 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/holidaystore.hpp>
+#include "ql_errors.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        inline std::string_view holidayStoreName(const HolidayStore::Entry& e) {
+            return std::string_view(e.name, ::strnlen(e.name, sizeof(e.name)));
+        }
+
+        inline std::uint64_t alignedTo8(std::uint64_t offset) {
+            return (offset + 7) & ~std::uint64_t(7);
+        }
+
+    }
+
+    inline HolidayStore::HolidayStore(const std::string& path)
+    : file_(std::make_shared<const MappedFile>(path)) {
+        const char* data = file_->data();
+        std::uint64_t size = file_->size();
+        QL_REQUIRE(size >= sizeof(Header), "{} is not a holiday store", path);
+        header_ = reinterpret_cast<const Header*>(data);
+        QL_REQUIRE(std::memcmp(header_->magic, magic, sizeof(magic)) == 0,
+                   "{} is not a holiday store", path);
+        QL_REQUIRE(header_->byteOrder == byteOrder,
+                   "{} was written with a different byte order", path);
+        QL_REQUIRE(header_->version == version,
+                   "{}: unsupported holiday store version {}", path, header_->version);
+        QL_REQUIRE(header_->fileSize == size,
+                   "{} is truncated ({} bytes instead of {})", path, size, header_->fileSize);
+        QL_REQUIRE(sizeof(Header) + std::uint64_t(header_->count) * sizeof(Entry) <= size,
+                   "{} is corrupted: entries exceed the file size", path);
+        entries_ = reinterpret_cast<const Entry*>(data + sizeof(Header));
+
+        // check the entries and their tables once, so that lookups
+        // need no checks
+        for (Size i = 0; i < header_->count; ++i) {
+            const Entry& e = entries_[i];
+            QL_REQUIRE(e.first <= e.last &&
+                       e.first >= detail::serialNumber(1, January, 1901) &&
+                       e.last <= detail::serialNumber(31, December, 2199),
+                       "{} is corrupted: invalid range for entry #{}", path, i);
+            std::uint64_t words = (std::uint64_t(e.last - e.first) + 64) / 64;
+            QL_REQUIRE(e.words % 8 == 0 && e.counts % 4 == 0 &&
+                       e.words + words * 8 <= size &&
+                       e.counts + (words + 1) * 4 <= size,
+                       "{} is corrupted: invalid offsets for entry #{}", path, i);
+            // the counts must match the bits, and the bits past the
+            // last day must be clear
+            const auto* w = reinterpret_cast<const std::uint64_t*>(data + e.words);
+            const auto* c = reinterpret_cast<const std::int32_t*>(data + e.counts);
+            QL_REQUIRE(c[0] == 0,
+                       "{} is corrupted: invalid counts for entry #{}", path, i);
+            for (std::uint64_t k = 0; k < words; ++k)
+                QL_REQUIRE(c[k + 1] - c[k] == std::popcount(w[k]),
+                           "{} is corrupted: invalid counts for entry #{}", path, i);
+            std::uint64_t used = std::uint64_t(e.last - e.first + 1) % 64;
+            QL_REQUIRE(used == 0 || (w[words - 1] >> used) == 0,
+                       "{} is corrupted: days past the range of entry #{}", path, i);
+            QL_REQUIRE(i == 0 || detail::holidayStoreName(entries_[i - 1]) <
+                                     detail::holidayStoreName(e),
+                       "{} is corrupted: entries not sorted by name", path);
+        }
+    }
+
+    template <class ExtDate>
+    inline void HolidayStore::write(const std::string& path,
+                                    const std::vector<Calendar<ExtDate> >& calendars,
+                                    Year firstYear,
+                                    Year lastYear) {
+        QL_REQUIRE(firstYear <= lastYear,
+                   "first year ({}) must not be later than last year ({})",
+                   firstYear, lastYear);
+        serial_type first =
+            to_DateLike(DateAdaptor<ExtDate>::Date(1, January, firstYear)).serialNumber();
+        serial_type last =
+            to_DateLike(DateAdaptor<ExtDate>::Date(31, December, lastYear)).serialNumber();
+
+        std::vector<std::pair<Entry, BusinessDayBitmap> > tables;
+        tables.reserve(calendars.size());
+        for (const auto& c : calendars) {
+            std::string name = c.name();
+            QL_REQUIRE(name.size() < sizeof(Entry::name),
+                       "calendar name {} too long for a holiday store", name);
+            Entry e = {};
+            std::memcpy(e.name, name.data(), name.size());
+            e.first = std::int32_t(first);
+            e.last = std::int32_t(last);
+            for (Integer w = Sunday; w <= Saturday; ++w) {
+                if (c.isWeekend(Weekday(w)))
+                    e.weekend |= std::uint32_t(1) << w;
+            }
+            tables.emplace_back(e, BusinessDayBitmap(first, last, [&c](serial_type s) {
+                return c.isBusinessDay(DateAdaptor<ExtDate>::Date(s));
+            }));
+        }
+        write(path, tables);
+    }
+
+    inline void HolidayStore::write(const std::string& path,
+                                    std::vector<std::pair<Entry, BusinessDayBitmap> >& tables) {
+        std::sort(tables.begin(), tables.end(), [](const auto& t1, const auto& t2) {
+            return detail::holidayStoreName(t1.first) < detail::holidayStoreName(t2.first);
+        });
+        for (Size i = 1; i < tables.size(); ++i)
+            QL_REQUIRE(detail::holidayStoreName(tables[i - 1].first) !=
+                           detail::holidayStoreName(tables[i].first),
+                       "duplicate calendar {} in holiday store",
+                       detail::holidayStoreName(tables[i].first));
+
+        // lay out the tables after the entries
+        std::uint64_t offset = sizeof(Header) + tables.size() * sizeof(Entry);
+        for (auto& t : tables) {
+            t.first.words = offset;
+            offset += t.second.words().size_bytes();
+            t.first.counts = offset;
+            offset = detail::alignedTo8(offset + t.second.counts().size_bytes());
+        }
+
+        Header header = {};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.byteOrder = byteOrder;
+        header.count = std::uint32_t(tables.size());
+        header.fileSize = offset;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out, "cannot open {} for writing", path);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& t : tables)
+            out.write(reinterpret_cast<const char*>(&t.first), sizeof(Entry));
+        const char padding[8] = {};
+        for (const auto& t : tables) {
+            auto words = t.second.words();
+            auto counts = t.second.counts();
+            out.write(reinterpret_cast<const char*>(words.data()), words.size_bytes());
+            out.write(reinterpret_cast<const char*>(counts.data()), counts.size_bytes());
+            out.write(padding, std::streamsize(detail::alignedTo8(counts.size_bytes()) -
+                                               counts.size_bytes()));
+        }
+        out.close();
+        QL_REQUIRE(out, "cannot write {}", path);
+    }
+
+    inline const std::string& HolidayStore::path() const {
+        return file_->path();
+    }
+
+    inline Size HolidayStore::size() const {
+        return header_->count;
+    }
+
+    inline Size HolidayStore::find(std::string_view name) const {
+        const Entry* end = entries_ + header_->count;
+        const Entry* e = std::lower_bound(entries_, end, name,
+                                          [](const Entry& e, std::string_view n) {
+                                              return detail::holidayStoreName(e) < n;
+                                          });
+        return (e != end && detail::holidayStoreName(*e) == name) ? Size(e - entries_)
+                                                                    : size();
+    }
+
+    inline std::string_view HolidayStore::name(Size i) const {
+        return detail::holidayStoreName(entry(i));
+    }
+
+    inline bool HolidayStore::isWeekend(Size i, Weekday w) const {
+        return (entry(i).weekend >> Integer(w)) & 1U;
+    }
+
+    inline BusinessDayBitmap HolidayStore::businessDays(Size i) const {
+        const Entry& e = entry(i);
+        const char* data = file_->data();
+        return BusinessDayBitmap(e.first, e.last,
+                                 reinterpret_cast<const std::uint64_t*>(data + e.words),
+                                 reinterpret_cast<const std::int32_t*>(data + e.counts),
+                                 file_);
+    }
+
+    inline const HolidayStore::Entry& HolidayStore::entry(Size i) const {
+        QL_REQUIRE(i < size(), "calendar #{} out of range [0, {})", i, size());
+        return entries_[i];
+    }
+
+}
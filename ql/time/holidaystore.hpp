@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file holidaystore.hpp
+    \brief binary file of precomputed calendars
+*/
+#pragma once
+#ifndef quantlib_holiday_store_hpp
+#define quantlib_holiday_store_hpp
+
+#include <ql/time/calendar.hpp>
+#include <ql/time/businessdaybitmap.hpp>
+#include "ql_utilities_mappedfile.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace QuantLib {
+
+    //! binary file of precomputed calendars
+    /*! The file holds, for each calendar, its name, its weekend days
+        and its business days over a range of years, stored as a
+        BusinessDayBitmap.  It is memory-mapped read-only: opening it
+        checks the header and the tables once, and the calendars built
+        on it (see StoredCalendar) use the mapped tables in place, so
+        that all the processes using the same file share one copy of
+        it in the page cache.
+
+        The layout is that of the machine writing the file; a file
+        written with a different byte order is rejected.
+
+        - header: magic "QLHOLDAY", version, byte-order mark, number
+          of calendars, total file size;
+        - one fixed-size entry per calendar, sorted by name: name
+          (at most 63 characters), first and last serial number,
+          weekend days, offsets of its words and counts;
+        - the words and counts of each calendar, 8-byte aligned.
+
+        \ingroup datetime
+    */
+    class HolidayStore {
+      public:
+        //! maps the given file and checks its layout
+        explicit HolidayStore(const std::string& path);
+        //! writes the given calendars from January 1st of the first
+        //! year to December 31st of the last one
+        /*! Names must be distinct.  Holidays added to or removed from
+            the calendars are included.
+        */
+        template <class ExtDate>
+        static void write(const std::string& path,
+                          const std::vector<Calendar<ExtDate> >& calendars,
+                          Year firstYear,
+                          Year lastYear);
+        //! \name Inspectors
+        //@{
+        const std::string& path() const;
+        //! number of calendars in the file
+        Size size() const;
+        //! index of the named calendar, or size() if not found
+        Size find(std::string_view name) const;
+        std::string_view name(Size i) const;
+        bool isWeekend(Size i, Weekday w) const;
+        //! the business days of the <i>i</i>-th calendar
+        /*! The returned table is a view on the mapped file, which is
+            kept open for as long as the table or its copies exist.
+        */
+        BusinessDayBitmap businessDays(Size i) const;
+        //@}
+
+        //! file layout
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint32_t count;
+            std::uint32_t reserved;
+            std::uint64_t fileSize;
+        };
+        struct Entry {
+            char name[64];
+            std::int32_t first, last;
+            //! bit <i>w</i> is set if weekday <i>w</i> is a weekend day
+            std::uint32_t weekend;
+            std::uint32_t reserved;
+            std::uint64_t words, counts;
+        };
+        static constexpr char magic[8] = {'Q', 'L', 'H', 'O', 'L', 'D', 'A', 'Y'};
+        static constexpr std::uint32_t version = 1;
+        static constexpr std::uint32_t byteOrder = 0x01020304;
+      private:
+        static void write(const std::string& path,
+                          std::vector<std::pair<Entry, BusinessDayBitmap> >& tables);
+        const Entry& entry(Size i) const;
+        std::shared_ptr<const MappedFile> file_;
+        const Header* header_;
+        const Entry* entries_;
+    };
+
+}
+
+#include "holidaystore.cpp"
+#endif
@@ -23,6 +23,8 @@
 #include <ql/time/imm.hpp>
 #include "ql_settings.hpp"
 #include "ql_utilities_dataparsers.hpp"
+#include <ql/time/futuresdatetable.hpp>
+#include <cstring>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -36,6 +38,19 @@
 //using std::string;
 
 namespace QuantLib {
+
+    namespace detail {
+
+        inline const FuturesDateTable& immDates() {
+            // built once, on first use; thread-safe
+            static const FuturesDateTable dates(3, Wednesday,
+                                                QL_FUTURES_DATES_FIRST_YEAR,
+                                                QL_FUTURES_DATES_LAST_YEAR);
+            return dates;
+        }
+
+    }
+
     template <class ExtDate> inline
     bool IMM<ExtDate>::isIMMdate(const ExtDate& dat, bool mainCycle) {
         auto date = to_DateLike(dat);
@@ -79,56 +94,16 @@ namespace QuantLib {
         QL_REQUIRE(isIMMdate(date, false),
                    "{} is not an IMM date",date);
 
-        std::ostringstream IMMcode;
         auto d = to_DateLike(date);
         auto s = d.serialNumber();
-        unsigned int y = d.year(s) % 10;
-        switch(d.month(s)) {
-          case January:
-            IMMcode << 'F' << y;
-            break;
-          case February:
-            IMMcode << 'G' << y;
-            break;
-          case March:
-            IMMcode << 'H' << y;
-            break;
-          case April:
-            IMMcode << 'J' << y;
-            break;
-          case May:
-            IMMcode << 'K' << y;
-            break;
-          case June:
-            IMMcode << 'M' << y;
-            break;
-          case July:
-            IMMcode << 'N' << y;
-            break;
-          case August:
-            IMMcode << 'Q' << y;
-            break;
-          case September:
-            IMMcode << 'U' << y;
-            break;
-          case October:
-            IMMcode << 'V' << y;
-            break;
-          case November:
-            IMMcode << 'X' << y;
-            break;
-          case December:
-            IMMcode << 'Z' << y;
-            break;
-          default:
-            QL_FAIL("not an IMM month (and it should have been)");
-        }
+        std::string IMMcode{detail::futuresMonthCodes[d.month(s) - 1],
+                            char('0' + d.year(s) % 10)};
 
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        QL_ENSURE(isIMMcode(IMMcode.str(), false),
-                  "the result {} is an invalid IMM code",IMMcode.str());
+        QL_ENSURE(isIMMcode(IMMcode, false),
+                  "the result {} is an invalid IMM code",IMMcode);
         #endif
-        return IMMcode.str();
+        return IMMcode;
     }
     template <class ExtDate>    inline
     ExtDate IMM<ExtDate>::date(const std::string& immCode, const ExtDate& refDate) {
@@ -136,67 +111,33 @@ namespace QuantLib {
             , immCode);
 
         DateLike<ExtDate> referenceDate{
-            to_DateLike(refDate) != ExtDate() ?
+            to_DateLike(refDate) != nullDate<ExtDate>() ?
                 to_DateLike(refDate) :
                 DateLike<ExtDate>{Settings<ExtDate>::instance().evaluationDate()}};
-        auto to_upper_copy = [](const std::string& s) { std::string res; for (auto i:s) res.push_back(std::toupper(i)); return res;};
-        std::string code = to_upper_copy(immCode);
-        std::string ms = code.substr(0,1);
-        QuantLib::Month m;
-        if (ms=="F")      m = January;
-        else if (ms=="G") m = February;
-        else if (ms=="H") m = March;
-        else if (ms=="J") m = April;
-        else if (ms=="K") m = May;
-        else if (ms=="M") m = June;
-        else if (ms=="N") m = July;
-        else if (ms=="Q") m = August;
-        else if (ms=="U") m = September;
-        else if (ms=="V") m = October;
-        else if (ms=="X") m = November;
-        else if (ms=="Z") m = December;
-        else QL_FAIL("invalid IMM month letter");
-
-//        Year y = boost::lexical_cast<Year>(); // lexical_cast causes compilation errors with x64
-
-        Year y= io::to_integer(code.substr(1,1));
+        const char* ms = std::strchr(detail::futuresMonthCodes,
+                                     std::toupper(immCode[0]));
+        QuantLib::Month m = QuantLib::Month(ms - detail::futuresMonthCodes + 1);
+
+        Year y = immCode[1] - '0';
         /* year<1900 are not valid QuantLib years: to avoid a run-time
            exception few lines below we need to add 10 years right away */
         auto s = referenceDate.serialNumber();
         if (y==0 && referenceDate.year(s)<=1909) y+=10;
         Year referenceYear = (referenceDate.year(s) % 10);
         y += referenceDate.year(s) - referenceYear;
-        ExtDate result = IMM<ExtDate>::nextDate(DateAdaptor<ExtDate>::Date(1, m, y), false);
+        ExtDate result = DateAdaptor<ExtDate>::Date(detail::immDates().date(m, y));
         if (result<referenceDate)
-            return IMM<ExtDate>::nextDate(DateAdaptor<ExtDate>::Date(1, m, y + 10), false);
+            return DateAdaptor<ExtDate>::Date(detail::immDates().date(m, y + 10));
 
         return result;
     }
     template <class ExtDate>    inline
     ExtDate IMM<ExtDate>::nextDate(const ExtDate& date, bool mainCycle) {
-        DateLike<ExtDate> refDate{(to_DateLike(date) == ExtDate() ?
+        DateLike<ExtDate> refDate{(to_DateLike(date) == nullDate<ExtDate>() ?
                                        ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
                                        date)};
-        auto s = refDate.serialNumber();
-        Year y = refDate.year(s);
-        QuantLib::Month m = refDate.month(s);
-
-        Size offset = mainCycle ? 3 : 1;
-        Size skipMonths = offset-(m%offset);
-        if (skipMonths != offset || refDate.dayOfMonth(s) > 21) {
-            skipMonths += Size(m);
-            if (skipMonths<=12) {
-                m = QuantLib::Month(skipMonths);
-            } else {
-                m = QuantLib::Month(skipMonths-12);
-                y += 1;
-            }
-        }
-
-        ExtDate result = DateLike<ExtDate>::nthWeekday(3, Wednesday, m, y);
-        if (result<=refDate)
-            result = nextDate(DateAdaptor<ExtDate>::Date(22, m, y), mainCycle);
-        return result;
+        return DateAdaptor<ExtDate>::Date(
+            detail::immDates().next(refDate.serialNumber(), mainCycle));
     }
     template <class ExtDate>    inline
     ExtDate IMM<ExtDate>::nextDate(const std::string& IMMcode,
@@ -219,4 +160,29 @@ namespace QuantLib {
         return code(date);
     }
 
+    template <class ExtDate>    inline
+    ExtDate IMM<ExtDate>::previousDate(const ExtDate& date, bool mainCycle) {
+        DateLike<ExtDate> refDate{(to_DateLike(date) == nullDate<ExtDate>() ?
+                                       ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
+                                       date)};
+        return DateAdaptor<ExtDate>::Date(
+            detail::immDates().previous(refDate.serialNumber(), mainCycle));
+    }
+    template <class ExtDate>    inline
+    std::vector<ExtDate> IMM<ExtDate>::nextDates(const ExtDate& date,
+                                                 Size n,
+                                                 bool mainCycle) {
+        DateLike<ExtDate> refDate{(to_DateLike(date) == nullDate<ExtDate>() ?
+                                       ExtDate(Settings<ExtDate>::instance().evaluationDate()) :
+                                       date)};
+        std::vector<serial_type> serials(n);
+        detail::immDates().next(refDate.serialNumber(), mainCycle,
+                                n, serials.data());
+        std::vector<ExtDate> result;
+        result.reserve(n);
+        for (serial_type s : serials)
+            result.push_back(DateAdaptor<ExtDate>::Date(s));
+        return result;
+    }
+
 }
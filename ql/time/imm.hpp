@@ -28,6 +28,7 @@
 #define quantlib_imm_hpp
 
 #include <ql/time/date_like.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -61,14 +62,14 @@ namespace QuantLib {
                      string is not an IMM code
         */
         static ExtDate date(const std::string& immCode,
-                         const ExtDate& referenceDate = ExtDate());
+                         const ExtDate& referenceDate = nullDate<ExtDate>());
 
         //! next IMM date following the given date
         /*! returns the 1st delivery date for next contract listed in the
             International Money Market section of the Chicago Mercantile
             Exchange.
         */
-        static ExtDate nextDate(const ExtDate& d = ExtDate(),
+        static ExtDate nextDate(const ExtDate& d = nullDate<ExtDate>(),
                              bool mainCycle = true);
 
         //! next IMM date following the given IMM code
@@ -78,14 +79,14 @@ namespace QuantLib {
         */
         static ExtDate nextDate(const std::string& immCode,
                              bool mainCycle = true,
-                             const ExtDate& referenceDate = ExtDate());
+                             const ExtDate& referenceDate = nullDate<ExtDate>());
 
         //! next IMM code following the given date
         /*! returns the IMM code for next contract listed in the
             International Money Market section of the Chicago Mercantile
             Exchange.
         */
-        static std::string nextCode(const ExtDate& d = ExtDate(),
+        static std::string nextCode(const ExtDate& d = nullDate<ExtDate>(),
                                     bool mainCycle = true);
 
         //! next IMM code following the given code
@@ -95,7 +96,16 @@ namespace QuantLib {
         */
         static std::string nextCode(const std::string& immCode,
                                     bool mainCycle = true,
-                                    const ExtDate& referenceDate = ExtDate());
+                                    const ExtDate& referenceDate = nullDate<ExtDate>());
+
+        //! previous IMM date preceding the given date
+        static ExtDate previousDate(const ExtDate& d = nullDate<ExtDate>(),
+                                    bool mainCycle = true);
+
+        //! next \p n IMM dates following the given date
+        static std::vector<ExtDate> nextDates(const ExtDate& d,
+                                              Size n,
+                                              bool mainCycle = true);
     };
 
 }
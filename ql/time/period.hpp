@@ -30,6 +30,9 @@
 #include <ql/time/frequency.hpp>
 #include <ql/time/timeunit.hpp>
 #include <ql/time/ql_types.hpp>
+#include <fmt/format.h>
+#include <sstream>
+#include <string>
 
 
 namespace QuantLib {
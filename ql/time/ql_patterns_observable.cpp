@@ -21,7 +21,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 //#include "ql_patterns_observable.hpp"
 
-#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
 
 namespace QuantLib {
     inline
@@ -86,6 +87,160 @@ namespace QuantLib {
 
 }
 
+#elif defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace QuantLib {
+
+    inline void ObservableSettings::enableUpdates() {
+        set_type deferred;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            updatesType_ = UpdatesEnabled;
+            deferred.swap(deferredObservers_);
+        }
+
+        // if there are outstanding deferred updates, do the notification
+        // (outside the lock, since observers might notify in turn)
+        if (!deferred.empty()) {
+            bool successful = true;
+            std::string errMsg;
+
+            for (iterator i=deferred.begin(); i!=deferred.end(); ++i) {
+                try {
+                    const std::shared_ptr<Observer::Proxy> proxy = i->lock();
+                    if (proxy)
+                        proxy->update();
+                } catch (std::exception& e) {
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
+            }
+
+            QL_ENSURE(successful,
+                  "could not notify one or more observers: {}" , errMsg);
+        }
+    }
+
+    inline Observable::Observable()
+    : observers_(std::make_shared<const set_type>()), hasPending_(false),
+      settings_(ObservableSettings::instance()) {}
+
+    inline Observable::Observable(const Observable&)
+    : observers_(std::make_shared<const set_type>()), hasPending_(false),
+      settings_(ObservableSettings::instance()) {
+        // the observer set is not copied; no observer asked to
+        // register with this object
+    }
+
+    inline void Observable::registerObserver(
+        const std::shared_ptr<Observer::Proxy>& observerProxy) {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.emplace_back(observerProxy, true);
+        hasPending_ = true;
+        // keeps the cost of the copies proportional to the changes
+        if (pending_.size() > std::max<Size>(observers_.load()->size(), 16))
+            publish();
+    }
+
+    inline void Observable::unregisterObserver(
+        const std::shared_ptr<Observer::Proxy>& observerProxy) {
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            pending_.emplace_back(observerProxy, false);
+            hasPending_ = true;
+            if (pending_.size() > std::max<Size>(observers_.load()->size(), 16))
+                publish();
+        }
+
+        if (settings_.updatesDeferred()) {
+            std::lock_guard<std::mutex> sLock(settings_.mutex_);
+            if (settings_.updatesDeferred()) {
+                settings_.unregisterDeferredObserver(observerProxy);
+            }
+        }
+    }
+
+    inline std::shared_ptr<const Observable::set_type> Observable::observers() {
+        if (hasPending_) {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            publish();
+        }
+        return observers_.load();
+    }
+
+    inline void Observable::publish() {
+        if (pending_.empty())
+            return;
+
+        // the last change to each observer wins
+        std::unordered_map<Observer::Proxy*,
+                           std::pair<std::shared_ptr<Observer::Proxy>, bool> > changes;
+        for (const auto& p : pending_)
+            changes[p.first.get()] = p;
+
+        const std::shared_ptr<const set_type> current = observers_.load();
+        std::shared_ptr<set_type> updated = std::make_shared<set_type>();
+        updated->reserve(current->size() + changes.size());
+        for (const auto& proxy : *current) {
+            auto i = changes.find(proxy.get());
+            if (i == changes.end()) {
+                updated->push_back(proxy);
+            } else {
+                if (i->second.second)
+                    updated->push_back(proxy);
+                changes.erase(i);
+            }
+        }
+        for (const auto& c : changes) {
+            if (c.second.second)
+                updated->push_back(c.second.first);
+        }
+
+        observers_.store(std::move(updated));
+        pending_.clear();
+        hasPending_ = false;
+    }
+
+    inline void Observable::notifyObservers() {
+        if (!settings_.updatesEnabled()) {
+            std::lock_guard<std::mutex> sLock(settings_.mutex_);
+            if (settings_.updatesDeferred()) {
+                // if updates are only deferred, flag this for later
+                // notification; these are held centrally by the
+                // settings singleton
+                settings_.registerDeferredObservers(*observers());
+                return;
+            } else if (!settings_.updatesEnabled()) {
+                return;
+            }
+        }
+
+        const std::shared_ptr<const set_type> observers = this->observers();
+        bool successful = true;
+        std::string errMsg;
+        for (iterator i=observers->begin(); i!=observers->end(); ++i) {
+            try {
+                (*i)->update();
+            } catch (std::exception& e) {
+                // as in the single-threaded version, notify all
+                // observers and raise an exception afterwards
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: {}" , errMsg);
+    }
+
+}
+
 #else
 
 #include <ql/functional.hpp>
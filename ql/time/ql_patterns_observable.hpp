@@ -37,7 +37,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <unordered_set>
 
 
-#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && \
+    !defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
 
 namespace QuantLib {
 
@@ -244,6 +245,317 @@ namespace QuantLib {
 
 }
 
+#elif defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace QuantLib {
+    class Observable;
+    class ObservableSettings;
+
+    //! Object that gets notified when a given observable changes
+    /*! \ingroup patterns */
+    class Observer : public std::enable_shared_from_this<Observer> {
+        friend class Observable;
+        friend class ObservableSettings;
+      public:
+        typedef std::unordered_set<std::shared_ptr<Observable> > set_type;
+        typedef set_type::iterator iterator;
+
+        // constructors, assignment, destructor
+        Observer() {}
+        Observer(const Observer&);
+        Observer& operator=(const Observer&);
+        virtual ~Observer();
+        // observer interface
+        std::pair<iterator, bool>
+            registerWith(const std::shared_ptr<Observable>&);
+        /*! register with all observables of a given observer. Note
+            that this does not include registering with the observer
+            itself. */
+        void registerWithObservables(const std::shared_ptr<Observer>&);
+        Size unregisterWith(const std::shared_ptr<Observable>&);
+        void unregisterWithAll();
+
+        /*! This method must be implemented in derived classes. An
+            instance of %Observer does not call this method directly:
+            instead, it will be called by the observables the instance
+            registered with when they need to notify any changes.
+        */
+        virtual void update() = 0;
+
+        /*! This method allows to explicitly update the instance itself
+          and nested observers. If notifications are disabled a call to
+          this method ensures an update of such nested observers. It
+          should be implemented in derived classes whenever applicable */
+        virtual void deepUpdate();
+
+      private:
+
+        class Proxy {
+          public:
+            explicit Proxy(Observer* const observer)
+             : active_  (true),
+               observer_(observer) {
+            }
+
+            void update() const {
+                // only serializes the notifications of this observer
+                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                if (active_) {
+                    const std::weak_ptr<Observer> o
+                        = observer_->weak_from_this();
+
+                    // check for empty weak reference
+                    const std::weak_ptr<Observer> empty;
+                    if (o.owner_before(empty) || empty.owner_before(o)) {
+                        const std::shared_ptr<Observer> obs(o.lock());
+                        if (obs)
+                            obs->update();
+                    }
+                    else {
+                        observer_->update();
+                    }
+                }
+            }
+
+            void deactivate() {
+                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                active_ = false;
+            }
+
+        private:
+            bool active_;
+            mutable std::recursive_mutex mutex_;
+            Observer* const observer_;
+        };
+
+        std::shared_ptr<Proxy> proxy_;
+        mutable std::recursive_mutex mutex_;
+
+        set_type observables_;
+    };
+
+    //! Object that notifies its changes to a set of observers
+    /*! The registered observers are kept in an immutable list, which
+        notifyObservers() reads through an atomic shared pointer
+        without taking any lock; concurrent notifications don't
+        serialize on the observable.
+
+        Registrations and unregistrations are queued instead, and
+        folded into a new copy of the list as a batch: at the next
+        notification, or when the queue grows as long as the list.
+        Registering many observers with the same observable (e.g.,
+        every instrument with the evaluation date) thus copies the
+        list a logarithmic number of times, not once per observer.
+
+        A notification goes to the observers registered when it
+        started; an observer unregistering concurrently might still
+        receive it, but never after its destruction.
+
+        \warning as in the Boost-based thread-safe pattern, an observer
+                 that can be destroyed while another thread notifies
+                 it must be held by a shared_ptr; the notification
+                 then keeps it alive until its update() returns.  An
+                 observer that is not held by a shared_ptr can be
+                 destroyed during its update(), once its derived part
+                 is gone but before it is unregistered.
+
+        \ingroup patterns
+    */
+    class Observable {
+        friend class Observer;
+        friend class ObservableSettings;
+      public:
+        typedef std::vector<std::shared_ptr<Observer::Proxy> > set_type;
+        typedef set_type::const_iterator iterator;
+
+        // constructors, assignment, destructor
+        Observable();
+        Observable(const Observable&);
+        Observable& operator=(const Observable&);
+        virtual ~Observable() {}
+        /*! This method should be called at the end of non-const methods
+            or when the programmer desires to notify any changes.
+        */
+        void notifyObservers();
+      private:
+        void registerObserver(const std::shared_ptr<Observer::Proxy>&);
+        void unregisterObserver(const std::shared_ptr<Observer::Proxy>&);
+        //! the current list, with the queued changes applied
+        std::shared_ptr<const set_type> observers();
+        // to be called with pendingMutex_ locked
+        void publish();
+
+        std::atomic<std::shared_ptr<const set_type> > observers_;
+        // queued registrations (true) and unregistrations (false)
+        std::vector<std::pair<std::shared_ptr<Observer::Proxy>, bool> > pending_;
+        std::atomic<bool> hasPending_;
+        std::mutex pendingMutex_;
+
+        ObservableSettings& settings_;
+    };
+
+    //! global repository for run-time library settings
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+
+    public:
+        void disableUpdates(bool deferred=false) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            updatesType_ = (deferred) ? UpdatesDeferred : 0;
+        }
+        void enableUpdates();
+
+        bool updatesEnabled()  {return (updatesType_ & UpdatesEnabled) != 0; }
+        bool updatesDeferred() {return (updatesType_ & UpdatesDeferred) != 0; }
+      private:
+        ObservableSettings() : updatesType_(UpdatesEnabled) {}
+
+        typedef std::set<std::weak_ptr<Observer::Proxy>,
+                         std::owner_less<std::weak_ptr<Observer::Proxy> > >
+            set_type;
+        typedef set_type::iterator iterator;
+
+        void registerDeferredObservers(const Observable::set_type& observers);
+        void unregisterDeferredObserver(
+            const std::shared_ptr<Observer::Proxy>& proxy);
+
+        set_type deferredObservers_;
+        mutable std::mutex mutex_;
+
+        enum UpdateType { UpdatesEnabled = 1, UpdatesDeferred = 2} ;
+        std::atomic<int> updatesType_;
+    };
+
+
+    // inline definitions
+
+    inline void ObservableSettings::registerDeferredObservers(
+        const Observable::set_type& observers) {
+        deferredObservers_.insert(observers.begin(), observers.end());
+    }
+
+    inline void ObservableSettings::unregisterDeferredObserver(
+        const std::shared_ptr<Observer::Proxy>& o) {
+        deferredObservers_.erase(o);
+    }
+
+    /*! \warning notification is sent before the copy constructor has
+             a chance of actually change the data
+             members. Therefore, observers whose update() method
+             tries to use their observables will not see the
+             updated values. It is suggested that the update()
+             method just raise a flag in order to trigger
+            a later recalculation.
+    */
+    inline Observable& Observable::operator=(const Observable& o) {
+        // as above, the observer set is not copied. Moreover,
+        // observers of this object must be notified of the change
+        if (&o != this)
+            notifyObservers();
+        return *this;
+    }
+
+    inline Observer::Observer(const Observer& o)
+    : std::enable_shared_from_this<Observer>() {
+        // the copy is a different object: it doesn't share the
+        // ownership information of the original
+        proxy_.reset(new Proxy(this));
+
+        {
+             std::lock_guard<std::recursive_mutex> lock(o.mutex_);
+             observables_ = o.observables_;
+        }
+
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->registerObserver(proxy_);
+    }
+
+    inline Observer& Observer::operator=(const Observer& o) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (!proxy_) {
+            proxy_.reset(new Proxy(this));
+        }
+
+        iterator i;
+        for (i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->unregisterObserver(proxy_);
+
+        {
+            std::lock_guard<std::recursive_mutex> lock(o.mutex_);
+            observables_ = o.observables_;
+        }
+        for (i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->registerObserver(proxy_);
+
+        return *this;
+    }
+
+    inline Observer::~Observer() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (proxy_)
+            proxy_->deactivate();
+
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->unregisterObserver(proxy_);
+    }
+
+    inline std::pair<Observer::iterator, bool>
+    Observer::registerWith(const std::shared_ptr<Observable>& h) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (!proxy_) {
+            proxy_.reset(new Proxy(this));
+        }
+
+        if (h) {
+            h->registerObserver(proxy_);
+            return observables_.insert(h);
+        }
+        return std::make_pair(observables_.end(), false);
+    }
+
+    inline void
+    Observer::registerWithObservables(const std::shared_ptr<Observer>& o) {
+        if (o) {
+            std::lock_guard<std::recursive_mutex> lock(o->mutex_);
+
+            for (iterator i = o->observables_.begin();
+                 i != o->observables_.end(); ++i)
+                registerWith(*i);
+        }
+    }
+
+    inline
+    Size Observer::unregisterWith(const std::shared_ptr<Observable>& h) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+        if (h && proxy_)  {
+            h->unregisterObserver(proxy_);
+        }
+
+        return observables_.erase(h);
+    }
+
+    inline void Observer::unregisterWithAll() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+            (*i)->unregisterObserver(proxy_);
+
+        observables_.clear();
+    }
+
+    inline void Observer::deepUpdate() {
+        update();
+    }
+}
+
 #else
 
 #include <boost/atomic.hpp>
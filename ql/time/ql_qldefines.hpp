@@ -116,6 +116,10 @@
     #endif
 #endif
 
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) && defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
+    #error Only one of the thread-safe and copy-on-write observer patterns can be enabled
+#endif
+
 #ifdef QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
     #if BOOST_VERSION < 105900
         #error Boost version 1.59 or higher is required for the parallel unit test runner
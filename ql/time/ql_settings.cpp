@@ -24,26 +24,44 @@
 namespace QuantLib {
     template <class ExtDate> inline
     Settings<ExtDate>::DateProxy::DateProxy()
-    : ObservableValue<ExtDate>(ExtDate()) {}
+    : ObservableValue<ExtDate>(nullDate<ExtDate>()) {}
     template <class ExtDate> inline
     std::ostream& operator<<(std::ostream& out,
                              const typename Settings<ExtDate>::DateProxy& p) {
         return out << ExtDate(p);
     }
     template <class ExtDate> inline
-    Settings<ExtDate>::Settings()
-    : includeReferenceDateEvents_(false),
-      enforcesTodaysHistoricFixings_(false) {}
+    Settings<ExtDate>::Settings() {}
     template <class ExtDate> inline
     void Settings<ExtDate>::anchorEvaluationDate() {
         // set to today's date if not already set.
-        if (evaluationDate_.value() == ExtDate())
-            evaluationDate_ = ExtDate::todaysDate();
+        DateProxy& evaluationDate = values().evaluationDate;
+        if (to_DateLike(evaluationDate.value()) == nullDate<ExtDate>())
+            evaluationDate = DateLike<ExtDate>::todaysDate();
         // If set, no-op since the date is already anchored.
     }
     template <class ExtDate> inline
     void Settings<ExtDate>::resetEvaluationDate() {
-        evaluationDate_ = ExtDate();
+        values().evaluationDate = nullDate<ExtDate>();
+    }
+    template <class ExtDate> inline
+    SettingsContext<ExtDate>::SettingsContext()
+    : previous_(Settings<ExtDate>::local_) {
+        const auto& current = Settings<ExtDate>::instance().values();
+        values_.evaluationDate = current.evaluationDate.value();
+        values_.includeReferenceDateEvents = current.includeReferenceDateEvents;
+        values_.includeTodaysCashFlows = current.includeTodaysCashFlows;
+        values_.enforcesTodaysHistoricFixings = current.enforcesTodaysHistoricFixings;
+        Settings<ExtDate>::local_ = &values_;
+    }
+    template <class ExtDate> inline
+    SettingsContext<ExtDate>::SettingsContext(const ExtDate& evaluationDate)
+    : SettingsContext() {
+        values_.evaluationDate = evaluationDate;
+    }
+    template <class ExtDate> inline
+    SettingsContext<ExtDate>::~SettingsContext() {
+        Settings<ExtDate>::local_ = previous_;
     }
     template <class ExtDate> inline
     SavedSettings<ExtDate>::SavedSettings()
@@ -56,7 +74,8 @@ namespace QuantLib {
     template <class ExtDate> inline
     SavedSettings<ExtDate>::~SavedSettings() {
         try {
-            if (Settings<ExtDate>::instance().evaluationDate() != evaluationDate_)
+            ExtDate current = Settings<ExtDate>::instance().evaluationDate();
+            if (to_DateLike(current) != evaluationDate_)
                 Settings<ExtDate>::instance().evaluationDate() = evaluationDate_;
             Settings<ExtDate>::instance().includeReferenceDateEvents() =
                 includeReferenceDateEvents_;
@@ -28,6 +28,7 @@
 
 #include "ql_patterns_singleton.hpp"
 #include <ql/time/date.hpp>
+#include <ql/time/date_like.hpp>
 #include "ql_utilities_observablevalue.hpp"
 #include <optional>
 
@@ -37,10 +38,17 @@
 
 namespace QuantLib {
 
+    template <class ExtDate> class SettingsContext;
+
     //! global repository for run-time library settings
+    /*! The settings are shared by all threads, unless a
+        SettingsContext is active on the calling thread; the
+        accessors below then return the settings of that context.
+    */
     template <class ExtDate=Date>
     class Settings : public Singleton<Settings<ExtDate>> {
         friend class Singleton<Settings<ExtDate>>;
+        friend class SettingsContext<ExtDate>;
       private:
         Settings();
         class DateProxy : public ObservableValue<ExtDate> {
@@ -50,6 +58,15 @@ namespace QuantLib {
             operator ExtDate() const;
         };
         friend std::ostream& operator<<(std::ostream&, const DateProxy&);
+        struct Values {
+            DateProxy evaluationDate;
+            bool includeReferenceDateEvents = false;
+            std::optional<bool> includeTodaysCashFlows;
+            bool enforcesTodaysHistoricFixings = false;
+        };
+        //! the settings in effect on the calling thread
+        Values& values();
+        const Values& values() const;
       public:
         //! the date at which pricing is to be performed.
         /*! Client code can inspect the evaluation date, as in:
@@ -81,12 +98,12 @@ namespace QuantLib {
             performance.)  If no evaluation date was previously set,
             it is equivalent to setting the evaluation date to
             ExtDate::todaysDate(); if an evaluation date other than
-            ExtDate() was already set, it has no effect.
+            nullDate<ExtDate>() was already set, it has no effect.
         */
         void anchorEvaluationDate();
         /*! Call this to reset the evaluation date to
             ExtDate::todaysDate() and allow it to change at midnight.  It
-            is equivalent to setting the evaluation date to ExtDate().
+            is equivalent to setting the evaluation date to nullDate<ExtDate>().
             This comes at the price of losing some performance, since
             the evaluation date is re-evaluated each time it is read.
         */
@@ -113,10 +130,42 @@ namespace QuantLib {
         bool& enforcesTodaysHistoricFixings();
         bool enforcesTodaysHistoricFixings() const;
       private:
-        DateProxy evaluationDate_;
-        bool includeReferenceDateEvents_;
-        std::optional<bool> includeTodaysCashFlows_;
-        bool enforcesTodaysHistoricFixings_;
+        Values global_;
+        // innermost context active on the calling thread, if any
+        static inline thread_local Values* local_ = nullptr;
+    };
+
+
+    //! thread-local run-time library settings
+    /*! While an instance exists, the settings accessed through
+        Settings<ExtDate>::instance() on the thread that created it
+        are its own; they start as a copy of the settings in effect
+        when it was created.  Other threads are not affected, so
+        that each can run valuations at its own evaluation date
+        without locking.  SavedSettings created within the context
+        save and restore the settings of the context.
+
+        Contexts can be nested; they must be destroyed on the thread
+        that created them, in reverse order of creation.  Observers
+        registered with the evaluation date while a context is active
+        are notified of its changes within that context only.
+
+        \warning Settings<ExtDate>::instance() must have been called
+                 at least once, e.g., to set the global evaluation
+                 date, before contexts are created concurrently.
+    */
+    template <class ExtDate=Date>
+    class SettingsContext {
+      public:
+        SettingsContext();
+        //! starts from the given evaluation date
+        explicit SettingsContext(const ExtDate& evaluationDate);
+        ~SettingsContext();
+        SettingsContext(const SettingsContext&) = delete;
+        SettingsContext& operator=(const SettingsContext&) = delete;
+      private:
+        typename Settings<ExtDate>::Values values_;
+        typename Settings<ExtDate>::Values* previous_;
     };
 
 
@@ -137,7 +186,7 @@ namespace QuantLib {
     // inline
     template <class ExtDate>
     inline Settings<ExtDate>::DateProxy::operator ExtDate() const {
-        if (to_DateLike(this->value()) == ExtDate())
+        if (to_DateLike(this->value()) == nullDate<ExtDate>())
             return DateLike<ExtDate>::todaysDate();
         else
             return this->value();
@@ -148,36 +197,44 @@ namespace QuantLib {
         return *this;
     }
     template <class ExtDate>
+    inline typename Settings<ExtDate>::Values& Settings<ExtDate>::values() {
+        return local_ ? *local_ : global_;
+    }
+    template <class ExtDate>
+    inline const typename Settings<ExtDate>::Values& Settings<ExtDate>::values() const {
+        return local_ ? *local_ : global_;
+    }
+    template <class ExtDate>
     inline typename Settings<ExtDate>::DateProxy& Settings<ExtDate>::evaluationDate() {
-        return evaluationDate_;
+        return values().evaluationDate;
     }
     template <class ExtDate>
     inline const typename Settings<ExtDate>::DateProxy& Settings<ExtDate>::evaluationDate() const {
-        return evaluationDate_;
+        return values().evaluationDate;
     }
     template <class ExtDate>
     inline bool& Settings<ExtDate>::includeReferenceDateEvents() {
-        return includeReferenceDateEvents_;
+        return values().includeReferenceDateEvents;
     }
     template <class ExtDate>
     inline bool Settings<ExtDate>::includeReferenceDateEvents() const {
-        return includeReferenceDateEvents_;
+        return values().includeReferenceDateEvents;
     }
     template <class ExtDate>
     inline std::optional<bool>& Settings<ExtDate>::includeTodaysCashFlows() {
-        return includeTodaysCashFlows_;
+        return values().includeTodaysCashFlows;
     }
     template <class ExtDate>
     inline std::optional<bool> Settings<ExtDate>::includeTodaysCashFlows() const {
-        return includeTodaysCashFlows_;
+        return values().includeTodaysCashFlows;
     }
     template <class ExtDate>
     inline bool& Settings<ExtDate>::enforcesTodaysHistoricFixings() {
-        return enforcesTodaysHistoricFixings_;
+        return values().enforcesTodaysHistoricFixings;
     }
     template <class ExtDate>
     inline bool Settings<ExtDate>::enforcesTodaysHistoricFixings() const {
-        return enforcesTodaysHistoricFixings_;
+        return values().enforcesTodaysHistoricFixings;
     }
 
 }
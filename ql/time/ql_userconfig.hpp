@@ -75,6 +75,14 @@
 //#    define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 #endif
 
+/* Define this, instead of the above, for a thread-safe observer
+   pattern relying on the standard library only: notifications read
+   an immutable copy of the observer list without locking, while
+   registrations are queued and applied in batches. */
+#ifndef QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN
+//#    define QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN
+#endif
+
 /* Define this to enable a date resolution down to microseconds and
    allow for accurate intraday pricing.*/
 #ifndef QL_HIGH_RESOLUTION_DATE
@@ -121,4 +129,15 @@
 //#   define QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
 #endif
 
+/* Define these to change the range of years over which IMM and ASX
+   dates are precomputed; dates outside the range are calculated
+   when needed.
+*/
+#ifndef QL_FUTURES_DATES_FIRST_YEAR
+#   define QL_FUTURES_DATES_FIRST_YEAR 1950
+#endif
+#ifndef QL_FUTURES_DATES_LAST_YEAR
+#   define QL_FUTURES_DATES_LAST_YEAR 2100
+#endif
+
 #endif
@@ -39,6 +39,7 @@
 #pragma GCC diagnostic pop
 #endif
 #include <locale>
+#include <algorithm>
 #include <cctype>
 #if defined(BOOST_NO_STDC_NAMESPACE)
     namespace std { using ::toupper; }
@@ -56,6 +57,178 @@ namespace QuantLib {
         //#endif
         }
 
+        namespace detail {
+
+            // dates are converted in chunks of this size
+            constexpr Size bulkDateChunkSize = 256;
+
+            inline bool isDateDelimiter(char c) {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\n'
+                    || c == ',' || c == ';';
+            }
+
+            // digits in [p, p+n), or -1 if any is not a digit
+            inline Integer parseDigits(const char* p, Size n) {
+                Integer result = 0;
+                for (Size i = 0; i < n; ++i) {
+                    unsigned digit = static_cast<unsigned char>(p[i]) - '0';
+                    if (digit > 9)
+                        return -1;
+                    result = result * 10 + Integer(digit);
+                }
+                return result;
+            }
+
+            // serial number of a token, or 0 if invalid
+            inline serial_type parseDateToken(const char* p, Size n,
+                                              DateFormat::Layout layout) {
+                Integer y, m, d;
+                switch (layout) {
+                  case DateFormat::ISO:
+                    if (n != 10 || p[4] != '-' || p[7] != '-')
+                        return 0;
+                    y = parseDigits(p, 4);
+                    m = parseDigits(p + 5, 2);
+                    d = parseDigits(p + 8, 2);
+                    break;
+                  case DateFormat::Compact:
+                    if (n != 8)
+                        return 0;
+                    y = parseDigits(p, 4);
+                    m = parseDigits(p + 4, 2);
+                    d = parseDigits(p + 6, 2);
+                    break;
+                  case DateFormat::Serial: {
+                    if (n == 0 || n > 6)
+                        return 0;
+                    Integer s = parseDigits(p, n);
+                    return s >= 367 && s <= 109574 ? s : 0;
+                  }
+                  default:
+                    return 0;
+                }
+                if (y < 1901 || y > 2199 || m < 1 || m > 12 || d < 1 ||
+                    d > QuantLib::detail::monthLength(Month(m), QuantLib::detail::isLeap(y)))
+                    return 0;
+                return QuantLib::detail::serialNumber(d, Month(m), y);
+            }
+
+            // calls f(i, serial) for the i-th token
+            template <class F> inline
+            Size forEachDateToken(std::string_view text,
+                                  DateFormat::Layout layout,
+                                  Size capacity,
+                                  F f) {
+                const char* p = text.data();
+                const char* end = p + text.size();
+                Size n = 0;
+                for (;;) {
+                    while (p != end && isDateDelimiter(*p))
+                        ++p;
+                    if (p == end)
+                        break;
+                    const char* q = p;
+                    while (q != end && !isDateDelimiter(*q))
+                        ++q;
+                    QL_REQUIRE(n < capacity,
+                               "more than {} dates in buffer", capacity);
+                    serial_type s = parseDateToken(p, Size(q - p), layout);
+                    QL_REQUIRE(s != 0, "invalid date '{}' at offset {}",
+                               std::string(p, q), Size(p - text.data()));
+                    f(n++, s);
+                    p = q;
+                }
+                return n;
+            }
+
+            inline char* writeDigits(char* p, Integer value, Size n) {
+                for (Size i = n; i > 0; --i) {
+                    p[i - 1] = char('0' + value % 10);
+                    value /= 10;
+                }
+                return p + n;
+            }
+
+        }
+
+        inline
+        Size parse_serials(std::string_view text,
+                           std::span<serial_type> serials,
+                           DateFormat::Layout layout) {
+            return detail::forEachDateToken(text, layout, serials.size(),
+                                            [&](Size i, serial_type s) {
+                                                serials[i] = s;
+                                            });
+        }
+
+        namespace detail {
+
+            // appends the tokens to the result, without reallocating
+            // if its capacity is already enough
+            inline void appendSerials(std::string& result,
+                                      std::span<const serial_type> serials,
+                                      DateFormat::Layout layout,
+                                      char separator) {
+                static const Size width[] = { 10, 8, 6 };
+                QL_REQUIRE(layout >= DateFormat::ISO && layout <= DateFormat::Serial,
+                           "unknown date layout ({})", Integer(layout));
+                Size offset = result.size();
+                result.resize(offset + serials.size() * (width[layout] + 1));
+                char* p = result.data() + offset;
+                for (serial_type s : serials) {
+                    QL_REQUIRE(s >= 367 && s <= 109574,
+                               "serial number ({}) outside allowed range [367-109574]", s);
+                    switch (layout) {
+                      case DateFormat::ISO:
+                        p = writeDigits(p, QuantLib::detail::year(s), 4);
+                        *p++ = '-';
+                        p = writeDigits(p, QuantLib::detail::month(s), 2);
+                        *p++ = '-';
+                        p = writeDigits(p, QuantLib::detail::dayOfMonth(s), 2);
+                        break;
+                      case DateFormat::Compact:
+                        p = writeDigits(p, QuantLib::detail::year(s), 4);
+                        p = writeDigits(p, QuantLib::detail::month(s), 2);
+                        p = writeDigits(p, QuantLib::detail::dayOfMonth(s), 2);
+                        break;
+                      case DateFormat::Serial:
+                        p = writeDigits(p, s, s >= 100000 ? 6 : (s >= 10000 ? 5 : (s >= 1000 ? 4 : 3)));
+                        break;
+                    }
+                    *p++ = separator;
+                }
+                result.resize(Size(p - result.data()));
+            }
+
+        }
+
+        inline
+        std::string format_serials(std::span<const serial_type> serials,
+                                   DateFormat::Layout layout,
+                                   char separator) {
+            std::string result;
+            detail::appendSerials(result, serials, layout, separator);
+            return result;
+        }
+
+        template <class ExtDate> inline
+        std::string format_dates(std::span<const ExtDate> dates,
+                                 DateFormat::Layout layout,
+                                 char separator) {
+            // ISO tokens and their separators are the longest
+            std::string result;
+            result.reserve(dates.size() * 11);
+            serial_type serials[detail::bulkDateChunkSize];
+            for (Size i = 0; i < dates.size(); i += detail::bulkDateChunkSize) {
+                Size n = std::min(detail::bulkDateChunkSize, dates.size() - i);
+                for (Size j = 0; j < n; ++j)
+                    serials[j] = to_DateLike(dates[i + j]).serialNumber();
+                detail::appendSerials(result, std::span<const serial_type>(serials, n),
+                                      layout, separator);
+            }
+            return result;
+        }
+
     }
     inline
     Period PeriodParser::parse(const std::string& str) {
@@ -132,5 +305,14 @@ namespace QuantLib {
 
         return DateAdaptor<ExtDate>::Date(day, month, year);
     }
+    template <class ExtDate> inline
+    Size DateParser<ExtDate>::parse(std::string_view text,
+                                    std::span<ExtDate> dates,
+                                    DateFormat::Layout layout) {
+        return io::detail::forEachDateToken(text, layout, dates.size(),
+                                            [&](Size i, serial_type s) {
+                                                dates[i] = DateAdaptor<ExtDate>::Date(s);
+                                            });
+    }
 
 }
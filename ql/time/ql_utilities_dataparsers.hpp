@@ -28,14 +28,48 @@
 #define quantlib_data_parsers_hpp
 
 #include <ql/time/date.hpp>
+#include <ql/time/date_like.hpp>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace QuantLib {
 
+    //! layouts of date tokens for bulk parsing and formatting
+    struct DateFormat {
+        enum Layout {
+            ISO,      /*!< yyyy-mm-dd */
+            Compact,  /*!< yyyymmdd */
+            Serial    /*!< serial number, as used by Excel */
+        };
+    };
+
     namespace io {
 
         Integer to_integer(const std::string&);
 
+        //! parses a buffer of date tokens into serial numbers
+        /*! Tokens are separated by runs of blanks, commas, semicolons
+            or line breaks.  Parsing is locale-free and doesn't
+            allocate; invalid tokens raise an error.  Returns the
+            number of dates parsed.
+        */
+        Size parse_serials(std::string_view text,
+                           std::span<serial_type> serials,
+                           DateFormat::Layout layout);
+
+        //! formats serial numbers as date tokens, each followed by the separator
+        std::string format_serials(std::span<const serial_type> serials,
+                                   DateFormat::Layout layout,
+                                   char separator = '\n');
+
+        //! formats dates as tokens, each followed by the separator
+        template <class ExtDate>
+        std::string format_dates(std::span<const ExtDate> dates,
+                                 DateFormat::Layout layout,
+                                 char separator = '\n');
+
     }
 
     class PeriodParser {
@@ -54,6 +88,11 @@ namespace QuantLib {
         static ExtDate parseFormatted(const std::string& str,
                                    const std::string& fmt);
         static ExtDate parseISO(const std::string& str);
+        //! Parses a buffer of date tokens, see io::parse_serials().
+        /*! Returns the number of dates written to \p dates. */
+        static Size parse(std::string_view text,
+                          std::span<ExtDate> dates,
+                          DateFormat::Layout layout);
     };
 
 }
@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ql_utilities_dispatch.hpp
+    \brief conversion of a polymorphic implementation to a closed set of types
+*/
+#pragma once
+#ifndef quantlib_utilities_dispatch_hpp
+#define quantlib_utilities_dispatch_hpp
+
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+#include <variant>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* Stores into result the address of impl, as the alternative
+           of Variant (a variant of pointers to const) whose pointee
+           is exactly the dynamic type of impl; derived types are not
+           taken for their bases.  Returns false if no alternative
+           matches.  Calls through the stored pointer can then be
+           qualified with the concrete type and inlined. */
+        template <class Variant, class Base, std::size_t I = 0>
+        inline bool exactCast(const Base& impl, Variant& result) {
+            if constexpr (I == std::variant_size_v<Variant>) {
+                return false;
+            } else {
+                using T = std::remove_const_t<
+                    std::remove_pointer_t<std::variant_alternative_t<I, Variant> > >;
+                if (typeid(impl) == typeid(T)) {
+                    result.template emplace<I>(static_cast<const T*>(&impl));
+                    return true;
+                }
+                return exactCast<Variant, Base, I + 1>(impl, result);
+            }
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "ql_utilities_mappedfile.hpp"
+#include "ql_errors.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace QuantLib {
+
+#if defined(_WIN32)
+
+    MappedFile::MappedFile(const std::string& path) : path_(path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        QL_REQUIRE(file != INVALID_HANDLE_VALUE, "cannot open {}", path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            QL_FAIL("cannot read the size of {}", path);
+        }
+        size_ = std::size_t(size.QuadPart);
+        if (size_ == 0) {
+            CloseHandle(file);
+            QL_FAIL("{} is empty", path);
+        }
+        // the mapping keeps the file open
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        QL_REQUIRE(mapping != nullptr, "cannot map {}", path);
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            CloseHandle(mapping);
+            QL_FAIL("cannot map {}", path);
+        }
+        mapping_ = mapping;
+        data_ = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile() {
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string& path) : path_(path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        QL_REQUIRE(fd != -1, "cannot open {}", path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            QL_FAIL("cannot read the size of {}", path);
+        }
+        size_ = std::size_t(info.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            QL_FAIL("{} is empty", path);
+        }
+        // the mapping stays valid after the descriptor is closed
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        QL_REQUIRE(data != MAP_FAILED, "cannot map {}", path);
+        data_ = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile() {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+
+#endif
+
+}
@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ql_utilities_mappedfile.hpp
+    \brief read-only memory-mapped files
+
+    Unlike the rest of ql_time, this class is not header-only: its
+    platform-dependent implementation is compiled once, in
+    ql_utilities_mappedfile.cpp (the ql_time_mappedfile library), so
+    that the system headers it needs are kept out of this one.
+*/
+#pragma once
+#ifndef quantlib_mapped_file_hpp
+#define quantlib_mapped_file_hpp
+
+#include <cstddef>
+#include <string>
+
+namespace QuantLib {
+
+    //! read-only memory mapping of a whole file
+    /*! The contents are mapped as shared, so that processes mapping
+        the same file share a single copy in the page cache.  The
+        mapping is released on destruction.
+    */
+    class MappedFile {
+      public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        //! \name Inspectors
+        //@{
+        const std::string& path() const { return path_; }
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        //@}
+      private:
+        std::string path_;
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+        #if defined(_WIN32)
+        void* mapping_ = nullptr;
+        #endif
+    };
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <ql/time/schedule.hpp>
 #include <ql/time/imm.hpp>
 #include "ql_settings.hpp"
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -73,360 +74,484 @@ namespace QuantLib {
                    "isRegular size ({}) must be zero or equal to the number of dates minus 1 ({})"
             , isRegular_.size() , dates.size() - 1 );
     }
-    template <class ExtDate> inline
-    Schedule<ExtDate>::Schedule(ExtDate effectiveDate,
-                       const ExtDate& terminationDate,
-                       const Period& tenor,
-                       const Calendar<ExtDate>& cal,
-                       BusinessDayConvention convention,
-                       BusinessDayConvention terminationDateConvention,
-                       DateGeneration::Rule rule,
-                       bool endOfMonth,
-                       const ExtDate& first,
-                       const ExtDate& nextToLast)
-    : tenor_(tenor), calendar_(cal), convention_(convention),
-      terminationDateConvention_(terminationDateConvention), rule_(rule),
-      endOfMonth_(allowsEndOfMonth(tenor) ? endOfMonth : false),
-      firstDate_(to_DateLike(first)==effectiveDate ? ExtDate() : first),
-      nextToLastDate_(to_DateLike(nextToLast)==terminationDate ? ExtDate() : nextToLast)
-    {
-        // sanity checks
-        QL_REQUIRE(to_DateLike(terminationDate) != ExtDate(), "null termination date");
 
-        // in many cases (e.g. non-expired bonds) the effective date is not
-        // really necessary. In these cases a decent placeholder is enough
-        if (to_DateLike(effectiveDate)==ExtDate() && to_DateLike(first)==ExtDate()
-                                  && rule==DateGeneration::Backward) {
+    namespace detail {
+
+        // placeholder used when the effective date is not provided
+        template <class ExtDate> inline
+        ExtDate placeholderEffectiveDate(const ExtDate& terminationDate,
+                                         const ExtDate& nextToLast) {
             ExtDate evalDate = Settings<ExtDate>::instance().evaluationDate();
             QL_REQUIRE(to_DateLike(evalDate) < terminationDate, "null effective date");
             Natural y;
-            if (to_DateLike(nextToLast) != ExtDate()) {
+            if (to_DateLike(nextToLast) != nullDate<ExtDate>()) {
                 y = (to_DateLike(nextToLast) - to_DateLike(evalDate))/366 + 1;
-                effectiveDate = to_DateLike(nextToLast) - y*Years;
+                return to_DateLike(nextToLast) - y*Years;
             } else {
                 y = (to_DateLike(terminationDate) - to_DateLike(evalDate))/366 + 1;
-                effectiveDate = to_DateLike(terminationDate) - y*Years;
+                return to_DateLike(terminationDate) - y*Years;
             }
-        } else
-            QL_REQUIRE(to_DateLike(effectiveDate) != ExtDate(), "null effective date");
-
-        QL_REQUIRE(to_DateLike(effectiveDate) < terminationDate,
-                   "effective date ({}) later than or equal to termination date ({})" , effectiveDate , terminationDate );
-
-        if (tenor.length()==0)
-            rule_ = DateGeneration::Zero;
-        else
-            QL_REQUIRE(tenor.length()>0,
-                       "non positive tenor ({}) not allowed", tenor);
+        }
 
-        if (to_DateLike(firstDate_) != ExtDate()) {
-            switch (*rule_) {
-              case DateGeneration::Backward:
-              case DateGeneration::Forward:
-                QL_REQUIRE(to_DateLike(firstDate_) > effectiveDate &&
-                           to_DateLike(firstDate_) <= terminationDate,
-                           "first date () out of effective-termination date range [{},{}]" , firstDate_ , effectiveDate , terminationDate );
-                // we should ensure that the above condition is still
-                // verified after adjustment
-                break;
-              case DateGeneration::ThirdWednesday:
-                  QL_REQUIRE(IMM<ExtDate>::isIMMdate(firstDate_, false),
-                             "first date ({}) is not an IMM date", firstDate_ );
-                break;
-              case DateGeneration::Zero:
-              case DateGeneration::Twentieth:
-              case DateGeneration::TwentiethIMM:
-              case DateGeneration::OldCDS:
-              case DateGeneration::CDS:
-              case DateGeneration::CDS2015:
-                QL_FAIL("first date incompatible with {} date generation rule",*rule_);
-              default:
-                QL_FAIL("unknown rule ({})",*rule_);
+        /* Rule-based generation into dates[0,capacity) and
+           isRegular[0,capacity-1); returns the number of dates.
+           Flags only needs element assignment, so that both
+           std::span<bool> and std::vector<bool> can be filled. */
+        template <class ExtDate, class Flags> inline
+        Size generateSchedule(ExtDate* dates,
+                              Flags& isRegular,
+                              Size capacity,
+                              ExtDate effectiveDate,
+                              const ExtDate& terminationDate,
+                              Period tenor,
+                              const Calendar<ExtDate>& calendar,
+                              BusinessDayConvention convention,
+                              BusinessDayConvention terminationDateConvention,
+                              DateGeneration::Rule rule,
+                              bool endOfMonth,
+                              const ExtDate& first,
+                              const ExtDate& nextToLast) {
+            endOfMonth = allowsEndOfMonth(tenor) ? endOfMonth : false;
+            const ExtDate firstDate =
+                to_DateLike(first)==effectiveDate ? nullDate<ExtDate>() : first;
+            const ExtDate nextToLastDate =
+                to_DateLike(nextToLast)==terminationDate ? nullDate<ExtDate>() : nextToLast;
+
+            // sanity checks
+            QL_REQUIRE(to_DateLike(terminationDate) != nullDate<ExtDate>(), "null termination date");
+
+            // in many cases (e.g. non-expired bonds) the effective date is not
+            // really necessary. In these cases a decent placeholder is enough
+            if (to_DateLike(effectiveDate)==nullDate<ExtDate>() && to_DateLike(first)==nullDate<ExtDate>()
+                                      && rule==DateGeneration::Backward) {
+                effectiveDate = placeholderEffectiveDate(terminationDate, nextToLast);
+            } else
+                QL_REQUIRE(to_DateLike(effectiveDate) != nullDate<ExtDate>(), "null effective date");
+
+            QL_REQUIRE(to_DateLike(effectiveDate) < terminationDate,
+                       "effective date ({}) later than or equal to termination date ({})" , effectiveDate , terminationDate );
+
+            if (tenor.length()==0)
+                rule = DateGeneration::Zero;
+            else
+                QL_REQUIRE(tenor.length()>0,
+                           "non positive tenor ({}) not allowed", tenor);
+
+            if (to_DateLike(firstDate) != nullDate<ExtDate>()) {
+                switch (rule) {
+                  case DateGeneration::Backward:
+                  case DateGeneration::Forward:
+                    QL_REQUIRE(to_DateLike(firstDate) > effectiveDate &&
+                               to_DateLike(firstDate) <= terminationDate,
+                               "first date () out of effective-termination date range [{},{}]" , firstDate , effectiveDate , terminationDate );
+                    // we should ensure that the above condition is still
+                    // verified after adjustment
+                    break;
+                  case DateGeneration::ThirdWednesday:
+                      QL_REQUIRE(IMM<ExtDate>::isIMMdate(firstDate, false),
+                                 "first date ({}) is not an IMM date", firstDate );
+                    break;
+                  case DateGeneration::Zero:
+                  case DateGeneration::Twentieth:
+                  case DateGeneration::TwentiethIMM:
+                  case DateGeneration::OldCDS:
+                  case DateGeneration::CDS:
+                  case DateGeneration::CDS2015:
+                    QL_FAIL("first date incompatible with {} date generation rule",rule);
+                  default:
+                    QL_FAIL("unknown rule ({})",rule);
+                }
             }
-        }
-        if (to_DateLike(nextToLastDate_) != ExtDate()) {
-            switch (*rule_) {
-              case DateGeneration::Backward:
-              case DateGeneration::Forward:
-                QL_REQUIRE(to_DateLike(nextToLastDate_) >= effectiveDate &&
-                           to_DateLike(nextToLastDate_) < terminationDate,
-                           "next to last date ({}) out of effective-termination date range [{},{}]" , nextToLastDate_ , effectiveDate , terminationDate );
-                // we should ensure that the above condition is still
-                // verified after adjustment
-                break;
-              case DateGeneration::ThirdWednesday:
-                QL_REQUIRE(IMM<ExtDate>::isIMMdate(nextToLastDate_, false),
-                           "next-to-last date ({}) is not an IMM date", nextToLastDate_ );
-                break;
-              case DateGeneration::Zero:
-              case DateGeneration::Twentieth:
-              case DateGeneration::TwentiethIMM:
-              case DateGeneration::OldCDS:
-              case DateGeneration::CDS:
-              case DateGeneration::CDS2015:
-                QL_FAIL("next to last date incompatible with {} date generation rule",*rule_);
-              default:
-                  QL_FAIL("unknown rule ({})", *rule_);
+            if (to_DateLike(nextToLastDate) != nullDate<ExtDate>()) {
+                switch (rule) {
+                  case DateGeneration::Backward:
+                  case DateGeneration::Forward:
+                    QL_REQUIRE(to_DateLike(nextToLastDate) >= effectiveDate &&
+                               to_DateLike(nextToLastDate) < terminationDate,
+                               "next to last date ({}) out of effective-termination date range [{},{}]" , nextToLastDate , effectiveDate , terminationDate );
+                    // we should ensure that the above condition is still
+                    // verified after adjustment
+                    break;
+                  case DateGeneration::ThirdWednesday:
+                    QL_REQUIRE(IMM<ExtDate>::isIMMdate(nextToLastDate, false),
+                               "next-to-last date ({}) is not an IMM date", nextToLastDate );
+                    break;
+                  case DateGeneration::Zero:
+                  case DateGeneration::Twentieth:
+                  case DateGeneration::TwentiethIMM:
+                  case DateGeneration::OldCDS:
+                  case DateGeneration::CDS:
+                  case DateGeneration::CDS2015:
+                    QL_FAIL("next to last date incompatible with {} date generation rule",rule);
+                  default:
+                      QL_FAIL("unknown rule ({})", rule);
+                }
             }
-        }
 
+            // dates are appended, together with the regularity of the
+            // period they close; backward generation appends them in
+            // reverse order and flips the storage at the end.
+            Size n = 0;
+            auto append = [&](const ExtDate& d, bool regular) {
+                QL_REQUIRE(n < capacity,
+                           "schedule storage too small ({} dates)", capacity);
+                if (n > 0)
+                    isRegular[n-1] = regular;
+                dates[n++] = d;
+            };
+
+            // calendar needed for endOfMonth adjustment; built once,
+            // so that generation doesn't allocate
+            static const Calendar<ExtDate> nullCalendar = NullCalendar<ExtDate>();
+            Integer periods = 1;
+            ExtDate seed, exitDate;
+            switch (rule) {
 
-        // calendar needed for endOfMonth adjustment
-        Calendar<ExtDate> nullCalendar = NullCalendar<ExtDate>();
-        Integer periods = 1;
-        ExtDate seed, exitDate;
-        switch (*rule_) {
-
-          case DateGeneration::Zero:
-            tenor_ = 0*Years;
-            dates_.push_back(effectiveDate);
-            dates_.push_back(terminationDate);
-            isRegular_.push_back(true);
-            break;
+              case DateGeneration::Zero:
+                append(effectiveDate, true);
+                append(terminationDate, true);
+                break;
 
-          case DateGeneration::Backward:
+              case DateGeneration::Backward:
 
-            dates_.push_back(terminationDate);
+                append(terminationDate, true);
 
-            seed = terminationDate;
-            if (to_DateLike(nextToLastDate_) != ExtDate()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
-                ExtDate temp = nullCalendar.advance(seed,
-                    -periods*(*tenor_), convention, *endOfMonth_);
-                if (to_DateLike(temp)!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
-                else
-                    isRegular_.insert(isRegular_.begin(), true);
-                seed = nextToLastDate_;
-            }
+                seed = terminationDate;
+                if (to_DateLike(nextToLastDate) != nullDate<ExtDate>()) {
+                    ExtDate temp = nullCalendar.advance(seed,
+                        -periods*tenor, convention, endOfMonth);
+                    append(nextToLastDate, to_DateLike(temp)==nextToLastDate);
+                    seed = nextToLastDate;
+                }
 
-            exitDate = effectiveDate;
-            if (to_DateLike(firstDate_) != ExtDate())
-                exitDate = firstDate_;
-
-            for (;;) {
-                ExtDate temp = nullCalendar.advance(seed,
-                    -periods*(*tenor_), convention, *endOfMonth_);
-                if (to_DateLike(temp) < exitDate) {
-                    if (to_DateLike(firstDate_) != ExtDate() &&
-                        (to_DateLike(calendar_.adjust(dates_.front(),convention))!=
-                         calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
-                    }
-                    break;
-                } else {
-                    // skip dates that would result in duplicates
-                    // after adjustment
-                    if (to_DateLike(calendar_.adjust(dates_.front(),convention))!=
-                        calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                exitDate = effectiveDate;
+                if (to_DateLike(firstDate) != nullDate<ExtDate>())
+                    exitDate = firstDate;
+
+                for (;;) {
+                    ExtDate temp = nullCalendar.advance(seed,
+                        -periods*tenor, convention, endOfMonth);
+                    if (to_DateLike(temp) < exitDate) {
+                        if (to_DateLike(firstDate) != nullDate<ExtDate>() &&
+                            (to_DateLike(calendar.adjust(dates[n-1],convention))!=
+                             calendar.adjust(firstDate,convention))) {
+                            append(firstDate, false);
+                        }
+                        break;
+                    } else {
+                        // skip dates that would result in duplicates
+                        // after adjustment
+                        if (to_DateLike(calendar.adjust(dates[n-1],convention))!=
+                            calendar.adjust(temp,convention)) {
+                            append(temp, true);
+                        }
+                        ++periods;
                     }
-                    ++periods;
                 }
-            }
 
-            if (to_DateLike(calendar_.adjust(dates_.front(),convention))!=
-                calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
-            }
-            break;
+                if (to_DateLike(calendar.adjust(dates[n-1],convention))!=
+                    calendar.adjust(effectiveDate,convention)) {
+                    append(effectiveDate, false);
+                }
 
-          case DateGeneration::Twentieth:
-          case DateGeneration::TwentiethIMM:
-          case DateGeneration::ThirdWednesday:
-          case DateGeneration::OldCDS:
-          case DateGeneration::CDS:
-          case DateGeneration::CDS2015:
-            QL_REQUIRE(!*endOfMonth_,
-                         "endOfMonth convention incompatible with {} date generation rule", *rule_);
-          // fall through
-          case DateGeneration::Forward:
-
-            if (*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015) {
-                ExtDate prev20th = previousTwentieth(effectiveDate, *rule_);
-                if (to_DateLike(calendar_.adjust(prev20th, convention)) > effectiveDate) {
-                    dates_.push_back(to_DateLike(prev20th) - 3 * Months);
-                    isRegular_.push_back(true);
+                std::reverse(dates, dates+n);
+                for (Size i=0; i+1 < n-1-i; ++i) {
+                    bool regular = isRegular[i];
+                    isRegular[i] = bool(isRegular[n-2-i]);
+                    isRegular[n-2-i] = regular;
                 }
-                dates_.push_back(prev20th);
-            } else {
-                dates_.push_back(effectiveDate);
-            }
+                break;
 
-            seed = dates_.back();
-
-            if (to_DateLike(firstDate_)!=ExtDate()) {
-                dates_.push_back(firstDate_);
-                ExtDate temp = nullCalendar.advance(seed, periods*(*tenor_),
-                                                 convention, *endOfMonth_);
-                if (to_DateLike(temp)!=firstDate_)
-                    isRegular_.push_back(false);
-                else
-                    isRegular_.push_back(true);
-                seed = firstDate_;
-            } else if (*rule_ == DateGeneration::Twentieth ||
-                       *rule_ == DateGeneration::TwentiethIMM ||
-                       *rule_ == DateGeneration::OldCDS ||
-                       *rule_ == DateGeneration::CDS ||
-                       *rule_ == DateGeneration::CDS2015) {
-                ExtDate next20th = nextTwentieth(effectiveDate, *rule_);
-                if (*rule_ == DateGeneration::OldCDS) {
-                    // distance rule inforced in natural days
-                    static const serial_type stubDays = 30;
-                    if (to_DateLike(next20th) - to_DateLike(effectiveDate) < stubDays) {
-                        // +1 will skip this one and get the next
-                        next20th = nextTwentieth((to_DateLike(next20th) + 1).asExtDate(), *rule_);
+              case DateGeneration::Twentieth:
+              case DateGeneration::TwentiethIMM:
+              case DateGeneration::ThirdWednesday:
+              case DateGeneration::OldCDS:
+              case DateGeneration::CDS:
+              case DateGeneration::CDS2015:
+                QL_REQUIRE(!endOfMonth,
+                             "endOfMonth convention incompatible with {} date generation rule", rule);
+              // fall through
+              case DateGeneration::Forward:
+
+                if (rule == DateGeneration::CDS || rule == DateGeneration::CDS2015) {
+                    ExtDate prev20th = previousTwentieth(effectiveDate, rule);
+                    if (to_DateLike(calendar.adjust(prev20th, convention)) > effectiveDate) {
+                        append(to_DateLike(prev20th) - 3 * Months, true);
                     }
+                    append(prev20th, true);
+                } else {
+                    append(effectiveDate, true);
                 }
-                if (to_DateLike(next20th) != effectiveDate) {
-                    dates_.push_back(next20th);
-                    isRegular_.push_back(*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015);
-                    seed = next20th;
-                }
-            }
 
-            exitDate = terminationDate;
-            if (to_DateLike(nextToLastDate_) != ExtDate())
-                exitDate = nextToLastDate_;
-            for (;;) {
-                ExtDate temp = nullCalendar.advance(seed, periods*(*tenor_),
-                                                 convention, *endOfMonth_);
-                if (to_DateLike(temp) > exitDate) {
-                    if (to_DateLike(nextToLastDate_) != ExtDate() &&
-                        (to_DateLike(calendar_.adjust(dates_.back(),convention))!=
-                         calendar_.adjust(nextToLastDate_,convention))) {
-                        dates_.push_back(nextToLastDate_);
-                        isRegular_.push_back(false);
+                seed = dates[n-1];
+
+                if (to_DateLike(firstDate)!=nullDate<ExtDate>()) {
+                    ExtDate temp = nullCalendar.advance(seed, periods*tenor,
+                                                     convention, endOfMonth);
+                    append(firstDate, to_DateLike(temp)==firstDate);
+                    seed = firstDate;
+                } else if (rule == DateGeneration::Twentieth ||
+                           rule == DateGeneration::TwentiethIMM ||
+                           rule == DateGeneration::OldCDS ||
+                           rule == DateGeneration::CDS ||
+                           rule == DateGeneration::CDS2015) {
+                    ExtDate next20th = nextTwentieth(effectiveDate, rule);
+                    if (rule == DateGeneration::OldCDS) {
+                        // distance rule inforced in natural days
+                        static const serial_type stubDays = 30;
+                        if (to_DateLike(next20th) - to_DateLike(effectiveDate) < stubDays) {
+                            // +1 will skip this one and get the next
+                            next20th = nextTwentieth((to_DateLike(next20th) + 1).asExtDate(), rule);
+                        }
                     }
-                    break;
-                } else {
-                    // skip dates that would result in duplicates
-                    // after adjustment
-                    if (to_DateLike(calendar_.adjust(dates_.back(),convention))!=
-                        calendar_.adjust(temp,convention)) {
-                        dates_.push_back(temp);
-                        isRegular_.push_back(true);
+                    if (to_DateLike(next20th) != effectiveDate) {
+                        append(next20th, rule == DateGeneration::CDS || rule == DateGeneration::CDS2015);
+                        seed = next20th;
                     }
-                    ++periods;
                 }
-            }
 
-            if (to_DateLike(calendar_.adjust(dates_.back(),terminationDateConvention))!=
-                calendar_.adjust(terminationDate,terminationDateConvention)) {
-                if (*rule_ == DateGeneration::Twentieth ||
-                    *rule_ == DateGeneration::TwentiethIMM ||
-                    *rule_ == DateGeneration::OldCDS ||
-                    *rule_ == DateGeneration::CDS ||
-                    *rule_ == DateGeneration::CDS2015) {
-                    dates_.push_back(nextTwentieth(terminationDate, *rule_));
-                    isRegular_.push_back(true);
-                } else {
-                    dates_.push_back(terminationDate);
-                    isRegular_.push_back(false);
+                exitDate = terminationDate;
+                if (to_DateLike(nextToLastDate) != nullDate<ExtDate>())
+                    exitDate = nextToLastDate;
+                for (;;) {
+                    ExtDate temp = nullCalendar.advance(seed, periods*tenor,
+                                                     convention, endOfMonth);
+                    if (to_DateLike(temp) > exitDate) {
+                        if (to_DateLike(nextToLastDate) != nullDate<ExtDate>() &&
+                            (to_DateLike(calendar.adjust(dates[n-1],convention))!=
+                             calendar.adjust(nextToLastDate,convention))) {
+                            append(nextToLastDate, false);
+                        }
+                        break;
+                    } else {
+                        // skip dates that would result in duplicates
+                        // after adjustment
+                        if (to_DateLike(calendar.adjust(dates[n-1],convention))!=
+                            calendar.adjust(temp,convention)) {
+                            append(temp, true);
+                        }
+                        ++periods;
+                    }
                 }
-            }
 
-            break;
+                if (to_DateLike(calendar.adjust(dates[n-1],terminationDateConvention))!=
+                    calendar.adjust(terminationDate,terminationDateConvention)) {
+                    if (rule == DateGeneration::Twentieth ||
+                        rule == DateGeneration::TwentiethIMM ||
+                        rule == DateGeneration::OldCDS ||
+                        rule == DateGeneration::CDS ||
+                        rule == DateGeneration::CDS2015) {
+                        append(nextTwentieth(terminationDate, rule), true);
+                    } else {
+                        append(terminationDate, false);
+                    }
+                }
 
-          default:
-              QL_FAIL("unknown rule ({})", Integer(*rule_));
-        }
+                break;
 
-        // adjustments
-        if (*rule_==DateGeneration::ThirdWednesday)
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = DateLike<ExtDate>::nthWeekday(3, Wednesday,
-                                             to_DateLike(dates_[i]).month(),
-                                             to_DateLike(dates_[i]).year());
-
-        if (*endOfMonth_ && calendar_.isEndOfMonth(seed)) {
-            // adjust to end of month
-            if (convention == Unadjusted) {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = DateLike<ExtDate>::endOfMonth(to_DateLike(dates_[i]));
-            } else {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = calendar_.endOfMonth(dates_[i]);
+              default:
+                  QL_FAIL("unknown rule ({})", Integer(rule));
             }
-            ExtDate d1 = dates_.front(), d2 = dates_.back();
-            if (terminationDateConvention != Unadjusted) {
-                d1 = calendar_.endOfMonth(dates_.front());
-                d2 = calendar_.endOfMonth(dates_.back());
+
+            // adjustments
+            if (rule==DateGeneration::ThirdWednesday)
+                for (Size i=1; i<n-1; ++i)
+                    dates[i] = DateLike<ExtDate>::nthWeekday(3, Wednesday,
+                                                 to_DateLike(dates[i]).month(),
+                                                 to_DateLike(dates[i]).year());
+
+            if (endOfMonth && calendar.isEndOfMonth(seed)) {
+                // adjust to end of month
+                if (convention == Unadjusted) {
+                    for (Size i=1; i<n-1; ++i)
+                        dates[i] = DateLike<ExtDate>::endOfMonth(to_DateLike(dates[i]));
+                } else {
+                    for (Size i=1; i<n-1; ++i)
+                        dates[i] = calendar.endOfMonth(dates[i]);
+                }
+                ExtDate d1 = dates[0], d2 = dates[n-1];
+                if (terminationDateConvention != Unadjusted) {
+                    d1 = calendar.endOfMonth(dates[0]);
+                    d2 = calendar.endOfMonth(dates[n-1]);
+                } else {
+                    // the termination date is the first if going backwards,
+                    // the last otherwise.
+                    if (rule == DateGeneration::Backward)
+                        d2 = DateLike<ExtDate>::endOfMonth(to_DateLike(dates[n-1]));
+                    else
+                        d1 = DateLike<ExtDate>::endOfMonth(to_DateLike(dates[0]));
+                }
+                // if the eom adjustment leads to a single date schedule
+                // we do not apply it
+                if(to_DateLike(d1) != d2) {
+                    dates[0] = d1;
+                    dates[n-1] = d2;
+                }
             } else {
-                // the termination date is the first if going backwards,
-                // the last otherwise.
-                if (*rule_ == DateGeneration::Backward)
-                    d2 = DateLike<ExtDate>::endOfMonth(to_DateLike(dates_.back()));
-                else
-                    d1 = DateLike<ExtDate>::endOfMonth(to_DateLike(dates_.front()));
+                // first date not adjusted for old CDS schedules
+                if (rule != DateGeneration::OldCDS)
+                    dates[0] = calendar.adjust(dates[0], convention);
+                for (Size i=1; i<n-1; ++i)
+                    dates[i] = calendar.adjust(dates[i], convention);
+
+                // termination date is NOT adjusted as per ISDA
+                // specifications, unless otherwise specified in the
+                // confirmation of the deal or unless we're creating a CDS
+                // schedule
+                if (terminationDateConvention != Unadjusted
+                    && rule != DateGeneration::CDS
+                    && rule != DateGeneration::CDS2015) {
+                    dates[n-1] = calendar.adjust(dates[n-1],
+                                                 terminationDateConvention);
+                }
             }
-            // if the eom adjustment leads to a single date schedule
-            // we do not apply it
-            if(to_DateLike(d1) != d2) {
-                dates_.front() = d1;
-                dates_.back() = d2;
+
+            // Final safety checks to remove extra next-to-last date, if
+            // necessary.  It can happen to be equal or later than the end
+            // date due to EOM adjustments (see the Schedule test suite
+            // for an example).
+            if (n >= 2 && to_DateLike(dates[n-2]) >= dates[n-1]) {
+                // there might be two dates only, then isRegular has size one
+                if (n >= 3) {
+                    isRegular[n-3] = (to_DateLike(dates[n-2]) == dates[n-1]);
+                }
+                dates[n-2] = dates[n-1];
+                --n;
             }
-        } else {
-            // first date not adjusted for old CDS schedules
-            if (*rule_ != DateGeneration::OldCDS)
-                dates_[0] = calendar_.adjust(dates_[0], convention);
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = calendar_.adjust(dates_[i], convention);
-
-            // termination date is NOT adjusted as per ISDA
-            // specifications, unless otherwise specified in the
-            // confirmation of the deal or unless we're creating a CDS
-            // schedule
-            if (terminationDateConvention != Unadjusted
-                && *rule_ != DateGeneration::CDS
-                && *rule_ != DateGeneration::CDS2015) {
-                dates_.back() = calendar_.adjust(dates_.back(),
-                                                 terminationDateConvention);
+            if (n >= 2 && to_DateLike(dates[1]) <= dates[0]) {
+                if (n >= 3)
+                    isRegular[1] = (to_DateLike(dates[1]) == dates[0]);
+                dates[1] = dates[0];
+                for (Size i=0; i<n-1; ++i)
+                    dates[i] = dates[i+1];
+                for (Size i=0; i+2<n; ++i)
+                    isRegular[i] = bool(isRegular[i+1]);
+                --n;
             }
+
+            QL_ENSURE(n>1,
+                "degenerate single date ({}) schedule"
+                "\n seed date: {}"
+                "\n exit date: {}"
+                "\n effective date: {}"
+                "\n first date: {}"
+                "\n next to last date: {}"
+                "\n termination date: {}"
+                "\n generation rule: {} end of month: " , dates[0]  ,seed,
+                      exitDate,
+                      effectiveDate,
+                      first,
+                      nextToLast,
+                      terminationDate,
+                      rule,
+                      endOfMonth);
+
+            return n;
         }
 
-        // Final safety checks to remove extra next-to-last date, if
-        // necessary.  It can happen to be equal or later than the end
-        // date due to EOM adjustments (see the Schedule test suite
-        // for an example).
-        if (dates_.size() >= 2 && to_DateLike(dates_[dates_.size()-2]) >= dates_.back()) {
-            // there might be two dates only, then isRegular_ has size one
-            if (isRegular_.size() >= 2) {
-                isRegular_[isRegular_.size() - 2] =
-                    (to_DateLike(dates_[dates_.size() - 2]) == dates_.back());
-            }
-            dates_[dates_.size() - 2] = dates_.back();
-            dates_.pop_back();
-            isRegular_.pop_back();
+    }
+
+    template <class ExtDate> inline
+    Size maxScheduleSize(const ExtDate& effectiveDate,
+                         const ExtDate& terminationDate,
+                         const Period& tenor,
+                         DateGeneration::Rule rule,
+                         const ExtDate& firstDate,
+                         const ExtDate& nextToLastDate) {
+        QL_REQUIRE(to_DateLike(terminationDate) != nullDate<ExtDate>(), "null termination date");
+        if (rule == DateGeneration::Zero || tenor.length() <= 0)
+            return 2;
+
+        ExtDate start = effectiveDate;
+        if (to_DateLike(start) == nullDate<ExtDate>()) {
+            // invalid parameters are reported by the generation
+            if (to_DateLike(firstDate) != nullDate<ExtDate>() || rule != DateGeneration::Backward)
+                return 2;
+            start = detail::placeholderEffectiveDate(terminationDate, nextToLastDate);
         }
-        if (dates_.size() >= 2 && to_DateLike(dates_[1]) <= dates_.front()) {
-            isRegular_[1] =
-                (to_DateLike(dates_[1]) == dates_.front());
-            dates_[1] = dates_.front();
-            dates_.erase(dates_.begin());
-            isRegular_.erase(isRegular_.begin());
+        const DateLike<ExtDate>& d1 = to_DateLike(start);
+        const DateLike<ExtDate>& d2 = to_DateLike(terminationDate);
+        if (d2 <= d1)
+            return 2;
+
+        Size periods;
+        switch (tenor.units()) {
+          case Days:
+            periods = (d2 - d1) / tenor.length();
+            break;
+          case Weeks:
+            periods = (d2 - d1) / (7 * tenor.length());
+            break;
+          case Months:
+          case Years: {
+              Integer months = (d2.year() - d1.year()) * 12 + (d2.month() - d1.month()) + 1;
+              // CDS schedules can start two quarters before the effective date
+              if (rule == DateGeneration::CDS || rule == DateGeneration::CDS2015)
+                  months += 6;
+              periods = months / (tenor.units() == Years ? 12 * tenor.length() : tenor.length());
+              break;
+          }
+          default:
+            QL_FAIL("unknown time unit ({})", Integer(tenor.units()));
         }
+        // regular dates, plus effective, first, next-to-last and
+        // termination dates and a possible extra stub
+        return periods + 6;
+    }
 
-        QL_ENSURE(dates_.size()>1,
-            "degenerate single date ({}) schedule" 
-            "\n seed date: {}"
-            "\n exit date: {}"
-            "\n effective date: {}"
-            "\n first date: {}"
-            "\n next to last date: {}"
-            "\n termination date: {}"
-            "\n generation rule: {} end of month: " , dates_[0]  ,seed,
-                  exitDate,
-                  effectiveDate,
-                  first,
-                  nextToLast,
-                  terminationDate,
-                  *rule_,
-                  *endOfMonth_);
+    template <class ExtDate> inline
+    Size generateSchedule(std::span<ExtDate> dates,
+                          std::span<bool> isRegular,
+                          const ExtDate& effectiveDate,
+                          const ExtDate& terminationDate,
+                          const Period& tenor,
+                          const Calendar<ExtDate>& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const ExtDate& firstDate,
+                          const ExtDate& nextToLastDate) {
+        QL_REQUIRE(!dates.empty() && isRegular.size() + 1 >= dates.size(),
+                   "isRegular size ({}) must be at least the number of dates minus 1 ({})",
+                   isRegular.size(), dates.size() - 1);
+        return detail::generateSchedule(dates.data(), isRegular, dates.size(),
+                                        effectiveDate, terminationDate, tenor, calendar,
+                                        convention, terminationDateConvention, rule,
+                                        endOfMonth, firstDate, nextToLastDate);
+    }
+
+    template <class ExtDate> inline
+    Schedule<ExtDate>::Schedule(ExtDate effectiveDate,
+                       const ExtDate& terminationDate,
+                       const Period& tenor,
+                       const Calendar<ExtDate>& cal,
+                       BusinessDayConvention convention,
+                       BusinessDayConvention terminationDateConvention,
+                       DateGeneration::Rule rule,
+                       bool endOfMonth,
+                       const ExtDate& first,
+                       const ExtDate& nextToLast)
+    : tenor_(tenor), calendar_(cal), convention_(convention),
+      terminationDateConvention_(terminationDateConvention), rule_(rule),
+      endOfMonth_(allowsEndOfMonth(tenor) ? endOfMonth : false),
+      firstDate_(to_DateLike(first)==effectiveDate ? nullDate<ExtDate>() : first),
+      nextToLastDate_(to_DateLike(nextToLast)==terminationDate ? nullDate<ExtDate>() : nextToLast)
+    {
+        dates_.resize(maxScheduleSize(effectiveDate, terminationDate, tenor,
+                                      rule, first, nextToLast));
+        isRegular_.resize(dates_.size() - 1);
+        Size n = detail::generateSchedule(dates_.data(), isRegular_, dates_.size(),
+                                          effectiveDate, terminationDate, tenor, cal,
+                                          convention, terminationDateConvention, rule,
+                                          endOfMonth, first, nextToLast);
+        dates_.resize(n);
+        isRegular_.resize(n - 1);
 
+        if (tenor.length()==0)
+            rule_ = DateGeneration::Zero;
+        if (*rule_ == DateGeneration::Zero)
+            tenor_ = 0*Years;
     }
     template <class ExtDate> inline
     Schedule<ExtDate> Schedule<ExtDate>::after(const ExtDate& _truncationDate) const {
@@ -458,9 +583,9 @@ namespace QuantLib {
             }
 
             if (result.nextToLastDate_ <= truncationDate)
-                result.nextToLastDate_ = ExtDate();
+                result.nextToLastDate_ = nullDate<ExtDate>();
             if (result.firstDate_ <= truncationDate)
-                result.firstDate_ = ExtDate();
+                result.firstDate_ = nullDate<ExtDate>();
         }
 
         return result;
@@ -492,9 +617,9 @@ namespace QuantLib {
             }
 
             if (result.nextToLastDate_>=truncationDate)
-                result.nextToLastDate_ = ExtDate();
+                result.nextToLastDate_ = nullDate<ExtDate>();
             if (result.firstDate_>=truncationDate)
-                result.firstDate_ = ExtDate();
+                result.firstDate_ = nullDate<ExtDate>();
         }
 
         return result;
@@ -502,10 +627,10 @@ namespace QuantLib {
     template <class ExtDate> inline
     typename std::vector<ExtDate>::const_iterator
     Schedule<ExtDate>::lower_bound(const ExtDate& refDate) const {
-        ExtDate d = (refDate==ExtDate() ?
+        ExtDate d = (to_DateLike(refDate)==nullDate<ExtDate>() ?
                   Settings<ExtDate>::instance().evaluationDate() :
                   refDate);
-        return std::lower_bound(dates_.begin(), dates_.end(), d);
+        return std::lower_bound(dates_.begin(), dates_.end(), d, Less<ExtDate>());
     }
     template <class ExtDate> inline
     ExtDate Schedule<ExtDate>::nextDate(const ExtDate& refDate) const {
@@ -513,7 +638,7 @@ namespace QuantLib {
         if (res!=dates_.end())
             return *res;
         else
-            return ExtDate();
+            return nullDate<ExtDate>();
     }
     template <class ExtDate> inline
     ExtDate Schedule<ExtDate>::previousDate(const ExtDate& refDate) const {
@@ -521,7 +646,7 @@ namespace QuantLib {
         if (res!=dates_.begin())
             return *(--res);
         else
-            return ExtDate();
+            return nullDate<ExtDate>();
     }
     template <class ExtDate> inline
     bool Schedule<ExtDate>::hasIsRegular() const { return !isRegular_.empty(); }
@@ -608,14 +733,15 @@ namespace QuantLib {
         return *this;
     }
     template <class ExtDate> inline
-    MakeSchedule<ExtDate>::operator Schedule<ExtDate>() const {
+    void MakeSchedule<ExtDate>::resolve(Calendar<ExtDate>& calendar,
+                                        BusinessDayConvention& convention,
+                                        BusinessDayConvention& terminationDateConvention) const {
         // check for mandatory arguments
-        QL_REQUIRE(to_DateLike(effectiveDate_) != ExtDate(), "effective date not provided");
-        QL_REQUIRE(to_DateLike(terminationDate_) != ExtDate(), "termination date not provided");
+        QL_REQUIRE(to_DateLike(effectiveDate_) != nullDate<ExtDate>(), "effective date not provided");
+        QL_REQUIRE(to_DateLike(terminationDate_) != nullDate<ExtDate>(), "termination date not provided");
         QL_REQUIRE(tenor_, "tenor/frequency not provided");
 
         // set dynamic defaults:
-        BusinessDayConvention convention;
         // if a convention was set, we use it.
         if (convention_) { // NOLINT(readability-implicit-bool-conversion)
             convention = *convention_;
@@ -629,7 +755,6 @@ namespace QuantLib {
             }
         }
 
-        BusinessDayConvention terminationDateConvention;
         // if set explicitly, we use it;
         if (terminationDateConvention_) { // NOLINT(readability-implicit-bool-conversion)
             terminationDateConvention = *terminationDateConvention_;
@@ -638,13 +763,18 @@ namespace QuantLib {
             terminationDateConvention = convention;
         }
 
-        Calendar<ExtDate> calendar = calendar_;
+        calendar = calendar_;
         // if no calendar was set...
         if (calendar.empty()) {
             // ...we use a null one.
             calendar = NullCalendar<ExtDate>();
         }
-
+    }
+    template <class ExtDate> inline
+    MakeSchedule<ExtDate>::operator Schedule<ExtDate>() const {
+        Calendar<ExtDate> calendar;
+        BusinessDayConvention convention, terminationDateConvention;
+        resolve(calendar, convention, terminationDateConvention);
         return Schedule<ExtDate>(effectiveDate_, terminationDate_, *tenor_, calendar,
                         convention, terminationDateConvention,
                         rule_, endOfMonth_, firstDate_, nextToLastDate_);
@@ -31,10 +31,14 @@
 #include <ql/time/period.hpp>
 #include <ql/time/dategenerationrule.hpp>
 #include "ql_errors.hpp"
+#include <memory>
 #include <optional>
+#include <span>
 
 namespace QuantLib {
 
+    template <class ExtDate> class ScheduleCache;
+
     //! Payment schedule
     /*! \ingroup datetime */
     template <class ExtDate=Date>
@@ -62,8 +66,8 @@ namespace QuantLib {
                  BusinessDayConvention terminationDateConvention,
                  DateGeneration::Rule rule,
                  bool endOfMonth,
-                 const ExtDate& firstDate = ExtDate(),
-                 const ExtDate& nextToLastDate = ExtDate());
+                 const ExtDate& firstDate = nullDate<ExtDate>(),
+                 const ExtDate& nextToLastDate = nullDate<ExtDate>());
         Schedule() {}
         //! \name ExtDate access
         //@{
@@ -99,7 +103,7 @@ namespace QuantLib {
         typedef typename std::vector<ExtDate>::const_iterator const_iterator;
         const_iterator begin() const { return dates_.begin(); }
         const_iterator end() const { return dates_.end(); }
-        const_iterator lower_bound(const ExtDate& d = ExtDate()) const;
+        const_iterator lower_bound(const ExtDate& d = nullDate<ExtDate>()) const;
         //@}
         //! \name Utilities
         //@{
@@ -114,7 +118,7 @@ namespace QuantLib {
         std::optional<BusinessDayConvention> terminationDateConvention_;
         std::optional<DateGeneration::Rule> rule_;
         std::optional<bool> endOfMonth_;
-        ExtDate firstDate_, nextToLastDate_;
+        ExtDate firstDate_ = nullDate<ExtDate>(), nextToLastDate_ = nullDate<ExtDate>();
         std::vector<ExtDate> dates_;
         std::vector<bool> isRegular_;
     };
@@ -142,17 +146,59 @@ namespace QuantLib {
         MakeSchedule& withFirstDate(const ExtDate& d);
         MakeSchedule& withNextToLastDate(const ExtDate& d);
         operator Schedule<ExtDate>() const;
+        //! returns the schedule through the given cache
+        std::shared_ptr<const Schedule<ExtDate> > cached(ScheduleCache<ExtDate>& cache) const;
       private:
+        void resolve(Calendar<ExtDate>& calendar,
+                     BusinessDayConvention& convention,
+                     BusinessDayConvention& terminationDateConvention) const;
         Calendar<ExtDate> calendar_;
-        ExtDate effectiveDate_, terminationDate_;
+        ExtDate effectiveDate_ = nullDate<ExtDate>(), terminationDate_ = nullDate<ExtDate>();
         std::optional<Period> tenor_;
         std::optional<BusinessDayConvention> convention_;
         std::optional<BusinessDayConvention> terminationDateConvention_;
         DateGeneration::Rule rule_;
         bool endOfMonth_;
-        ExtDate firstDate_, nextToLastDate_;
+        ExtDate firstDate_ = nullDate<ExtDate>(), nextToLastDate_ = nullDate<ExtDate>();
     };
 
+    //! upper bound on the number of dates of a rule-based schedule
+    /*! The bound is computed from the tenor and the dates alone, so
+        that storage for generateSchedule() can be reserved up front.
+        Calendar adjustments and stubs can only reduce the actual
+        number of dates.
+    */
+    template <class ExtDate = Date>
+    Size maxScheduleSize(const ExtDate& effectiveDate,
+                         const ExtDate& terminationDate,
+                         const Period& tenor,
+                         DateGeneration::Rule rule,
+                         const ExtDate& firstDate = nullDate<ExtDate>(),
+                         const ExtDate& nextToLastDate = nullDate<ExtDate>());
+
+    //! rule-based schedule generation into caller-provided storage
+    /*! Generates the same dates as the rule-based Schedule
+        constructor without allocating: dates are written at the
+        beginning of \p dates and the regularity of each period at
+        the beginning of \p isRegular.  Returns the number of dates.
+
+        \pre \p dates must hold at least maxScheduleSize() dates,
+             \p isRegular one less.
+    */
+    template <class ExtDate = Date>
+    Size generateSchedule(std::span<ExtDate> dates,
+                          std::span<bool> isRegular,
+                          const ExtDate& effectiveDate,
+                          const ExtDate& terminationDate,
+                          const Period& tenor,
+                          const Calendar<ExtDate>& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const ExtDate& firstDate = nullDate<ExtDate>(),
+                          const ExtDate& nextToLastDate = nullDate<ExtDate>());
+
     /*! Helper function for returning the date on or before date \p d that is the 20th of the month and obeserves the 
         given date generation \p rule if it is relevant.
     */
@@ -234,4 +280,6 @@ namespace QuantLib {
 
 }
 #include "schedule.cpp"
+// for MakeSchedule::cached
+#include "schedulecache.hpp"
 #endif
@@ -0,0 +1,245 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief bounded cache of rule-based schedules
+*/
+#pragma once
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace QuantLib {
+
+    //! bounded cache of rule-based schedules
+    /*! Schedules are generated once for each set of generation
+        parameters and returned as shared immutable instances;
+        repeated requests for the same parameters return the same
+        instance.  When the cache is full, the least recently used
+        schedule is dropped.  The cache can be used concurrently
+        from several threads.
+
+        Calendars are identified by implementation (see
+        Calendar::id()), so that different calendars with the same
+        name don't share schedules; a cached schedule is regenerated
+        if holidays were added to or removed from its calendar, or
+        from the calendars it is built on, since it was generated.
+        Schedules whose effective date depends on the evaluation
+        date (null effective date with the Backward rule) are
+        generated but not cached.
+
+        The hit and miss counters can be used to size the cache;
+        every miss corresponds to a schedule generation.
+
+        \ingroup datetime
+    */
+    template <class ExtDate=Date>
+    class ScheduleCache {
+      public:
+        explicit ScheduleCache(Size capacity = 1024);
+        //! returns the schedule for the given parameters
+        /*! The arguments are the same as for the rule-based
+            Schedule constructor.
+        */
+        std::shared_ptr<const Schedule<ExtDate> > schedule(
+            const ExtDate& effectiveDate,
+            const ExtDate& terminationDate,
+            const Period& tenor,
+            const Calendar<ExtDate>& calendar,
+            BusinessDayConvention convention,
+            BusinessDayConvention terminationDateConvention,
+            DateGeneration::Rule rule,
+            bool endOfMonth,
+            const ExtDate& firstDate = nullDate<ExtDate>(),
+            const ExtDate& nextToLastDate = nullDate<ExtDate>());
+        //! \name Inspectors
+        //@{
+        Size size() const;
+        Size capacity() const;
+        Size hits() const;
+        Size misses() const;
+        //@}
+        //! drops the cached schedules; the counters are kept
+        void clear();
+        //! resets the hit and miss counters
+        void resetCounters();
+      private:
+        typedef std::tuple<serial_type, serial_type, Integer, TimeUnit,
+                           const void*, BusinessDayConvention,
+                           BusinessDayConvention, DateGeneration::Rule,
+                           bool, serial_type, serial_type> Key;
+        struct Entry {
+            std::shared_ptr<const Schedule<ExtDate> > schedule;
+            // tells whether the calendar address in the key was reused
+            std::weak_ptr<const void> calendar;
+            // calendar holiday edits at generation time
+            unsigned long edits;
+            bool matches(const std::weak_ptr<const void>& id,
+                         unsigned long holidayEdits) const {
+                return !calendar.owner_before(id) && !id.owner_before(calendar) &&
+                       edits == holidayEdits;
+            }
+        };
+        typedef std::list<std::pair<Key, Entry> > Entries;
+        Size capacity_;
+        // most recently used first
+        Entries entries_;
+        std::map<Key, typename Entries::iterator> index_;
+        mutable std::mutex mutex_;
+        std::atomic<Size> hits_, misses_;
+    };
+
+
+    // inline definitions
+
+    template <class ExtDate>
+    inline ScheduleCache<ExtDate>::ScheduleCache(Size capacity)
+    : capacity_(capacity), hits_(0), misses_(0) {
+        QL_REQUIRE(capacity > 0, "schedule cache capacity must be positive");
+    }
+
+    template <class ExtDate>
+    inline std::shared_ptr<const Schedule<ExtDate> >
+    ScheduleCache<ExtDate>::schedule(const ExtDate& effectiveDate,
+                                     const ExtDate& terminationDate,
+                                     const Period& tenor,
+                                     const Calendar<ExtDate>& calendar,
+                                     BusinessDayConvention convention,
+                                     BusinessDayConvention terminationDateConvention,
+                                     DateGeneration::Rule rule,
+                                     bool endOfMonth,
+                                     const ExtDate& firstDate,
+                                     const ExtDate& nextToLastDate) {
+        auto generate = [&]() {
+            ++misses_;
+            return std::make_shared<const Schedule<ExtDate> >(
+                effectiveDate, terminationDate, tenor, calendar,
+                convention, terminationDateConvention, rule, endOfMonth,
+                firstDate, nextToLastDate);
+        };
+
+        if (to_DateLike(effectiveDate) == nullDate<ExtDate>() || calendar.empty())
+            return generate();
+
+        std::weak_ptr<const void> id = calendar.id();
+        unsigned long edits = calendar.holidayEdits();
+        Key key(to_DateLike(effectiveDate).serialNumber(),
+                to_DateLike(terminationDate).serialNumber(),
+                tenor.length(), tenor.units(), id.lock().get(),
+                convention, terminationDateConvention, rule, endOfMonth,
+                to_DateLike(firstDate).serialNumber(),
+                to_DateLike(nextToLastDate).serialNumber());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto i = index_.find(key);
+            if (i != index_.end()) {
+                const Entry& entry = i->second->second;
+                if (entry.matches(id, edits)) {
+                    entries_.splice(entries_.begin(), entries_, i->second);
+                    ++hits_;
+                    return entry.schedule;
+                }
+                // stale: the calendar was modified or replaced
+                entries_.erase(i->second);
+                index_.erase(i);
+            }
+        }
+
+        // generate outside the lock, so that misses don't serialize
+        Entry entry{generate(), id, edits};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto i = index_.find(key);
+        if (i != index_.end()) {
+            // another thread got here first; keep its result unless
+            // the calendar was modified in the meantime
+            const Entry& existing = i->second->second;
+            if (existing.matches(id, edits))
+                return existing.schedule;
+            entries_.erase(i->second);
+            index_.erase(i);
+        }
+        entries_.emplace_front(key, entry);
+        index_.emplace(key, entries_.begin());
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        return entry.schedule;
+    }
+
+    template <class ExtDate>
+    inline Size ScheduleCache<ExtDate>::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    template <class ExtDate>
+    inline Size ScheduleCache<ExtDate>::capacity() const {
+        return capacity_;
+    }
+
+    template <class ExtDate>
+    inline Size ScheduleCache<ExtDate>::hits() const {
+        return hits_;
+    }
+
+    template <class ExtDate>
+    inline Size ScheduleCache<ExtDate>::misses() const {
+        return misses_;
+    }
+
+    template <class ExtDate>
+    inline void ScheduleCache<ExtDate>::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        entries_.clear();
+    }
+
+    template <class ExtDate>
+    inline void ScheduleCache<ExtDate>::resetCounters() {
+        hits_ = 0;
+        misses_ = 0;
+    }
+
+    // declared in schedule.hpp; defined here, where the cache is complete
+    template <class ExtDate> inline
+    std::shared_ptr<const Schedule<ExtDate> >
+    MakeSchedule<ExtDate>::cached(ScheduleCache<ExtDate>& cache) const {
+        Calendar<ExtDate> calendar;
+        BusinessDayConvention convention, terminationDateConvention;
+        resolve(calendar, convention, terminationDateConvention);
+        return cache.schedule(effectiveDate_, terminationDate_, *tenor_, calendar,
+                              convention, terminationDateConvention,
+                              rule_, endOfMonth_, firstDate_, nextToLastDate_);
+    }
+
+}
+
+#include "externtemplates.hpp"
+QL_TIME_EXTERN_TEMPLATE(QuantLib::Schedule)
+QL_TIME_EXTERN_TEMPLATE(QuantLib::MakeSchedule)
+QL_TIME_EXTERN_TEMPLATE(QuantLib::ScheduleCache)
+#endif
@@ -0,0 +1,246 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file staticcalendar.hpp
+    \brief calendar with static dispatch over the shipped markets
+*/
+#pragma once
+#ifndef quantlib_static_calendar_hpp
+#define quantlib_static_calendar_hpp
+
+#include <ql/time/calendars/brazil.hpp>
+#include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/china.hpp>
+#include <ql/time/calendars/germany.hpp>
+#include <ql/time/calendars/hongkong.hpp>
+#include <ql/time/calendars/italy.hpp>
+#include <ql/time/calendars/japan.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/russia.hpp>
+#include <ql/time/calendars/southkorea.hpp>
+#include <ql/time/calendars/switzerland.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/thailand.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/weekendsonly.hpp>
+#include <ql/time/period.hpp>
+#include "ql_utilities_dispatch.hpp"
+
+namespace QuantLib {
+
+    //! calendar with static dispatch over the shipped markets
+    /*! This class wraps a Calendar whose implementation is one of
+        the markets shipped in ql/time/calendars, and dispatches the
+        business-day check over that closed set through a
+        std::variant instead of a virtual call.  The rules of the
+        market can thus be inlined into hot loops calling
+        isBusinessDay(), adjust(), advance() or
+        businessDaysBetween().
+
+        Results are the same as for the wrapped calendar: added and
+        removed holidays and materialized business days are shared
+        with it.  Calendars outside the closed set, such as
+        JointCalendar and BespokeCalendar, are rejected by the
+        constructor and should be used through Calendar.
+
+        \ingroup datetime
+    */
+    template <class ExtDate=Date>
+    class StaticCalendar {
+      public:
+        //! \pre the calendar must be one of the shipped markets
+        explicit StaticCalendar(const Calendar<ExtDate>& calendar);
+        //! \name Calendar interface
+        //@{
+        std::string name() const;
+        bool isBusinessDay(const ExtDate& d) const;
+        bool isHoliday(const ExtDate& d) const;
+        bool isWeekend(Weekday w) const;
+        bool isEndOfMonth(const ExtDate& d) const;
+        ExtDate endOfMonth(const ExtDate& d) const;
+        ExtDate adjust(const ExtDate&,
+                       BusinessDayConvention convention = Following) const;
+        ExtDate advance(const ExtDate&,
+                        Integer n,
+                        TimeUnit unit,
+                        BusinessDayConvention convention = Following,
+                        bool endOfMonth = false) const;
+        ExtDate advance(const ExtDate& date,
+                        const Period& period,
+                        BusinessDayConvention convention = Following,
+                        bool endOfMonth = false) const;
+        serial_type businessDaysBetween(const ExtDate& from,
+                                        const ExtDate& to,
+                                        bool includeFirst = true,
+                                        bool includeLast = false) const;
+        //@}
+        //! the wrapped calendar, e.g., for adding or removing holidays
+        const Calendar<ExtDate>& calendar() const;
+      private:
+        using Rules = std::variant<
+            const typename Brazil<ExtDate>::SettlementImpl*,
+            const typename Brazil<ExtDate>::ExchangeImpl*,
+            const typename Canada<ExtDate>::SettlementImpl*,
+            const typename Canada<ExtDate>::TsxImpl*,
+            const typename China<ExtDate>::SseImpl*,
+            const typename China<ExtDate>::IbImpl*,
+            const typename Germany<ExtDate>::SettlementImpl*,
+            const typename Germany<ExtDate>::FrankfurtStockExchangeImpl*,
+            const typename Germany<ExtDate>::XetraImpl*,
+            const typename Germany<ExtDate>::EurexImpl*,
+            const typename Germany<ExtDate>::EuwaxImpl*,
+            const typename HongKong<ExtDate>::HkexImpl*,
+            const typename Italy<ExtDate>::SettlementImpl*,
+            const typename Italy<ExtDate>::ExchangeImpl*,
+            const typename Japan<ExtDate>::Impl*,
+            const typename NullCalendar<ExtDate>::Impl*,
+            const typename Russia<ExtDate>::SettlementImpl*,
+            const typename Russia<ExtDate>::ExchangeImpl*,
+            const typename SouthKorea<ExtDate>::SettlementImpl*,
+            const typename SouthKorea<ExtDate>::KrxImpl*,
+            const typename Switzerland<ExtDate>::Impl*,
+            const typename TARGET<ExtDate>::Impl*,
+            const typename Thailand<ExtDate>::SetImpl*,
+            const typename UnitedKingdom<ExtDate>::SettlementImpl*,
+            const typename UnitedKingdom<ExtDate>::ExchangeImpl*,
+            const typename UnitedKingdom<ExtDate>::MetalsImpl*,
+            const typename UnitedStates<ExtDate>::SettlementImpl*,
+            const typename UnitedStates<ExtDate>::LiborImpactImpl*,
+            const typename UnitedStates<ExtDate>::NyseImpl*,
+            const typename UnitedStates<ExtDate>::GovernmentBondImpl*,
+            const typename UnitedStates<ExtDate>::NercImpl*,
+            const typename UnitedStates<ExtDate>::FederalReserveImpl*,
+            const typename WeekendsOnly<ExtDate>::Impl*>;
+        Calendar<ExtDate> calendar_;
+        const typename Calendar<ExtDate>::Impl* impl_;
+        Rules rules_;
+    };
+
+
+    // inline definitions
+
+    template <class ExtDate>
+    inline StaticCalendar<ExtDate>::StaticCalendar(const Calendar<ExtDate>& calendar)
+    : calendar_(calendar), impl_(calendar.impl_.get()) {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        QL_REQUIRE(detail::exactCast(*impl_, rules_),
+                   "{} calendar not available for static dispatch", impl_->name());
+    }
+
+    template <class ExtDate>
+    inline std::string StaticCalendar<ExtDate>::name() const {
+        return impl_->name();
+    }
+
+    template <class ExtDate>
+    inline bool StaticCalendar<ExtDate>::isBusinessDay(const ExtDate& d) const {
+#ifdef QL_HIGH_RESOLUTION_DATE
+        const ExtDate _d(d.dayOfMonth(), d.month(), d.year());
+#else
+        const ExtDate& _d = d;
+#endif
+
+        // same precedence as Calendar::isBusinessDay
+        const BusinessDayBitmap& materialized = impl_->materialized;
+        if (!materialized.empty()) {
+            serial_type s = to_DateLike(_d).serialNumber();
+            if (materialized.covers(s))
+                return materialized.test(s);
+        }
+
+        if (!impl_->addedHolidays.empty() &&
+            impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
+            return false;
+
+        if (!impl_->removedHolidays.empty() &&
+            impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
+            return true;
+
+        return std::visit([&_d](auto impl) {
+            using Impl = std::remove_const_t<std::remove_pointer_t<decltype(impl)> >;
+            return impl->Impl::isBusinessDay(_d);
+        }, rules_);
+    }
+
+    template <class ExtDate>
+    inline bool StaticCalendar<ExtDate>::isHoliday(const ExtDate& d) const {
+        return !isBusinessDay(d);
+    }
+
+    template <class ExtDate>
+    inline bool StaticCalendar<ExtDate>::isWeekend(Weekday w) const {
+        return std::visit([w](auto impl) {
+            using Impl = std::remove_const_t<std::remove_pointer_t<decltype(impl)> >;
+            return impl->Impl::isWeekend(w);
+        }, rules_);
+    }
+
+    template <class ExtDate>
+    inline bool StaticCalendar<ExtDate>::isEndOfMonth(const ExtDate& d) const {
+        auto dd = to_DateLike(d);
+        return (dd.month() != to_DateLike(adjust(dd+1)).month());
+    }
+
+    template <class ExtDate>
+    inline ExtDate StaticCalendar<ExtDate>::endOfMonth(const ExtDate& d) const {
+        return adjust(DateLike<ExtDate>::endOfMonth(to_DateLike(d)), Preceding);
+    }
+
+    template <class ExtDate>
+    inline ExtDate StaticCalendar<ExtDate>::adjust(const ExtDate& d,
+                                                   BusinessDayConvention c) const {
+        return detail::calendarAdjust(*this, d, c);
+    }
+
+    template <class ExtDate>
+    inline ExtDate StaticCalendar<ExtDate>::advance(const ExtDate& d,
+                                                    Integer n, TimeUnit unit,
+                                                    BusinessDayConvention c,
+                                                    bool endOfMonth) const {
+        return detail::calendarAdvance(*this, impl_->materialized,
+                                       d, n, unit, c, endOfMonth);
+    }
+
+    template <class ExtDate>
+    inline ExtDate StaticCalendar<ExtDate>::advance(const ExtDate& d,
+                                                    const Period& p,
+                                                    BusinessDayConvention c,
+                                                    bool endOfMonth) const {
+        return advance(d, p.length(), p.units(), c, endOfMonth);
+    }
+
+    template <class ExtDate>
+    inline serial_type StaticCalendar<ExtDate>::businessDaysBetween(const ExtDate& from,
+                                                                    const ExtDate& to,
+                                                                    bool includeFirst,
+                                                                    bool includeLast) const {
+        return detail::calendarBusinessDaysBetween(*this, impl_->materialized,
+                                                   from, to,
+                                                   includeFirst, includeLast);
+    }
+
+    template <class ExtDate>
+    inline const Calendar<ExtDate>& StaticCalendar<ExtDate>::calendar() const {
+        return calendar_;
+    }
+
+}
+
+#include "externtemplates.hpp"
+QL_TIME_EXTERN_TEMPLATE(QuantLib::StaticCalendar)
+#endif
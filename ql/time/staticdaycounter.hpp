@@ -0,0 +1,157 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file staticdaycounter.hpp
+    \brief day counter with static dispatch over the shipped conventions
+*/
+#pragma once
+#ifndef quantlib_static_day_counter_hpp
+#define quantlib_static_day_counter_hpp
+
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/business252.hpp>
+#include <ql/time/daycounters/one.hpp>
+#include <ql/time/daycounters/simpledaycounter.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/daycounters/thirty365.hpp>
+#include "ql_utilities_dispatch.hpp"
+
+namespace QuantLib {
+
+    //! day counter with static dispatch over the shipped conventions
+    /*! This class wraps a DayCounter whose implementation is one of
+        the conventions shipped in ql/time/daycounters, and
+        dispatches over that closed set through a std::variant
+        instead of a virtual call, so that the day-count and
+        year-fraction formulas can be inlined into hot loops.
+
+        Results are the same as for the wrapped day counter.  Day
+        counters outside the closed set are rejected by the
+        constructor and should be used through DayCounter.
+
+        \ingroup datetime
+    */
+    template <class ExtDate=Date>
+    class StaticDayCounter {
+      public:
+        //! \pre the day counter must be one of the shipped conventions
+        explicit StaticDayCounter(const DayCounter<ExtDate>& dayCounter);
+        //! \name DayCounter interface
+        //@{
+        std::string name() const;
+        serial_type dayCount(const ExtDate&, const ExtDate&) const;
+        Time yearFraction(const ExtDate&, const ExtDate&,
+                          const ExtDate& refPeriodStart = nullDate<ExtDate>(),
+                          const ExtDate& refPeriodEnd = nullDate<ExtDate>()) const;
+        void dayCounts(std::span<const ExtDate> d1,
+                       std::span<const ExtDate> d2,
+                       std::span<serial_type> result) const;
+        void yearFractions(std::span<const ExtDate> d1,
+                           std::span<const ExtDate> d2,
+                           std::span<Time> result,
+                           std::span<const ExtDate> refPeriodStart = {},
+                           std::span<const ExtDate> refPeriodEnd = {}) const;
+        //@}
+        //! the wrapped day counter
+        const DayCounter<ExtDate>& dayCounter() const;
+      private:
+        using Conventions = std::variant<
+            const typename Actual360<ExtDate>::Impl*,
+            const typename Actual365Fixed<ExtDate>::Impl*,
+            const typename Actual365Fixed<ExtDate>::CA_Impl*,
+            const typename Actual365Fixed<ExtDate>::NL_Impl*,
+            const typename ActualActual<ExtDate>::ISMA_Impl*,
+            const typename ActualActual<ExtDate>::Old_ISMA_Impl*,
+            const typename ActualActual<ExtDate>::ISDA_Impl*,
+            const typename ActualActual<ExtDate>::AFB_Impl*,
+            const typename Business252<ExtDate>::Impl*,
+            const typename OneDayCounter<ExtDate>::Impl*,
+            const typename SimpleDayCounter<ExtDate>::Impl*,
+            const typename Thirty360<ExtDate>::US_Impl*,
+            const typename Thirty360<ExtDate>::EU_Impl*,
+            const typename Thirty360<ExtDate>::IT_Impl*,
+            const typename Thirty360<ExtDate>::GER_Impl*,
+            const typename Thirty365<ExtDate>::Impl*>;
+        DayCounter<ExtDate> dayCounter_;
+        Conventions conventions_;
+    };
+
+
+    // inline definitions
+
+    template <class ExtDate>
+    inline StaticDayCounter<ExtDate>::StaticDayCounter(const DayCounter<ExtDate>& dayCounter)
+    : dayCounter_(dayCounter) {
+        QL_REQUIRE(dayCounter_.impl_, "no day counter implementation provided");
+        QL_REQUIRE(detail::exactCast(*dayCounter_.impl_, conventions_),
+                   "{} day counter not available for static dispatch",
+                   dayCounter_.impl_->name());
+    }
+
+    template <class ExtDate>
+    inline std::string StaticDayCounter<ExtDate>::name() const {
+        return dayCounter_.impl_->name();
+    }
+
+    template <class ExtDate>
+    inline serial_type StaticDayCounter<ExtDate>::dayCount(const ExtDate& d1,
+                                                           const ExtDate& d2) const {
+        return std::visit([&](auto impl) {
+            using Impl = std::remove_const_t<std::remove_pointer_t<decltype(impl)> >;
+            return impl->Impl::dayCount(d1, d2);
+        }, conventions_);
+    }
+
+    template <class ExtDate>
+    inline Time StaticDayCounter<ExtDate>::yearFraction(const ExtDate& d1, const ExtDate& d2,
+                                                        const ExtDate& refPeriodStart,
+                                                        const ExtDate& refPeriodEnd) const {
+        return std::visit([&](auto impl) {
+            using Impl = std::remove_const_t<std::remove_pointer_t<decltype(impl)> >;
+            return impl->Impl::yearFraction(d1, d2, refPeriodStart, refPeriodEnd);
+        }, conventions_);
+    }
+
+    template <class ExtDate>
+    inline void StaticDayCounter<ExtDate>::dayCounts(std::span<const ExtDate> d1,
+                                                     std::span<const ExtDate> d2,
+                                                     std::span<serial_type> result) const {
+        // a single virtual call per batch; sizes are checked there
+        dayCounter_.dayCounts(d1, d2, result);
+    }
+
+    template <class ExtDate>
+    inline void StaticDayCounter<ExtDate>::yearFractions(std::span<const ExtDate> d1,
+                                                         std::span<const ExtDate> d2,
+                                                         std::span<Time> result,
+                                                         std::span<const ExtDate> refPeriodStart,
+                                                         std::span<const ExtDate> refPeriodEnd) const {
+        dayCounter_.yearFractions(d1, d2, result, refPeriodStart, refPeriodEnd);
+    }
+
+    template <class ExtDate>
+    inline const DayCounter<ExtDate>& StaticDayCounter<ExtDate>::dayCounter() const {
+        return dayCounter_;
+    }
+
+}
+
+#include "externtemplates.hpp"
+QL_TIME_EXTERN_TEMPLATE(QuantLib::StaticDayCounter)
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <ql/time/calendar.hpp>
+#include <ql/time/calendars/brazil.hpp>
+#include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/china.hpp>
+#include <ql/time/calendars/germany.hpp>
+#include <ql/time/calendars/hongkong.hpp>
+#include <ql/time/calendars/italy.hpp>
+#include <ql/time/calendars/japan.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/calendars/russia.hpp>
+#include <ql/time/calendars/southkorea.hpp>
+#include <ql/time/calendars/switzerland.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/thailand.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/calendars/weekendsonly.hpp>
+#include <vector>
+
+// the calendars ported to DateLike; shared by the tests and the benchmarks
+template <class ExtDate>
+std::vector<QuantLib::Calendar<ExtDate> > shippedCalendars() {
+    using namespace QuantLib;
+    std::vector<Calendar<ExtDate> > calendars;
+    calendars.push_back(Brazil<ExtDate>(Brazil<ExtDate>::Settlement));
+    calendars.push_back(Brazil<ExtDate>(Brazil<ExtDate>::Exchange));
+    calendars.push_back(Canada<ExtDate>(Canada<ExtDate>::Settlement));
+    calendars.push_back(Canada<ExtDate>(Canada<ExtDate>::TSX));
+    calendars.push_back(China<ExtDate>(China<ExtDate>::SSE));
+    calendars.push_back(China<ExtDate>(China<ExtDate>::IB));
+    calendars.push_back(Germany<ExtDate>(Germany<ExtDate>::Settlement));
+    calendars.push_back(Germany<ExtDate>(Germany<ExtDate>::FrankfurtStockExchange));
+    calendars.push_back(Germany<ExtDate>(Germany<ExtDate>::Xetra));
+    calendars.push_back(Germany<ExtDate>(Germany<ExtDate>::Eurex));
+    calendars.push_back(Germany<ExtDate>(Germany<ExtDate>::Euwax));
+    calendars.push_back(HongKong<ExtDate>());
+    calendars.push_back(Italy<ExtDate>(Italy<ExtDate>::Settlement));
+    calendars.push_back(Italy<ExtDate>(Italy<ExtDate>::Exchange));
+    calendars.push_back(Japan<ExtDate>());
+    calendars.push_back(Russia<ExtDate>(Russia<ExtDate>::Settlement));
+    calendars.push_back(Russia<ExtDate>(Russia<ExtDate>::MOEX));
+    calendars.push_back(SouthKorea<ExtDate>(SouthKorea<ExtDate>::Settlement));
+    calendars.push_back(SouthKorea<ExtDate>(SouthKorea<ExtDate>::KRX));
+    calendars.push_back(Switzerland<ExtDate>());
+    calendars.push_back(TARGET<ExtDate>());
+    calendars.push_back(Thailand<ExtDate>());
+    calendars.push_back(UnitedKingdom<ExtDate>(UnitedKingdom<ExtDate>::Settlement));
+    calendars.push_back(UnitedKingdom<ExtDate>(UnitedKingdom<ExtDate>::Exchange));
+    calendars.push_back(UnitedKingdom<ExtDate>(UnitedKingdom<ExtDate>::Metals));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::Settlement));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::NYSE));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::GovernmentBond));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::NERC));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::LiborImpact));
+    calendars.push_back(UnitedStates<ExtDate>(UnitedStates<ExtDate>::FederalReserve));
+    calendars.push_back(WeekendsOnly<ExtDate>());
+    calendars.push_back(NullCalendar<ExtDate>());
+    calendars.push_back(JointCalendar<ExtDate>(TARGET<ExtDate>(), UnitedKingdom<ExtDate>(),
+                                               UnitedStates<ExtDate>(), JoinHolidays));
+    return calendars;
+}
@@ -3,6 +3,7 @@
 #if defined(USING_PCH)
 
 #define CATCH_CONFIG_ALL_PARTS
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
 #endif  // defined(USING_PCH)
@@ -45,10 +45,16 @@
 #include <ql/time/calendars/hongkong.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/calendars/switzerland.hpp>
+#include <ql/time/calendars/thailand.hpp>
+#include <ql/time/staticcalendar.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
 #include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/storedcalendar.hpp>
+#include <ql/time/chrono_date_adaptor.hpp>
+#include <filesystem>
 #include "boost_to_catch.h"
 #include "pseudo_dates.h"
+#include "shipped_calendars.h"
 
 using namespace QuantLib;
 //using namespace boost::unit_test_framework;
@@ -2161,6 +2167,522 @@ TEST_CASE("testDayLists", "[CalendarTest][hide]")  {
     }
 }
 
+TEST_CASE("testMaterializedCalendars", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing materialized calendars...");
+
+    std::vector<Calendar<eDate> > calendars;
+    calendars.push_back(TARGET<eDate>());
+    calendars.push_back(UnitedStates<eDate>(UnitedStates<eDate>::NYSE));
+    calendars.push_back(UnitedKingdom<eDate>());
+    calendars.push_back(Brazil<eDate>());
+    calendars.push_back(China<eDate>(China<eDate>::SSE));
+    calendars.push_back(JointCalendar<eDate>(TARGET<eDate>(), Japan<eDate>()));
+
+    // the table covers 2000-2010; the check spills over on both sides
+    DLe firstDate{DAe::Date(1, January, 1998)}, endDate{DAe::Date(1, January, 2013)};
+    eDate added = DAe::Date(27, April, 2004), removed = DAe::Date(1, January, 2007);
+
+    for (auto& c : calendars) {
+        std::vector<bool> expected;
+        for (auto d = firstDate; d < endDate; d++)
+            expected.push_back(c.isBusinessDay(d));
+
+        c.materialize(2000, 2010);
+        IF (!c.isMaterialized())
+            BOOST_FAIL(c.name() << " not materialized");
+
+        Size i = 0;
+        for (auto d = firstDate; d < endDate; d++, i++) {
+            IF (c.isBusinessDay(d) != expected[i])
+                BOOST_FAIL("At date " << d << ":\n"
+                                      << "    materialized " << c.name()
+                                      << " differs from its rules");
+        }
+
+        // edits must be reflected in the table...
+        c.addHoliday(added);
+        c.removeHoliday(removed);
+        IF (c.isBusinessDay(added))
+            BOOST_FAIL(added << " still a business day for " << c.name());
+        IF (c.isHoliday(removed))
+            BOOST_FAIL(removed << " still a holiday for " << c.name());
+
+        // ...and reverting them must restore the original results
+        c.removeHoliday(added);
+        c.addHoliday(removed);
+        c.dematerialize();
+        IF (c.isMaterialized())
+            BOOST_FAIL(c.name() << " still materialized");
+        IF (c.isBusinessDay(added) != expected[to_DateLike(added) - firstDate])
+            BOOST_FAIL(added << " not restored for " << c.name());
+        IF (c.isBusinessDay(removed) != expected[to_DateLike(removed) - firstDate])
+            BOOST_FAIL(removed << " not restored for " << c.name());
+    }
+}
+
+namespace {
+
+    // businessDaysBetween with all flag combinations and advance by days
+    // over a sample of dates straddling the 2015-2018 range
+    // (MOEX data are only available from 2012)
+    template <class Cal>
+    std::vector<serial_type> businessDayCounts(const Cal& c) {
+        std::vector<serial_type> results;
+        DLe firstDate{DAe::Date(15, June, 2013)}, endDate{DAe::Date(31, December, 2019)};
+        const Integer offsets[] = {-400, -61, -7, -1, 0, 1, 3, 30, 95, 370};
+        const Integer steps[] = {-300, -22, -5, -1, 1, 2, 10, 250};
+        for (auto d = firstDate; d < endDate; d += 29) {
+            for (Integer offset : offsets) {
+                DLe d2 = d + offset;
+                for (bool includeFirst : {true, false}) {
+                    for (bool includeLast : {true, false})
+                        results.push_back(
+                            c.businessDaysBetween(d, d2, includeFirst, includeLast));
+                }
+            }
+            for (Integer n : steps)
+                results.push_back(to_DateLike(c.advance(d, n, Days)).serialNumber());
+        }
+        return results;
+    }
+
+}
+
+TEST_CASE("testMaterializedBusinessDaysBetween", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing business-day counts on materialized calendars...");
+
+    for (auto& c : shippedCalendars<eDate>()) {
+        std::vector<serial_type> expected = businessDayCounts(c);
+
+        c.materialize(2015, 2018);
+        IF (businessDayCounts(c) != expected)
+            BOOST_FAIL("materialized " << c.name()
+                                       << " disagrees with day-by-day count");
+
+        // the index must follow the edits to the calendar
+        eDate added = DAe::Date(14, June, 2016), removed = DAe::Date(1, January, 2018);
+        bool addedWasBusinessDay = c.isBusinessDay(added),
+             removedWasBusinessDay = c.isBusinessDay(removed);
+        c.addHoliday(added);
+        c.removeHoliday(removed);
+        std::vector<serial_type> edited = businessDayCounts(c);
+        c.dematerialize();
+        IF (businessDayCounts(c) != edited)
+            BOOST_FAIL("materialized " << c.name()
+                                       << " out of sync after holiday edits");
+
+        if (addedWasBusinessDay)
+            c.removeHoliday(added);
+        if (!removedWasBusinessDay)
+            c.addHoliday(removed);
+    }
+}
+
+namespace {
+
+    std::vector<serial_type> serialNumbers(const std::vector<eDate>& dates) {
+        std::vector<serial_type> result;
+        for (const auto& d : dates)
+            result.push_back(DAe::serialNumber(d));
+        return result;
+    }
+
+    // batch adjust and advance against their scalar counterparts
+    void checkBatchResults(const Calendar<eDate>& c,
+                           const std::vector<eDate>& dates) {
+        const BusinessDayConvention conventions[] = {
+            Following, ModifiedFollowing, HalfMonthModifiedFollowing,
+            Preceding, ModifiedPreceding, Unadjusted, Nearest};
+        const Period periods[] = {
+            Period(0, Days), Period(1, Days), Period(-2, Days), Period(10, Days),
+            Period(-40, Days), Period(60, Days),
+            Period(1, Weeks), Period(-1, Weeks), Period(3, Months),
+            Period(-6, Months), Period(1, Years), Period(-1, Years)};
+
+        std::vector<eDate> results(dates.size()), expected(dates.size());
+        for (auto convention : conventions) {
+            for (Size i = 0; i < dates.size(); ++i)
+                expected[i] = c.adjust(dates[i], convention);
+            c.adjust(dates, results, convention);
+            IF (serialNumbers(results) != serialNumbers(expected))
+                BOOST_FAIL(c.name() << ": batch adjust differs for "
+                                    << convention);
+        }
+        for (const auto& p : periods) {
+            for (auto convention : {ModifiedFollowing, Preceding}) {
+                for (bool endOfMonth : {false, true}) {
+                    for (Size i = 0; i < dates.size(); ++i)
+                        expected[i] = c.advance(dates[i], p, convention, endOfMonth);
+                    // in place
+                    results = dates;
+                    c.advance(results, results, p, convention, endOfMonth);
+                    IF (serialNumbers(results) != serialNumbers(expected))
+                        BOOST_FAIL(c.name() << ": batch advance differs for " << p);
+                }
+            }
+        }
+    }
+
+}
+
+TEST_CASE("testBatchAdjustAndAdvance", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing batch adjustment and advancement...");
+
+    // every day from 2014 to 2019, for which a table is built on the
+    // fly, and a sparse sample up to 2190, for which it isn't
+    // (MOEX data are only available from 2012)
+    std::vector<eDate> dense, sparse;
+    for (DLe d{DAe::Date(1, January, 2014)}; d < DLe{DAe::Date(1, January, 2020)}; d++)
+        dense.push_back(d);
+    for (DLe d{DAe::Date(3, January, 2013)}; d < DLe{DAe::Date(1, January, 2190)}; d += 97)
+        sparse.push_back(d);
+
+    for (auto& c : shippedCalendars<eDate>()) {
+        checkBatchResults(c, dense);
+        checkBatchResults(c, sparse);
+
+        // the dense sample spills over the table on both sides
+        c.materialize(2015, 2018);
+        checkBatchResults(c, dense);
+        checkBatchResults(c, sparse);
+        c.dematerialize();
+    }
+
+    Calendar<eDate> c = TARGET<eDate>();
+    std::vector<eDate> results(dense.size() - 1);
+    CHECK_THROWS(c.adjust(dense, results));
+    CHECK_THROWS(c.advance(dense, results, Period(2, Days)));
+
+    std::vector<eDate> withNull = {dense.front(), eDate(), dense.back()};
+    results.resize(withNull.size());
+    CHECK_THROWS(c.adjust(withNull, results, Unadjusted));
+    CHECK_THROWS(c.advance(withNull, results, Period(3, Months)));
+}
+
+TEST_CASE("testMaterializedJointCalendar", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing materialized joint calendars...");
+
+    // the member calendars share their implementations with every
+    // other instance, so the edits below are reverted at the end
+    Calendar<eDate> c1 = TARGET<eDate>(),
+                    c2 = UnitedKingdom<eDate>(UnitedKingdom<eDate>::Exchange),
+                    c3 = UnitedStates<eDate>(UnitedStates<eDate>::Settlement);
+    Calendar<eDate> nested = JointCalendar<eDate>(
+        JointCalendar<eDate>(c1, c2, JoinBusinessDays), c3, JoinHolidays);
+    const eDate added = DAe::Date(14, June, 2016), removed = DAe::Date(25, December, 2017);
+
+    for (auto rule : {JoinHolidays, JoinBusinessDays}) {
+        // the second instance of each is never materialized
+        auto joints = [&]() {
+            return std::vector<Calendar<eDate> >{
+                JointCalendar<eDate>(c1, c2, c3, rule),
+                JointCalendar<eDate>(c1, nested, rule)
+            };
+        };
+        std::vector<Calendar<eDate> > materialized = joints(), reference = joints();
+        for (Size i = 0; i < materialized.size(); ++i) {
+            Calendar<eDate>& joint = materialized[i];
+            std::vector<serial_type> expected = businessDayCounts(joint);
+
+            joint.materialize(2015, 2018);
+            IF (!joint.isMaterialized())
+                BOOST_FAIL(joint.name() << " not materialized");
+            IF (businessDayCounts(joint) != expected)
+                BOOST_FAIL("materialized " << joint.name()
+                                           << " disagrees with its members");
+
+            // edits to the members put the table out of date...
+            c1.addHoliday(added);
+            c3.removeHoliday(removed);
+            IF (joint.isMaterialized())
+                BOOST_FAIL(joint.name() << " still materialized after member edits");
+            std::vector<serial_type> edited = businessDayCounts(joint);
+            IF (edited != businessDayCounts(reference[i]))
+                BOOST_FAIL("member edits not seen by " << joint.name());
+            // a holiday for any member is a holiday when joining holidays
+            IF ((rule == JoinHolidays && joint.isBusinessDay(added)))
+                BOOST_FAIL(added << " still a business day for " << joint.name());
+
+            // ...until the joint calendar is materialized again
+            joint.materialize(2015, 2018);
+            IF (!joint.isMaterialized())
+                BOOST_FAIL(joint.name() << " not materialized again");
+            IF (businessDayCounts(joint) != edited)
+                BOOST_FAIL("rematerialized " << joint.name()
+                                             << " disagrees with its edited members");
+
+            // edits to the joint calendar itself keep it up to date
+            eDate ownHoliday = DAe::Date(15, June, 2016);
+            joint.addHoliday(ownHoliday);
+            IF (!joint.isMaterialized())
+                BOOST_FAIL(joint.name() << " out of date after its own edits");
+            IF (joint.isBusinessDay(ownHoliday))
+                BOOST_FAIL(ownHoliday << " still a business day for " << joint.name());
+            joint.removeHoliday(ownHoliday);
+
+            c1.removeHoliday(added);
+            c3.addHoliday(removed);
+            IF (businessDayCounts(joint) != expected)
+                BOOST_FAIL(joint.name() << " not restored after reverting member edits");
+            joint.dematerialize();
+        }
+    }
+
+    // a joint calendar needs at least one member
+    CHECK_THROWS(JointCalendar<eDate>(std::vector<Calendar<eDate> >()));
+}
+
+TEST_CASE("testHolidayStore", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing calendars read from a holiday store...");
+
+    std::vector<Calendar<eDate> > calendars = shippedCalendars<eDate>();
+    BespokeCalendar<eDate> bespoke("bespoke");
+    bespoke.addWeekend(Friday);
+    bespoke.addWeekend(Saturday);
+    bespoke.addHoliday(DAe::Date(1, June, 2016));
+    bespoke.addHoliday(DAe::Date(2, June, 2016));
+    calendars.push_back(bespoke);
+
+    std::string path =
+        (std::filesystem::temp_directory_path() / "ql_time_holiday_store.bin").string();
+    HolidayStore::write(path, calendars, 2015, 2018);
+
+    {
+        HolidayStore store(path);
+        IF (store.size() != calendars.size())
+            BOOST_FAIL(store.size() << " calendars stored instead of " << calendars.size());
+
+        // with the original calendar as fallback beyond the stored range
+        for (const auto& c : calendars) {
+            StoredCalendar<eDate> stored(store, c.name(), c);
+            IF (stored.name() != c.name())
+                BOOST_FAIL("stored " << c.name() << " read back as " << stored.name());
+            IF (!stored.isMaterialized())
+                BOOST_FAIL("stored " << c.name() << " not materialized");
+            for (Integer w = Sunday; w <= Saturday; ++w) {
+                IF (stored.isWeekend(Weekday(w)) != c.isWeekend(Weekday(w)))
+                    BOOST_FAIL("weekend mismatch for stored " << c.name());
+            }
+            IF (businessDayCounts(stored) != businessDayCounts(c))
+                BOOST_FAIL("stored " << c.name() << " disagrees with the original");
+        }
+
+        // without fallback, only weekends beyond the stored range
+        StoredCalendar<eDate> stored(store, "bespoke");
+        IF ((stored.isBusinessDay(DAe::Date(1, June, 2016)) ||
+             stored.isBusinessDay(DAe::Date(2, June, 2016))))
+            BOOST_FAIL("stored holiday lost");
+        IF (!stored.isBusinessDay(DAe::Date(3, June, 2019)))
+            BOOST_FAIL("Monday after the stored range not a business day");
+        IF (stored.isBusinessDay(DAe::Date(7, June, 2019)))
+            BOOST_FAIL("Friday after the stored range not a holiday");
+
+        // edits don't reach the store or other calendars read from it
+        eDate added = DAe::Date(6, June, 2016);
+        stored.addHoliday(added);
+        IF (stored.isBusinessDay(added))
+            BOOST_FAIL(added << " still a business day after being added");
+        IF (!StoredCalendar<eDate>(store, "bespoke").isBusinessDay(added))
+            BOOST_FAIL(added << " added to the store");
+
+        IF (store.find("no such calendar") != store.size())
+            BOOST_FAIL("unknown calendar found");
+        CHECK_THROWS(StoredCalendar<eDate>(store, "no such calendar"));
+    }
+
+    // tables whose counts or unused bits are wrong are rejected
+    HolidayStore::Entry entry;
+    {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(sizeof(HolidayStore::Header));
+        in.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    }
+    auto patch = [&path](std::uint64_t offset, auto value) {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(std::streamoff(offset));
+        f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    std::int32_t firstCount = 1;
+    patch(entry.counts, firstCount);
+    CHECK_THROWS(HolidayStore(path));
+    patch(entry.counts, std::int32_t(0));
+    std::uint64_t lastWordOffset =
+        entry.words + (std::uint64_t(entry.last - entry.first) / 64) * 8;
+    std::uint64_t totalOffset =
+        entry.counts + (std::uint64_t(entry.last - entry.first) / 64 + 1) * 4;
+    std::uint64_t lastWord;
+    std::int32_t total;
+    {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(std::streamoff(lastWordOffset));
+        in.read(reinterpret_cast<char*>(&lastWord), sizeof(lastWord));
+        in.seekg(std::streamoff(totalOffset));
+        in.read(reinterpret_cast<char*>(&total), sizeof(total));
+    }
+    // a business day past the range, consistently counted
+    patch(lastWordOffset, lastWord | (std::uint64_t(1) << 63));
+    patch(totalOffset, total + 1);
+    CHECK_THROWS(HolidayStore(path));
+    patch(lastWordOffset, lastWord);
+    patch(totalOffset, total);
+    CHECK_NOTHROW(HolidayStore(path));
+
+    // truncated files are rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    CHECK_THROWS(HolidayStore(path));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("testChronoCalendars", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing calendars on std::chrono dates...");
+
+    using std::chrono::sys_days;
+    using std::chrono::year_month_day;
+    using DAs = DateAdaptor<sys_days>;
+    using DAy = DateAdaptor<year_month_day>;
+
+    std::vector<Calendar<eDate> > calendars = {
+        TARGET<eDate>(), UnitedKingdom<eDate>(),
+        UnitedStates<eDate>(UnitedStates<eDate>::NYSE), Japan<eDate>()
+    };
+    std::vector<Calendar<sys_days> > chronoCalendars = {
+        TARGET<sys_days>(), UnitedKingdom<sys_days>(),
+        UnitedStates<sys_days>(UnitedStates<sys_days>::NYSE), Japan<sys_days>()
+    };
+    std::vector<Calendar<year_month_day> > ymdCalendars = {
+        TARGET<year_month_day>(), UnitedKingdom<year_month_day>(),
+        UnitedStates<year_month_day>(UnitedStates<year_month_day>::NYSE),
+        Japan<year_month_day>()
+    };
+
+    // the range includes January 1st, 1970, the sys_days epoch
+    serial_type first = DAe::serialNumber(DAe::Date(1, January, 1960)),
+                last = DAe::serialNumber(DAe::Date(31, December, 2030));
+    for (Size i = 0; i < calendars.size(); ++i) {
+        const Calendar<eDate>& c = calendars[i];
+        const Calendar<sys_days>& cs = chronoCalendars[i];
+        const Calendar<year_month_day>& cy = ymdCalendars[i];
+        for (serial_type s = first; s <= last; ++s) {
+            eDate d = DAe::Date(s);
+            sys_days ds = DAs::Date(s);
+            year_month_day dy = DAy::Date(s);
+            IF ((cs.isBusinessDay(ds) != c.isBusinessDay(d) ||
+                 cy.isBusinessDay(dy) != c.isBusinessDay(d)))
+                BOOST_FAIL(c.name() << ": business day mismatch at " << s);
+            serial_type expected = DAe::serialNumber(c.adjust(d, ModifiedFollowing));
+            IF ((DAs::serialNumber(cs.adjust(ds, ModifiedFollowing)) != expected ||
+                 DAy::serialNumber(cy.adjust(dy, ModifiedFollowing)) != expected))
+                BOOST_FAIL(c.name() << ": adjustment mismatch at " << s);
+            expected = DAe::serialNumber(c.advance(d, 2, Days));
+            IF ((DAs::serialNumber(cs.advance(ds, 2, Days)) != expected ||
+                 DAy::serialNumber(cy.advance(dy, 2, Days)) != expected))
+                BOOST_FAIL(c.name() << ": advance mismatch at " << s);
+            expected = DAe::serialNumber(c.advance(d, 1, Months, ModifiedFollowing, true));
+            IF ((DAs::serialNumber(cs.advance(ds, 1, Months, ModifiedFollowing, true)) != expected ||
+                 DAy::serialNumber(cy.advance(dy, 1, Months, ModifiedFollowing, true)) != expected))
+                BOOST_FAIL(c.name() << ": end-of-month advance mismatch at " << s);
+        }
+        IF (cs.businessDaysBetween(DAs::Date(first), DAs::Date(last)) !=
+            c.businessDaysBetween(DAe::Date(first), DAe::Date(last)))
+            BOOST_FAIL(c.name() << ": business days between mismatch");
+        IF (cs.businessDaysBetween(DAs::Date(15, December, 1969),
+                                   DAs::Date(15, January, 1970)) !=
+            c.businessDaysBetween(DAe::Date(15, December, 1969),
+                                  DAe::Date(15, January, 1970)))
+            BOOST_FAIL(c.name() << ": business days between mismatch around the epoch");
+    }
+
+    // materialized tables spanning the epoch
+    Calendar<sys_days> target = TARGET<sys_days>();
+    target.materialize(1960, 1980);
+    IF (!target.isMaterialized())
+        BOOST_FAIL("TARGET on sys_days not materialized");
+    IF (DAs::serialNumber(target.advance(DAs::Date(31, December, 1969), 1, Days)) !=
+        DAe::serialNumber(calendars[0].advance(DAe::Date(31, December, 1969), 1, Days)))
+        BOOST_FAIL("materialized TARGET: advance mismatch around the epoch");
+    target.dematerialize();
+}
+
+TEST_CASE("testEasterMonday", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing compile-time Easter Monday tables...");
+
+    // expressed relative to first day of year
+    static_assert(detail::westernEasterMonday(2024) ==
+                  detail::dayOfYear(detail::serialNumber(1, April, 2024)));
+    static_assert(detail::orthodoxEasterMonday(2024) ==
+                  detail::dayOfYear(detail::serialNumber(6, May, 2024)));
+    static_assert(detail::westernEasterMonday(2000) ==
+                  detail::orthodoxEasterMonday(2000) - 7);
+    static_assert(detail::westernEasterMonday(2199) == 105);
+
+    // every Easter Monday is a Monday
+    for (Year y = 1901; y <= 2199; ++y) {
+        serial_type western = detail::yearOffset(y) + detail::westernEasterMonday(y);
+        serial_type orthodox = detail::yearOffset(y) + detail::orthodoxEasterMonday(y);
+        IF ((detail::weekday(western) != Monday || detail::weekday(orthodox) != Monday))
+            BOOST_FAIL("Easter Monday is not a Monday in " << y);
+        IF (orthodox < western)
+            BOOST_FAIL("Orthodox Easter before Western Easter in " << y);
+    }
+
+    IF (TARGET<eDate>().isBusinessDay(DateAdaptor<eDate>::Date(1, April, 2024)));
+}
+
+TEST_CASE("testStaticCalendars", "[CalendarTest][hide]")  {
+
+    BOOST_TEST_MESSAGE("Testing statically-dispatched calendars...");
+
+    const BusinessDayConvention conventions[] = {
+        Following, ModifiedFollowing, HalfMonthModifiedFollowing,
+        Preceding, ModifiedPreceding, Nearest, Unadjusted
+    };
+
+    for (auto& c : shippedCalendars<eDate>()) {
+        if (c.name().find("JoinHolidays") != std::string::npos) {
+            CHECK_THROWS(StaticCalendar<eDate>(c));
+            continue;
+        }
+        StaticCalendar<eDate> sc(c);
+
+        IF (sc.name() != c.name())
+            BOOST_FAIL("static calendar named " << sc.name()
+                       << " instead of " << c.name());
+        IF (businessDayCounts(sc) != businessDayCounts(c))
+            BOOST_FAIL("static " << c.name() << " disagrees on business-day counts");
+        for (DLe d{DAe::Date(1, March, 2013)}; d < DAe::Date(31, December, 2019); d += 3) {
+            IF (sc.isBusinessDay(d) != c.isBusinessDay(d))
+                BOOST_FAIL("static " << c.name() << " disagrees on business days");
+            for (BusinessDayConvention bdc : conventions) {
+                IF (to_DateLike(sc.adjust(d, bdc)) != c.adjust(d, bdc))
+                    BOOST_FAIL("static " << c.name() << " disagrees on adjust");
+            }
+            IF (to_DateLike(sc.advance(d, 3, Months, ModifiedFollowing, true))
+                != c.advance(d, 3, Months, ModifiedFollowing, true))
+                BOOST_FAIL("static " << c.name() << " disagrees on advance");
+        }
+        for (Weekday w : {Monday, Friday, Saturday, Sunday}) {
+            IF (sc.isWeekend(w) != c.isWeekend(w))
+                BOOST_FAIL("static " << c.name() << " disagrees on weekends");
+        }
+
+        // holiday edits are shared with the wrapped calendar
+        eDate added = DAe::Date(14, June, 2016);
+        bool addedWasBusinessDay = c.isBusinessDay(added);
+        c.addHoliday(added);
+        IF (sc.isBusinessDay(added))
+            BOOST_FAIL("static " << c.name() << " misses added holiday");
+        if (addedWasBusinessDay)
+            c.removeHoliday(added);
+    }
+}
+
 //test_suite* CalendarTest::suite() {
 //    test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 //
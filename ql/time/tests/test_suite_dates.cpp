@@ -31,8 +31,13 @@
 #include <ql/time/ecb.hpp>
 #include <ql/time/asx.hpp>
 #include <ql/time/ql_utilities_dataparsers.hpp>
+#include <ql/time/ql_settings.hpp>
+#include <ql/time/chrono_date_adaptor.hpp>
 
 #include <unordered_set>
+#include <array>
+#include <atomic>
+#include <thread>
 #include "boost_to_catch.h"
 //#include <boost/functional/hash.hpp>
 #include <sstream>
@@ -47,6 +52,8 @@ using eDate = blpapi_datetime;
 using eDate = QuantLibDate;
 #endif
 
+using DAe = DateAdaptor<eDate>;
+
 TEST_CASE("ecbDates", "[DateTest][hide]") {
 //void DateTest::ecbDates() {
     BOOST_TEST_MESSAGE("Testing ECB dates...");
@@ -81,6 +88,15 @@ TEST_CASE("ecbDates", "[DateTest][hide]") {
             BOOST_FAIL("\n next EBC date following " << previousEcbDate <<
                        " must be " << currentEcbDate);
 
+        IF (to_DateLike(ECB<eDate>::previousDate(to_DateLike(currentEcbDate)+1))
+            != currentEcbDate)
+            BOOST_FAIL("\n previous EBC date preceding " << currentEcbDate
+                       << "+1 must be " << currentEcbDate);
+        IF (i != knownDates.begin() &&
+            to_DateLike(ECB<eDate>::previousDate(currentEcbDate)) != previousEcbDate)
+            BOOST_FAIL("\n previous EBC date preceding " << currentEcbDate <<
+                       " must be " << previousEcbDate);
+
         previousEcbDate = currentEcbDate;
     }
 
@@ -239,6 +255,163 @@ TEST_CASE("asxDates", "[DateTest][hide]") {
     }
 }
 
+TEST_CASE("futuresDateLookups", "[DateTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing IMM and ASX date lookups...");
+
+    // spans the precomputed years and both sides of them
+    eDate counter = DateLike<eDate>::minDate() + 1 * Years;
+    eDate last = DateLike<eDate>::maxDate() - 2 * Years;
+
+    while (to_DateLike(counter) <= last) {
+        for (bool mainCycle : {false, true}) {
+            eDate imm = IMM<eDate>::nextDate(counter, mainCycle);
+            eDate previous = IMM<eDate>::previousDate(imm, mainCycle);
+            IF (!IMM<eDate>::isIMMdate(previous, mainCycle))
+                BOOST_FAIL("\n  " << previous << " is not an IMM date");
+            // no IMM date between counter and the next one
+            IF (to_DateLike(previous) > counter)
+                BOOST_FAIL("\n  previous IMM date " << previous
+                           << " is after " << counter);
+            IF (to_DateLike(IMM<eDate>::nextDate(previous, mainCycle)) != imm)
+                BOOST_FAIL("\n  next IMM date after " << previous
+                           << " is not " << imm);
+
+            std::vector<eDate> imms = IMM<eDate>::nextDates(counter, 6, mainCycle);
+            IF (imms.size() != 6)
+                BOOST_FAIL("\n  wrong number of IMM dates");
+            eDate expected = counter;
+            for (const eDate& d : imms) {
+                expected = IMM<eDate>::nextDate(expected, mainCycle);
+                IF (to_DateLike(d) != expected)
+                    BOOST_FAIL("\n  " << d << " instead of " << expected);
+            }
+
+            eDate asx = ASX<eDate>::nextDate(counter, mainCycle);
+            previous = ASX<eDate>::previousDate(asx, mainCycle);
+            IF (!ASX<eDate>::isASXdate(previous, mainCycle))
+                BOOST_FAIL("\n  " << previous << " is not an ASX date");
+            IF (to_DateLike(previous) > counter)
+                BOOST_FAIL("\n  previous ASX date " << previous
+                           << " is after " << counter);
+            IF (to_DateLike(ASX<eDate>::nextDate(previous, mainCycle)) != asx)
+                BOOST_FAIL("\n  next ASX date after " << previous
+                           << " is not " << asx);
+
+            std::vector<eDate> asxs = ASX<eDate>::nextDates(counter, 6, mainCycle);
+            IF (asxs.size() != 6)
+                BOOST_FAIL("\n  wrong number of ASX dates");
+            expected = counter;
+            for (const eDate& d : asxs) {
+                expected = ASX<eDate>::nextDate(expected, mainCycle);
+                IF (to_DateLike(d) != expected)
+                    BOOST_FAIL("\n  " << d << " instead of " << expected);
+            }
+        }
+        counter = to_DateLike(counter) + 3;
+    }
+
+    // ECB lookups from several threads
+    auto knownDates = ECB<eDate>::knownDates();
+    std::vector<eDate> all = ECB<eDate>::nextDates(DateLike<eDate>::minDate());
+    std::vector<eDate> first = ECB<eDate>::nextDates(DateLike<eDate>::minDate(), 5);
+    IF (first.size() != 5)
+        BOOST_FAIL("\n  wrong number of ECB dates");
+    IF (!std::equal(first.begin(), first.end(), all.begin(),
+                    [](const eDate& d1, const eDate& d2) {
+                        return to_DateLike(d1) == d2;
+                    }))
+        BOOST_FAIL("\n  wrong ECB dates");
+
+    // a date past the known ones is added and removed meanwhile
+    eDate extra = to_DateLike(all.back()) + 7;
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&all, &failures]() {
+            for (Size i = 1; i < all.size(); ++i) {
+                eDate d = to_DateLike(all[i]) - 1;
+                if (to_DateLike(ECB<eDate>::nextDate(d)) != all[i] ||
+                    to_DateLike(ECB<eDate>::previousDate(d)) != all[i-1])
+                    ++failures;
+                Size n = ECB<eDate>::knownDates().size();
+                if (n != all.size() && n != all.size() + 1)
+                    ++failures;
+            }
+        });
+    }
+    threads.emplace_back([extra]() {
+        for (int k = 0; k < 100; ++k) {
+            ECB<eDate>::addDate(extra);
+            ECB<eDate>::removeDate(extra);
+        }
+    });
+    for (auto& t : threads)
+        t.join();
+    IF (failures != 0)
+        BOOST_FAIL("\n  " << failures << " wrong concurrent ECB lookups");
+}
+
+TEST_CASE("chronoDates", "[DateTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing std::chrono date adaptors...");
+
+    using std::chrono::sys_days;
+    using std::chrono::year_month_day;
+    using DAs = DateAdaptor<sys_days>;
+    using DAy = DateAdaptor<year_month_day>;
+
+    static_assert(DAs::serialNumber(DAs::Date(1, January, 1901)) == 367);
+    static_assert(DAy::serialNumber(DAy::Date(31, December, 2199)) == 109574);
+
+    // null dates
+    IF ((DAs::serialNumber(nullDate<sys_days>()) != 0 ||
+         DAy::serialNumber(nullDate<year_month_day>()) != 0))
+        BOOST_FAIL("\nnull chrono date is not mapped to the null serial number");
+    IF ((DAs::Date(0) != nullDate<sys_days>() ||
+         DAy::Date(0) != nullDate<year_month_day>()))
+        BOOST_FAIL("\nnull serial number is not mapped to the null chrono date");
+    // the default sys_days is the Unix epoch, a valid date
+    IF (DAs::serialNumber(sys_days()) != DAe::serialNumber(DAe::Date(1, January, 1970)))
+        BOOST_FAIL("\ndefault sys_days is not mapped to January 1st, 1970");
+    IF (fmt::format("{}", nullDate<sys_days>()) != "null date")
+        BOOST_FAIL("\nnull sys_days formatted as "
+                   << fmt::format("{}", nullDate<sys_days>()));
+    IF (fmt::format("{}", sys_days()) != "1970-01-01")
+        BOOST_FAIL("\nUnix epoch formatted as " << fmt::format("{}", sys_days()));
+
+    serial_type minDate = DAe::serialNumber(DateLike<eDate>::minDate()),
+                maxDate = DAe::serialNumber(DateLike<eDate>::maxDate());
+    for (serial_type s = minDate; s <= maxDate; ++s) {
+        eDate e = DAe::Date(s);
+        const DateLike<eDate>& d = to_DateLike(e);
+        sys_days ds = DAs::Date(s);
+        year_month_day dy = DAy::Date(s);
+        const DateLike<sys_days>& ls = to_DateLike(ds);
+        const DateLike<year_month_day>& ly = to_DateLike(dy);
+
+        IF ((ls.serialNumber() != s || ly.serialNumber() != s))
+            BOOST_FAIL("\nserial number " << s << " not preserved");
+        IF ((ls.weekday() != d.weekday() || ly.weekday() != d.weekday()))
+            BOOST_FAIL("\nweekday mismatch at " << s);
+        IF ((ls.dayOfMonth() != d.dayOfMonth() || ly.dayOfMonth() != d.dayOfMonth()))
+            BOOST_FAIL("\nday of month mismatch at " << s);
+        IF ((ls.month() != d.month() || ly.month() != d.month()))
+            BOOST_FAIL("\nmonth mismatch at " << s);
+        IF ((ls.year() != d.year() || ly.year() != d.year()))
+            BOOST_FAIL("\nyear mismatch at " << s);
+        IF ((DAs::serialNumber(DAs::Date(d.dayOfMonth(), d.month(), d.year())) != s ||
+             DAy::serialNumber(DAy::Date(d.dayOfMonth(), d.month(), d.year())) != s))
+            BOOST_FAIL("\nday, month, year constructor mismatch at " << s);
+        IF ((DateLike<sys_days>::isEndOfMonth(ls) != DateLike<eDate>::isEndOfMonth(d) ||
+             DateLike<year_month_day>::isEndOfMonth(ly) != DateLike<eDate>::isEndOfMonth(d)))
+            BOOST_FAIL("\nend of month mismatch at " << s);
+        if (s + 400 < maxDate) {
+            IF ((DAs::serialNumber(ls + 1 * Years) != DAe::serialNumber(d + 1 * Years) ||
+                 DAy::serialNumber(ly + 1 * Years) != DAe::serialNumber(d + 1 * Years)))
+                BOOST_FAIL("\nyear advance mismatch at " << s);
+        }
+    }
+}
+
 TEST_CASE("testConsistency", "[DateTest][hide]") {
 //    void DateTest::testConsistency() {
 
@@ -342,6 +515,145 @@ TEST_CASE("testConsistency", "[DateTest][hide]") {
     }
 
 }
+TEST_CASE("constexprDates", "[DateTest][hide]") {
+
+    BOOST_TEST_MESSAGE("Testing compile-time date arithmetic...");
+
+    // serial numbers and calendar fields
+    static_assert(detail::serialNumber(1, January, 1970) == 25569);
+    static_assert(detail::serialNumber(31, December, 2199) == 109574);
+    static_assert(detail::serialNumber(29, February, 2024) == 45351);
+    static_assert(detail::year(45658) == 2025);
+    static_assert(detail::month(45658) == January);
+    static_assert(detail::dayOfMonth(45657) == 31);
+    static_assert(detail::weekday(detail::serialNumber(16, October, 2026)) == Friday);
+    static_assert(detail::isLeap(2000) && !detail::isLeap(2100));
+
+    // period arithmetic, with end-of-month clipping
+    constexpr serial_type jan31 = detail::serialNumber(31, January, 2024);
+    static_assert(detail::advance(jan31, 1, Months) == detail::serialNumber(29, February, 2024));
+    static_assert(detail::advance(jan31, -2, Months) == detail::serialNumber(30, November, 2023));
+    static_assert(detail::advance(detail::serialNumber(29, February, 2024), 1, Years)
+                  == detail::serialNumber(28, February, 2025));
+    static_assert(detail::advance(jan31, 2, Weeks) == jan31 + 14);
+    static_assert(detail::advance(jan31, 200, Years) == 0);
+
+    // a compile-time table of the IMM dates of a year
+    constexpr auto imm2024 = [] {
+        std::array<serial_type, 4> dates{};
+        for (Size i = 0; i < dates.size(); ++i) {
+            auto m = Month(3 * i + 3);
+            dates[i] = detail::serialNumber(detail::nthWeekday(3, Wednesday, m, 2024), m, 2024);
+        }
+        return dates;
+    }();
+    static_assert(imm2024[0] == detail::serialNumber(20, March, 2024));
+    static_assert(imm2024[1] == detail::serialNumber(19, June, 2024));
+    static_assert(imm2024[2] == detail::serialNumber(18, September, 2024));
+    static_assert(imm2024[3] == detail::serialNumber(18, December, 2024));
+
+    // the run-time methods agree over the whole date range
+    serial_type minDate = DateLike<eDate>::minDate().serialNumber(),
+                maxDate = DateLike<eDate>::maxDate().serialNumber();
+    for (serial_type i=minDate; i<=maxDate; i++) {
+        DateLike<eDate> t {DateAdaptor<eDate>::Date(i)};
+        IF ((detail::year(i) != t.year() ||
+             detail::month(i) != t.month() ||
+             detail::dayOfMonth(i) != t.dayOfMonth() ||
+             detail::dayOfYear(i) != t.dayOfYear() ||
+             detail::weekday(i) != t.weekday() ||
+             detail::serialNumber(t.dayOfMonth(), t.month(), t.year()) != i))
+            BOOST_FAIL("compile-time arithmetic inconsistent at serial " << i);
+    }
+    for (serial_type i=minDate; i<=maxDate; i+=17) {
+        DateLike<eDate> t {DateAdaptor<eDate>::Date(i)};
+        for (Integer n : {-13, -1, 1, 7, 25}) {
+            serial_type m = detail::advance(i, n, Months);
+            if (m >= minDate && m <= maxDate)
+                IF (m != (t + Period(n, Months)).serialNumber())
+                    BOOST_FAIL("compile-time advance inconsistent at serial " << i);
+        }
+    }
+}
+
+TEST_CASE("bulkDates", "[DateTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing bulk parsing and formatting of dates...");
+
+    serial_type minDate = DateLike<eDate>::minDate().serialNumber(),
+                maxDate = DateLike<eDate>::maxDate().serialNumber();
+    std::vector<serial_type> serials;
+    for (serial_type s = minDate; s <= maxDate; ++s)
+        serials.push_back(s);
+
+    for (auto layout : { DateFormat::ISO, DateFormat::Compact, DateFormat::Serial }) {
+        std::string text = io::format_serials(std::span<const serial_type>(serials), layout);
+        std::vector<serial_type> parsed(serials.size());
+        REQUIRE(io::parse_serials(text, parsed, layout) == serials.size());
+        CHECK(parsed == serials);
+    }
+
+    // formats agree with the scalar parser and date inspectors
+    std::string iso = io::format_serials(std::span<const serial_type>(serials), DateFormat::ISO);
+    for (Size i = 0; i < serials.size(); i += 97) {
+        DateLike<eDate> d{DateParser<eDate>::parseISO(iso.substr(11 * i, 10))};
+        IF (d.serialNumber() != serials[i]);
+    }
+    serial_type jan15 = DateLike<eDate>{DAe::Date(15, January, 2006)}.serialNumber();
+    CHECK(io::format_serials(std::span<const serial_type>(&jan15, 1), DateFormat::Compact, ',')
+          == "20060115,");
+    CHECK(io::format_serials(std::span<const serial_type>(&jan15, 1), DateFormat::Serial)
+          == "38732\n");
+
+    // any ExtDate, mixed delimiters
+    std::array<eDate, 4> dates;
+    REQUIRE(DateParser<eDate>::parse(" 2006-01-15,2012-02-29;\r\n2199-12-31\t1901-01-01\n",
+                                     dates, DateFormat::ISO) == 4);
+    CHECK(to_DateLike(dates[0]) == DAe::Date(15, January, 2006));
+    CHECK(to_DateLike(dates[1]) == DAe::Date(29, February, 2012));
+    CHECK(to_DateLike(dates[2]) == DAe::Date(31, December, 2199));
+    CHECK(to_DateLike(dates[3]) == DAe::Date(1, January, 1901));
+    CHECK(io::format_dates(std::span<const eDate>(dates), DateFormat::Compact, ' ')
+          == "20060115 20120229 21991231 19010101 ");
+
+    // invalid tokens and overflows are reported
+    CHECK_THROWS(DateParser<eDate>::parse("2011-02-29", dates, DateFormat::ISO));
+    CHECK_THROWS(DateParser<eDate>::parse("2011-13-01", dates, DateFormat::ISO));
+    CHECK_THROWS(DateParser<eDate>::parse("2011/01/01", dates, DateFormat::ISO));
+    CHECK_THROWS(DateParser<eDate>::parse("1900-12-31", dates, DateFormat::ISO));
+    CHECK_THROWS(DateParser<eDate>::parse("2011011", dates, DateFormat::Compact));
+    CHECK_THROWS(DateParser<eDate>::parse("366", dates, DateFormat::Serial));
+    CHECK_THROWS(DateParser<eDate>::parse("4x000", dates, DateFormat::Serial));
+    CHECK_THROWS(DateParser<eDate>::parse("1 2 3 4 5", dates, DateFormat::Serial));
+    CHECK(DateParser<eDate>::parse(" \n", dates, DateFormat::ISO) == 0);
+}
+
+TEST_CASE("bulkDatesBenchmark", "[DateTest][!benchmark]") {
+    serial_type first = DateLike<eDate>{DAe::Date(1, January, 2000)}.serialNumber();
+    std::vector<serial_type> serials(100000);
+    for (Size i = 0; i < serials.size(); ++i)
+        serials[i] = first + serial_type(i % 10000);
+    std::string text = io::format_serials(std::span<const serial_type>(serials), DateFormat::ISO);
+    std::vector<eDate> dates(serials.size());
+
+    BENCHMARK("DateParser::parseISO, 100000 dates") {
+        std::istringstream in(text);
+        std::string token;
+        Size n = 0;
+        while (std::getline(in, token))
+            dates[n++] = DateParser<eDate>::parseISO(token);
+        return n;
+    };
+    BENCHMARK("DateParser::parse, 100000 dates") {
+        return DateParser<eDate>::parse(text, dates, DateFormat::ISO);
+    };
+    BENCHMARK("io::parse_serials, 100000 dates") {
+        return io::parse_serials(text, serials, DateFormat::ISO);
+    };
+    BENCHMARK("io::format_serials, 100000 dates") {
+        return io::format_serials(std::span<const serial_type>(serials), DateFormat::ISO);
+    };
+}
+
 TEST_CASE("isoDates", "[DateTest][hide]") {
     //void DateTest::isoDates() {
     BOOST_TEST_MESSAGE("Testing ISO dates...");
@@ -357,6 +669,70 @@ TEST_CASE("isoDates", "[DateTest][hide]") {
                    << " year:          " << d.year()) ; 
     
 }
+TEST_CASE("settingsContext", "[DateTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing thread-local settings contexts...");
+
+    using S = Settings<eDate>;
+    SavedSettings<eDate> backup;
+    const serial_type global = DAe::serialNumber(DAe::Date(1, March, 2021));
+    S::instance().evaluationDate() = DAe::Date(global);
+    S::instance().includeReferenceDateEvents() = false;
+
+    // workers value at their own dates side by side
+    std::atomic<int> failures(0);
+    std::vector<std::thread> workers;
+    for (Integer i = 0; i < 8; ++i) {
+        workers.emplace_back([i, global, &failures]() {
+            SettingsContext<eDate> context;
+            if (DAe::serialNumber(S::instance().evaluationDate()) != global)
+                ++failures;
+            for (Integer k = 0; k < 1000; ++k) {
+                serial_type s = global - 10 * i - k;
+                S::instance().evaluationDate() = DAe::Date(s);
+                S::instance().includeReferenceDateEvents() = (k + i) % 2 == 0;
+                std::this_thread::yield();
+                if (DAe::serialNumber(S::instance().evaluationDate()) != s ||
+                    S::instance().includeReferenceDateEvents() != ((k + i) % 2 == 0))
+                    ++failures;
+            }
+            {
+                // saved settings restore the context's
+                SavedSettings<eDate> saved;
+                S::instance().evaluationDate() = DAe::Date(global + 1);
+                S::instance().enforcesTodaysHistoricFixings() = true;
+            }
+            if (DAe::serialNumber(S::instance().evaluationDate()) != global - 10 * i - 999 ||
+                S::instance().enforcesTodaysHistoricFixings())
+                ++failures;
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    IF (failures != 0)
+        BOOST_FAIL(failures << " inconsistent thread-local settings");
+
+    // the global settings are untouched...
+    IF (DAe::serialNumber(S::instance().evaluationDate()) != global)
+        BOOST_FAIL("global evaluation date changed by thread-local contexts");
+    IF (S::instance().includeReferenceDateEvents())
+        BOOST_FAIL("global flag changed by thread-local contexts");
+
+    // ...and contexts nest on the same thread
+    {
+        SettingsContext<eDate> outer(DAe::Date(global - 1));
+        {
+            SettingsContext<eDate> inner;
+            IF (DAe::serialNumber(S::instance().evaluationDate()) != global - 1)
+                BOOST_FAIL("nested context not initialized from the outer one");
+            S::instance().evaluationDate() = DAe::Date(global - 2);
+        }
+        IF (DAe::serialNumber(S::instance().evaluationDate()) != global - 1)
+            BOOST_FAIL("outer context not restored");
+    }
+    IF (DAe::serialNumber(S::instance().evaluationDate()) != global)
+        BOOST_FAIL("global settings not restored");
+}
+
 #ifdef PARSE_FORMATTED_DATES // TODO
 TEST_CASE("parseDates", "[DateTest][hide]") {
 //    void DateTest::parseDates() {
@@ -31,13 +31,16 @@
 #include <ql/time/daycounters/business252.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/daycounters/thirty365.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/calendars/canada.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/staticdaycounter.hpp>
 #include "boost_to_catch.h"
 #include "pseudo_dates.h"
 #include <iomanip>
+#include <thread>
 
 using namespace QuantLib;
 //using namespace boost::unit_test_framework;
@@ -647,6 +650,78 @@ TEST_CASE("testBusiness252", "[DayCounterTest][hide]") {
     }
 }
 
+TEST_CASE("testBusiness252Concurrency", "[DayCounterTest][hide]") {
+
+    BOOST_TEST_MESSAGE("Testing business/252 day counter from several threads...");
+
+    Calendar<eDate> calendar = Brazil<eDate>();
+    // the precomputed years only cover part of the tested dates
+    DayCounter<eDate> dayCounter = Business252<eDate>(calendar, 2005, 2015);
+
+    std::vector<std::pair<eDate, eDate> > periods;
+    DLe firstDate{DAe::Date(3, January, 2000)}, endDate{DAe::Date(31, December, 2020)};
+    const Integer lengths[] = {1, 17, 45, 190, 400, 1200, 3000};
+    for (auto d = firstDate; d < endDate; d += 41) {
+        for (Integer length : lengths)
+            periods.emplace_back(d, d + length);
+    }
+
+    std::vector<serial_type> expected;
+    for (const auto& p : periods)
+        expected.push_back(calendar.businessDaysBetween(p.first, p.second));
+
+    const Size threads = 4;
+    std::vector<std::vector<serial_type> > calculated(threads);
+    std::vector<std::thread> workers;
+    for (Size t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (const auto& p : periods)
+                calculated[t].push_back(dayCounter.dayCount(p.first, p.second));
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    for (Size t = 0; t < threads; ++t) {
+        IF (calculated[t] != expected)
+            BOOST_ERROR("business/252 day counts differ from calendar counts in thread " << t);
+    }
+}
+
+TEST_CASE("testBusiness252CalendarChanges", "[DayCounterTest][hide]") {
+
+    BOOST_TEST_MESSAGE("Testing business/252 day counter after calendar changes...");
+
+    eDate d1 = DAe::Date(15, January, 2010), d2 = DAe::Date(15, June, 2010);
+    eDate holiday = DAe::Date(10, March, 2010);  // a Wednesday
+
+    // same name, different weekends
+    BespokeCalendar<eDate> weekends("bespoke"), sundays("bespoke");
+    weekends.addWeekend(Saturday);
+    weekends.addWeekend(Sunday);
+    sundays.addWeekend(Sunday);
+
+    DayCounter<eDate> dc1 = Business252<eDate>(weekends, 2005, 2015);
+    DayCounter<eDate> dc2 = Business252<eDate>(sundays, 2005, 2015);
+    IF (dc1.dayCount(d1, d2) != weekends.businessDaysBetween(d1, d2))
+        BOOST_ERROR("wrong day count for the first calendar");
+    IF (dc2.dayCount(d1, d2) != sundays.businessDaysBetween(d1, d2))
+        BOOST_ERROR("wrong day count for the second calendar with the same name");
+
+    serial_type before = dc1.dayCount(d1, d2);
+    weekends.addHoliday(holiday);
+    IF (dc1.dayCount(d1, d2) != before - 1)
+        BOOST_ERROR("added holiday not reflected by existing day counter");
+    DayCounter<eDate> dc3 = Business252<eDate>(weekends, 2005, 2015);
+    IF (dc3.dayCount(d1, d2) != before - 1)
+        BOOST_ERROR("added holiday not reflected by new day counter");
+
+    weekends.removeHoliday(holiday);
+    DayCounter<eDate> dc4 = Business252<eDate>(weekends, 2005, 2015);
+    IF ((dc1.dayCount(d1, d2) != before || dc4.dayCount(d1, d2) != before))
+        BOOST_ERROR("removed holiday not reflected");
+}
+
 TEST_CASE("testThirty365", "[DayCounterTest][hide]") {
 
     BOOST_TEST_MESSAGE("Testing 30/365 day counter...");
@@ -844,6 +919,118 @@ CHECK_THROWS( dayCounter.yearFraction(DAe::Date(10, September, 2018),
 );
 }
 
+TEST_CASE("testBatchInterface", "[DayCounterTest][hide]") {
+
+    BOOST_TEST_MESSAGE("Testing batch day counts and year fractions...");
+
+    Schedule<eDate> schedule = MakeSchedule<eDate>()
+        .from(DAe::Date(10, January, 2017))
+        .withFirstDate(DAe::Date(31, August, 2017))
+        .to(DAe::Date(28, February, 2026))
+        .withFrequency(Semiannual)
+        .withCalendar(UnitedStates<eDate>())
+        .withConvention(Unadjusted)
+        .backwards().endOfMonth(true);
+
+    const DayCounter<eDate> dayCounters[] = {
+        Actual360<eDate>(), Actual360<eDate>(true),
+        Actual365Fixed<eDate>(), Actual365Fixed<eDate>(Actual365Fixed<eDate>::Canadian),
+        Actual365Fixed<eDate>(Actual365Fixed<eDate>::NoLeap),
+        Thirty360<eDate>(Thirty360<eDate>::USA), Thirty360<eDate>(Thirty360<eDate>::European),
+        Thirty360<eDate>(Thirty360<eDate>::Italian), Thirty360<eDate>(Thirty360<eDate>::German),
+        Thirty360<eDate>(Thirty360<eDate>::German, true),
+        ActualActual<eDate>(ActualActual<eDate>::ISDA), ActualActual<eDate>(ActualActual<eDate>::ISMA),
+        ActualActual<eDate>(ActualActual<eDate>::ISMA, schedule),
+        ActualActual<eDate>(ActualActual<eDate>::AFB), Thirty365<eDate>()
+    };
+
+    // periods of various lengths, in both directions, with
+    // semiannual reference periods regular or not
+    std::vector<eDate> starts, ends, refStarts, refEnds;
+    const Integer lengths[] = {0, 1, 15, 31, 59, 180, 367, 1000, -45, -400};
+    for (DLe d{DAe::Date(3, January, 2017)}; d < DAe::Date(1, March, 2025); d += 23) {
+        for (Integer length : lengths) {
+            starts.push_back(d);
+            ends.push_back(d + length);
+            DLe refStart = d - (length % 11);
+            refStarts.push_back(refStart);
+            refEnds.push_back(refStart + 6*Months);
+        }
+    }
+    const Size n = starts.size();
+
+    for (const auto& dayCounter : dayCounters) {
+        std::vector<serial_type> days(n);
+        dayCounter.dayCounts(starts, ends, days);
+        std::vector<Time> fractions(n);
+        dayCounter.yearFractions(starts, ends, fractions, refStarts, refEnds);
+        for (Size i = 0; i < n; ++i) {
+            IF (days[i] != dayCounter.dayCount(starts[i], ends[i]))
+                BOOST_ERROR(dayCounter.name() << " batch day count from "
+                            << starts[i] << " to " << ends[i] << ": "
+                            << days[i]);
+            Time expected = dayCounter.yearFraction(starts[i], ends[i],
+                                                    refStarts[i], refEnds[i]);
+            IF (std::fabs(fractions[i] - expected) > 1.0e-14)
+                BOOST_ERROR(dayCounter.name() << " batch year fraction from "
+                            << starts[i] << " to " << ends[i] << ":\n"
+                            << std::setprecision(16)
+                            << "    calculated: " << fractions[i] << "\n"
+                            << "    expected:   " << expected);
+        }
+        // without reference periods (the Canadian convention needs them)
+        if (dayCounter.name() != "Actual/365 (Fixed) Canadian Bond") {
+            dayCounter.yearFractions(starts, ends, fractions);
+            for (Size i = 0; i < n; ++i) {
+                IF (std::fabs(fractions[i] - dayCounter.yearFraction(starts[i], ends[i]))
+                    > 1.0e-14)
+                    BOOST_ERROR(dayCounter.name() << " batch year fraction from "
+                                << starts[i] << " to " << ends[i]
+                                << " without reference period: " << fractions[i]);
+            }
+        }
+    }
+
+    std::vector<Time> fractions(n), tooShort(n - 1);
+    CHECK_THROWS(Actual360<eDate>().yearFractions(starts, ends, tooShort));
+    CHECK_THROWS(Actual360<eDate>().yearFractions(
+        starts, ends, fractions, std::span<const eDate>(refStarts).first(n - 1)));
+}
+
+TEST_CASE("testStaticDayCounters", "[DayCounterTest][hide]") {
+
+    BOOST_TEST_MESSAGE("Testing statically-dispatched day counters...");
+
+    const DayCounter<eDate> dayCounters[] = {
+        Actual360<eDate>(), Actual365Fixed<eDate>(),
+        Actual365Fixed<eDate>(Actual365Fixed<eDate>::NoLeap),
+        Thirty360<eDate>(Thirty360<eDate>::USA), Thirty360<eDate>(Thirty360<eDate>::European),
+        Thirty360<eDate>(Thirty360<eDate>::Italian), Thirty360<eDate>(Thirty360<eDate>::German),
+        ActualActual<eDate>(ActualActual<eDate>::ISDA), ActualActual<eDate>(ActualActual<eDate>::ISMA),
+        ActualActual<eDate>(ActualActual<eDate>::AFB), Thirty365<eDate>(),
+        SimpleDayCounter<eDate>(), OneDayCounter<eDate>(), Business252<eDate>()
+    };
+
+    const Integer lengths[] = {0, 1, 31, 180, 367, -45};
+    for (const auto& dayCounter : dayCounters) {
+        StaticDayCounter<eDate> sdc(dayCounter);
+        IF (sdc.name() != dayCounter.name())
+            BOOST_FAIL("static day counter named " << sdc.name()
+                       << " instead of " << dayCounter.name());
+        for (DLe d{DAe::Date(3, January, 2017)}; d < DAe::Date(1, March, 2020); d += 13) {
+            for (Integer length : lengths) {
+                DLe d2 = d + length;
+                IF (sdc.dayCount(d, d2) != dayCounter.dayCount(d, d2))
+                    BOOST_FAIL("static " << dayCounter.name() << " disagrees on day count");
+                IF (sdc.yearFraction(d, d2) != dayCounter.yearFraction(d, d2))
+                    BOOST_FAIL("static " << dayCounter.name() << " disagrees on year fraction");
+            }
+        }
+    }
+
+    CHECK_THROWS(StaticDayCounter<eDate>(DayCounter<eDate>()));
+}
+
 
 TEST_CASE("testIntraday", "[DayCounterTest][hide]") {
 #ifdef QL_HIGH_RESOLUTION_DATE
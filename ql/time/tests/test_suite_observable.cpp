@@ -0,0 +1,174 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+// compiled into qltime_tests with the default observer pattern, and
+// into qltime_cow_observer_tests with the copy-on-write one
+
+#include <ql/time/ql_patterns_observable.hpp>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "boost_to_catch.h"
+
+using namespace QuantLib;
+
+namespace {
+
+    class UpdateCounter : public Observer {
+      public:
+        UpdateCounter() : counter_(0) {}
+        UpdateCounter(const UpdateCounter& other)
+        : Observer(other), counter_(other.counter()) {}
+        void update() override { ++counter_; }
+        Size counter() const { return counter_; }
+      private:
+        std::atomic<Size> counter_;
+    };
+
+    class Notifier : public Observable {
+      public:
+        using Observable::notifyObservers;
+    };
+
+}
+
+TEST_CASE("testObservableNotification", "[ObservableTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing observer notification...");
+
+    auto notifier = std::make_shared<Notifier>();
+    UpdateCounter counter1, counter2;
+    counter1.registerWith(notifier);
+    counter2.registerWith(notifier);
+
+    notifier->notifyObservers();
+    IF ((counter1.counter() != 1 || counter2.counter() != 1))
+        BOOST_FAIL("observers not notified");
+
+    counter2.unregisterWith(notifier);
+    notifier->notifyObservers();
+    IF ((counter1.counter() != 2 || counter2.counter() != 1))
+        BOOST_FAIL("unregistered observer notified");
+
+    // changes between notifications: only the last one counts
+    counter2.registerWith(notifier);
+    counter2.unregisterWith(notifier);
+    counter2.registerWith(notifier);
+    counter1.unregisterWith(notifier);
+    notifier->notifyObservers();
+    IF ((counter1.counter() != 2 || counter2.counter() != 2))
+        BOOST_FAIL("registration changes not applied");
+
+    // a copy is registered with the same observables
+    {
+        UpdateCounter copy(counter2);
+        notifier->notifyObservers();
+        IF ((copy.counter() != 3 || counter2.counter() != 3))
+            BOOST_FAIL("copied observer not notified");
+    }
+    // ...and unregistered when destroyed
+    notifier->notifyObservers();
+    IF (counter2.counter() != 4)
+        BOOST_FAIL("observer not notified after a copy was destroyed");
+
+    // many observers, enough to trigger the intermediate folding
+    // of the registrations in the copy-on-write pattern
+    std::vector<std::unique_ptr<UpdateCounter> > counters;
+    for (Size i = 0; i < 1000; ++i) {
+        counters.push_back(std::make_unique<UpdateCounter>());
+        counters.back()->registerWith(notifier);
+    }
+    for (Size i = 0; i < counters.size(); i += 2)
+        counters[i]->unregisterWith(notifier);
+    notifier->notifyObservers();
+    for (Size i = 0; i < counters.size(); ++i)
+        IF (counters[i]->counter() != i % 2)
+            BOOST_FAIL("observer " << i << " notified " << counters[i]->counter()
+                       << " times, expected " << i % 2);
+}
+
+TEST_CASE("testObservableDeferredUpdates", "[ObservableTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing deferred notifications...");
+
+    auto notifier = std::make_shared<Notifier>();
+    UpdateCounter counter;
+    counter.registerWith(notifier);
+
+    ObservableSettings::instance().disableUpdates(true);
+    notifier->notifyObservers();
+    notifier->notifyObservers();
+    IF (counter.counter() != 0)
+        BOOST_FAIL("observer notified while updates are deferred");
+    {
+        // observers destroyed meanwhile are not notified
+        UpdateCounter gone;
+        gone.registerWith(notifier);
+        notifier->notifyObservers();
+    }
+    ObservableSettings::instance().enableUpdates();
+    IF (counter.counter() != 1)
+        BOOST_FAIL("deferred updates delivered " << counter.counter()
+                   << " times, expected once");
+
+    ObservableSettings::instance().disableUpdates(false);
+    notifier->notifyObservers();
+    ObservableSettings::instance().enableUpdates();
+    IF (counter.counter() != 1)
+        BOOST_FAIL("observer notified while updates are disabled");
+}
+
+#if defined(QL_ENABLE_COPY_ON_WRITE_OBSERVER_PATTERN)
+
+TEST_CASE("testObservableConcurrentNotification", "[ObservableTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing concurrent notification and registration...");
+
+    auto notifier = std::make_shared<Notifier>();
+    UpdateCounter permanent;
+    permanent.registerWith(notifier);
+
+    const Size threads = 4, notifications = 2000;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> notifiers;
+    for (Size t = 0; t < threads; ++t) {
+        notifiers.emplace_back([&]() {
+            for (Size i = 0; i < notifications; ++i)
+                notifier->notifyObservers();
+        });
+    }
+    // observers come and go while notifications are under way; as
+    // required when they can be destroyed during a notification, they
+    // are held by shared pointers
+    std::thread registrar([&]() {
+        while (!done) {
+            auto transient = std::make_shared<UpdateCounter>();
+            transient->registerWith(notifier);
+            transient->unregisterWith(notifier);
+            auto destroyed = std::make_shared<UpdateCounter>();
+            destroyed->registerWith(notifier);
+        }
+    });
+    for (auto& t : notifiers)
+        t.join();
+    done = true;
+    registrar.join();
+
+    IF (permanent.counter() != threads * notifications)
+        BOOST_FAIL("permanent observer notified " << permanent.counter()
+                   << " times, expected " << threads * notifications);
+}
+
+#endif
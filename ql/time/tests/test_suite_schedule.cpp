@@ -18,12 +18,17 @@
 */
 
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
 //#include <ql/instruments/creditdefaultswap.hpp>
+#include <array>
 #include <map>
+#include <thread>
 #include <vector>
 #include "boost_to_catch.h"
 #include "pseudo_dates.h"
@@ -1083,6 +1088,164 @@ TEST_CASE("testTruncation", "[ScheduleTest][hide]") {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+TEST_CASE("testScheduleCache", "[ScheduleTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache<eDate> cache(2);
+    Calendar<eDate> calendar = TARGET<eDate>();
+    auto make = [&](Year maturity) {
+        return MakeSchedule<eDate>().from(DAe::Date(17, January, 2012))
+                                    .to(DAe::Date(17, January, maturity))
+                                    .withCalendar(calendar)
+                                    .withTenor(6*Months)
+                                    .withConvention(ModifiedFollowing);
+    };
+
+    auto s1 = make(2022).cached(cache);
+    auto s2 = make(2022).cached(cache);
+    BOOST_CHECK(s1 == s2);
+    BOOST_CHECK(cache.hits() == 1);
+    BOOST_CHECK(cache.misses() == 1);
+    BOOST_CHECK(cache.size() == 1);
+    Schedule<eDate> uncached = make(2022);
+    BOOST_REQUIRE(s1->size() == uncached.size());
+    for (Size i = 0; i < uncached.size(); ++i)
+        IF ((*s1)[i] != to_DateLike(uncached[i]));
+
+    // least recently used schedules are dropped
+    auto s3 = make(2023).cached(cache);
+    make(2022).cached(cache);
+    make(2024).cached(cache);
+    BOOST_CHECK(cache.size() == 2);
+    BOOST_CHECK(make(2022).cached(cache) == s1);
+    BOOST_CHECK(make(2023).cached(cache) != s3);
+    BOOST_CHECK(cache.hits() == 3);
+    BOOST_CHECK(cache.misses() == 4);
+
+    // modified calendars invalidate the cached schedules
+    eDate holiday = DAe::Date(17, July, 2012);
+    calendar.addHoliday(holiday);
+    auto s4 = make(2022).cached(cache);
+    calendar.removeHoliday(holiday);
+    BOOST_CHECK(s4 != s1);
+    BOOST_CHECK(s4->date(1) == to_DateLike(DAe::Date(18, July, 2012)));
+    BOOST_CHECK(s1->date(1) == to_DateLike(holiday));
+    BOOST_CHECK(cache.misses() == 5);
+
+    // calendars with the same name don't share schedules
+    BespokeCalendar<eDate> weekends("bespoke"), sundays("bespoke");
+    weekends.addWeekend(Saturday);
+    weekends.addWeekend(Sunday);
+    sundays.addWeekend(Sunday);
+    calendar = weekends;
+    auto s5 = make(2022).cached(cache);
+    calendar = sundays;
+    auto s6 = make(2022).cached(cache);
+    BOOST_CHECK(s5 != s6);
+    BOOST_CHECK(s5->date(6) == to_DateLike(DAe::Date(19, January, 2015)));
+    BOOST_CHECK(s6->date(6) == to_DateLike(DAe::Date(17, January, 2015)));
+
+    // so do modifications to the members of joint calendars
+    calendar = JointCalendar<eDate>(TARGET<eDate>(), sundays);
+    auto s7 = make(2022).cached(cache);
+    BOOST_CHECK(make(2022).cached(cache) == s7);
+    sundays.addHoliday(holiday);
+    auto s8 = make(2022).cached(cache);
+    BOOST_CHECK(s8 != s7);
+    BOOST_CHECK(s8->date(1) == to_DateLike(DAe::Date(18, July, 2012)));
+    calendar = TARGET<eDate>();
+
+    cache.clear();
+    cache.resetCounters();
+    BOOST_CHECK(cache.size() == 0);
+
+    // concurrent requests share the same schedules
+    const Size threads = 4;
+    std::vector<std::vector<std::shared_ptr<const Schedule<eDate> > > > results(threads);
+    std::vector<std::thread> workers;
+    for (Size t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (Size i = 0; i < 100; ++i)
+                results[t].push_back(make(2022 + Year(i % 2)).cached(cache));
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    BOOST_CHECK(cache.hits() + cache.misses() == threads * 100);
+    BOOST_CHECK(cache.size() == 2);
+    for (Size t = 0; t < threads; ++t)
+        for (Size i = 0; i < 100; ++i)
+            IF (results[t][i] != results[t][i % 2]);
+
+    CHECK_THROWS(ScheduleCache<eDate>(0));
+}
+
+TEST_CASE("testCallerStorageGeneration", "[ScheduleTest][hide]") {
+    BOOST_TEST_MESSAGE("Testing schedule generation into caller storage...");
+
+    struct Case {
+        Period tenor;
+        DateGeneration::Rule rule;
+        BusinessDayConvention convention;
+        bool endOfMonth;
+        bool stubs;
+    };
+    const Case cases[] = {
+        { 6*Months, DateGeneration::Backward, ModifiedFollowing, false, false },
+        { 6*Months, DateGeneration::Backward, ModifiedFollowing, true, true },
+        { 3*Months, DateGeneration::Forward, Following, false, true },
+        { 1*Years, DateGeneration::Forward, Unadjusted, true, false },
+        { 1*Months, DateGeneration::Backward, Preceding, false, false },
+        { 2*Weeks, DateGeneration::Forward, Following, false, false },
+        { 10*Days, DateGeneration::Backward, Following, false, false },
+        { 3*Months, DateGeneration::CDS2015, Following, false, false },
+        { 3*Months, DateGeneration::OldCDS, Following, false, false },
+        { 3*Months, DateGeneration::TwentiethIMM, Following, false, false },
+        { 3*Months, DateGeneration::ThirdWednesday, Following, false, false },
+        { 0*Days, DateGeneration::Zero, Following, false, false },
+    };
+
+    Calendar<eDate> calendar = TARGET<eDate>();
+    std::array<eDate, 256> dates;
+    std::array<bool, 255> isRegular;
+    for (const Case& c : cases) {
+        for (serial_type offset = 0; offset < 400; offset += 7) {
+            eDate start = (DLe(DAe::Date(3, January, 2011)) + offset).asExtDate();
+            eDate end = (DLe(start) + 5*Years + 17).asExtDate();
+            eDate first, nextToLast;
+            if (c.stubs) {
+                first = (DLe(start) + 2*Months).asExtDate();
+                nextToLast = (DLe(end) - 2*Months).asExtDate();
+            }
+
+            Schedule<eDate> expected(start, end, c.tenor, calendar, c.convention,
+                                     c.convention, c.rule, c.endOfMonth,
+                                     first, nextToLast);
+            Size bound = maxScheduleSize(start, end, c.tenor, c.rule, first, nextToLast);
+            BOOST_REQUIRE(bound <= dates.size());
+            BOOST_CHECK(expected.size() <= bound);
+
+            Size n = generateSchedule(std::span<eDate>(dates.data(), bound),
+                                      std::span<bool>(isRegular),
+                                      start, end, c.tenor, calendar, c.convention,
+                                      c.convention, c.rule, c.endOfMonth,
+                                      first, nextToLast);
+            BOOST_REQUIRE(n == expected.size());
+            for (Size i = 0; i < n; ++i)
+                IF (expected[i] != to_DateLike(dates[i]));
+            for (Size i = 0; i + 1 < n; ++i)
+                IF (expected.isRegular(i + 1) != isRegular[i]);
+        }
+    }
+
+    // insufficient storage is reported, not overrun
+    CHECK_THROWS(generateSchedule(std::span<eDate>(dates.data(), 4),
+                                  std::span<bool>(isRegular),
+                                  DAe::Date(3, January, 2011), DAe::Date(3, January, 2021),
+                                  Period(6, Months), calendar, Following, Following,
+                                  DateGeneration::Forward, false));
+}
+
 //test_suite* ScheduleTest::suite() {
 //    test_suite* suite = BOOST_TEST_SUITE("Schedule<eDate> tests");
 //    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDailySchedule));
@@ -29,8 +29,13 @@
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
 #include <ql/functional.hpp>
+#include <boost/container/flat_map.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/utility.hpp>
 #include <map>
 #include <vector>
@@ -45,6 +50,8 @@ namespace QuantLib {
 
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
+
+        \see FlatTimeSeries for a series stored in contiguous memory.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -103,6 +110,14 @@ namespace QuantLib {
                 values_[d] = Null<T>();
             return values_[d];
         }
+        //! adds a datum after the last one
+        /*! This takes constant time for ordered containers, instead
+            of the logarithmic time taken by operator[].
+
+            \pre the date must be later than the last date in the
+                 series.
+        */
+        void append(const Date& d, const T& value);
         //@}
 
         //! \name Iterators
@@ -238,6 +253,20 @@ namespace QuantLib {
     };
 
 
+    //! time series stored in contiguous memory
+    /*! The data are kept as a vector of (date, datum) pairs sorted
+        by date.  Lookups take logarithmic time, as for the default
+        std::map container; append() takes amortized constant time,
+        while inserting data before the last date takes linear time.
+        Iteration runs over contiguous memory, and the
+        functions in <ql/math/statistics/timeseriesstatistics.hpp>
+        read the data in place from the stored pairs instead of
+        copying them.
+    */
+    template <class T>
+    using FlatTimeSeries = TimeSeries<T, boost::container::flat_map<Date, T> >;
+
+
     // inline definitions
 
     template <class T, class C>
@@ -274,6 +303,14 @@ namespace QuantLib {
         return values_.end();
     }
 
+    template <class T, class C>
+    inline void TimeSeries<T,C>::append(const Date& d, const T& value) {
+        QL_REQUIRE(values_.empty() || lastDate() < d,
+                   "date " << d << " is not after the last date "
+                   "in the time series (" << lastDate() << ")");
+        values_.insert(values_.end(), std::make_pair(d, value));
+    }
+
     template <class T, class C>
     inline typename TimeSeries<T,C>::const_iterator
     TimeSeries<T,C>::find(const Date& d) {
@@ -46,6 +46,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/pricingengines/bond/batchbondfunctions.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -375,6 +376,159 @@ void BondTest::testZspread() {
     }
 }
 
+void BondTest::testBatchFunctions() {
+
+    BOOST_TEST_MESSAGE("Testing batch bond functions against BondFunctions...");
+
+    using namespace bonds_test;
+
+    CommonVars vars;
+
+    Handle<YieldTermStructure> discountCurve(
+                                       flatRate(vars.today,0.03,Actual360()));
+
+    Integer issueMonths[] = { -24, -12, -6, 0, 12 };
+    Integer lengths[] = { 3, 5, 10, 20 };
+    Natural settlementDays = 3;
+    Real coupons[] = { 0.02, 0.05, 0.08 };
+    Frequency frequencies[] = { Semiannual, Annual };
+    Compounding compounding[] = { Compounded, Continuous };
+    DayCounter bondDayCount = Thirty360();
+    Real redemption = 100.0;
+
+    std::vector<ext::shared_ptr<Bond> > bonds;
+    std::vector<Frequency> bondFrequencies;
+    std::vector<Compounding> bondCompoundings;
+    BatchBondFunctions batch(4);
+
+    for (Size i=0; i<LENGTH(issueMonths); i++) {
+      for (Size j=0; j<LENGTH(lengths); j++) {
+        for (Size k=0; k<LENGTH(coupons); k++) {
+          for (Size l=0; l<LENGTH(frequencies); l++) {
+            for (Size n=0; n<LENGTH(compounding); n++) {
+              Date issue = vars.calendar.advance(vars.today,
+                                                 issueMonths[i], Months);
+              Date maturity = vars.calendar.advance(issue,
+                                                    lengths[j], Years);
+              Schedule sch(issue, maturity, Period(frequencies[l]),
+                           vars.calendar, Unadjusted, Unadjusted,
+                           DateGeneration::Backward, false);
+              ext::shared_ptr<Bond> bond(
+                  new FixedRateBond(settlementDays, vars.faceAmount, sch,
+                                    std::vector<Rate>(1, coupons[k]),
+                                    bondDayCount, ModifiedFollowing,
+                                    redemption, issue));
+              Size position = batch.add(*bond, bondDayCount,
+                                        compounding[n], frequencies[l]);
+              if (position != bonds.size())
+                  BOOST_ERROR("wrong position " << position <<
+                              " returned for bond #" << bonds.size());
+              bonds.push_back(bond);
+              bondFrequencies.push_back(frequencies[l]);
+              bondCompoundings.push_back(compounding[n]);
+            }
+          }
+        }
+      }
+    }
+
+    std::vector<Rate> yields(bonds.size());
+    std::vector<Spread> spreads(bonds.size());
+    for (Size i=0; i<bonds.size(); ++i) {
+        yields[i] = 0.01 + 0.0002*i;
+        spreads[i] = -0.01 + 0.0001*i;
+    }
+
+    std::vector<Real> prices = batch.cleanPrice(yields);
+    std::vector<Real> dirtyPrices = batch.dirtyPrice(yields);
+    std::vector<Rate> impliedYields = batch.yield(prices);
+    std::vector<Time> durations = batch.duration(yields);
+    std::vector<Real> convexities = batch.convexity(yields);
+    std::vector<Real> spreadedPrices =
+        batch.cleanPrice(*discountCurve, spreads);
+    std::vector<Spread> zSpreads =
+        batch.zSpread(spreadedPrices, *discountCurve);
+
+    for (Size i=0; i<bonds.size(); ++i) {
+        const Bond& bond = *bonds[i];
+        Compounding comp = bondCompoundings[i];
+        Frequency freq = bondFrequencies[i];
+
+        Real expectedPrice = BondFunctions::cleanPrice(bond, yields[i],
+                                                       bondDayCount,
+                                                       comp, freq);
+        Real expectedDirtyPrice = BondFunctions::dirtyPrice(bond, yields[i],
+                                                            bondDayCount,
+                                                            comp, freq);
+        Rate expectedYield = BondFunctions::yield(bond, prices[i],
+                                                  bondDayCount, comp, freq);
+        Time expectedDuration = BondFunctions::duration(bond, yields[i],
+                                                        bondDayCount,
+                                                        comp, freq);
+        Real expectedConvexity = BondFunctions::convexity(bond, yields[i],
+                                                          bondDayCount,
+                                                          comp, freq);
+        Real expectedSpreadedPrice =
+            BondFunctions::cleanPrice(bond, *discountCurve, spreads[i],
+                                      bondDayCount, comp, freq);
+        Spread expectedZSpread =
+            BondFunctions::zSpread(bond, spreadedPrices[i], *discountCurve,
+                                   bondDayCount, comp, freq);
+
+        if (prices[i] != expectedPrice
+            || dirtyPrices[i] != expectedDirtyPrice
+            || impliedYields[i] != expectedYield
+            || durations[i] != expectedDuration
+            || convexities[i] != expectedConvexity
+            || spreadedPrices[i] != expectedSpreadedPrice
+            || zSpreads[i] != expectedZSpread)
+            BOOST_ERROR("batch results differ for bond #" << i <<
+                        std::setprecision(17) <<
+                        "\n    clean price:   " << prices[i] <<
+                        " instead of " << expectedPrice <<
+                        "\n    dirty price:   " << dirtyPrices[i] <<
+                        " instead of " << expectedDirtyPrice <<
+                        "\n    yield:         " << impliedYields[i] <<
+                        " instead of " << expectedYield <<
+                        "\n    duration:      " << durations[i] <<
+                        " instead of " << expectedDuration <<
+                        "\n    convexity:     " << convexities[i] <<
+                        " instead of " << expectedConvexity <<
+                        "\n    Z-spread price: " << spreadedPrices[i] <<
+                        " instead of " << expectedSpreadedPrice <<
+                        "\n    Z-spread:      " << zSpreads[i] <<
+                        " instead of " << expectedZSpread);
+    }
+
+    // missing quotes give missing results
+    prices[0] = Null<Real>();
+    impliedYields = batch.yield(prices);
+    if (impliedYields[0] != Null<Rate>())
+        BOOST_ERROR("yield returned for missing price: " << impliedYields[0]);
+    if (impliedYields[1] == Null<Rate>())
+        BOOST_ERROR("no yield returned for available price");
+    if (!batch.errors()[0].empty())
+        BOOST_ERROR("error reported for missing price: "
+                    << batch.errors()[0]);
+
+    // failed calculations give missing results and the reason
+    prices[1] = -100.0;
+    impliedYields = batch.yield(prices);
+    if (impliedYields[1] != Null<Rate>())
+        BOOST_ERROR("yield returned for negative price: "
+                    << impliedYields[1]);
+    if (batch.errors()[1].empty())
+        BOOST_ERROR("no error reported for negative price");
+    if (!batch.errors()[2].empty())
+        BOOST_ERROR("error reported for available price: "
+                    << batch.errors()[2]);
+
+    // clearing the bonds clears their errors as well
+    batch.clear();
+    if (!batch.errors().empty())
+        BOOST_ERROR(batch.errors().size() << " errors left after clear()");
+}
+
 
 
 void BondTest::testTheoretical() {
@@ -1747,6 +1901,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testYield));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testAtmRate));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testZspread));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatchFunctions));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testTheoretical));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testCached));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testCachedZero));
@@ -30,6 +30,7 @@ class BondTest {
     static void testYield();
     static void testAtmRate();
     static void testZspread();
+    static void testBatchFunctions();
     static void testTheoretical();
     static void testCached();
     static void testCachedZero();
@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -504,6 +505,144 @@ void CashFlowsTest::testPartialScheduleLegConstruction() {
     BOOST_CHECK_EQUAL(lastCpnF3->referencePeriodEnd(), Date(30, Sep, 2020));
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing compiled legs...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    Date settlementDate = today + 2;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(Date(10, November, 2016)).to(Date(10, November, 2026))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Unadjusted)
+        .backwards();
+    DayCounter dayCounter = ActualActual(ActualActual::ISMA);
+
+    Leg leg = FixedRateLeg(schedule)
+              .withNotionals(100.0)
+              .withCouponRates(0.045, dayCounter)
+              .withExCouponPeriod(Period(2, Months), TARGET(), Preceding);
+    leg.push_back(ext::shared_ptr<CashFlow>(
+                      new SimpleCashFlow(100.0, schedule.endDate())));
+
+    CompiledLeg compiledLeg(leg, dayCounter, false, settlementDate);
+
+    // the coupon paid on May 10th, 2018 is trading ex-coupon
+    Size stored = 0, exCoupon = 0;
+    for (Size i=0; i<leg.size(); ++i) {
+        if (!leg[i]->hasOccurred(settlementDate, false)) {
+            ++stored;
+            if (leg[i]->tradingExCoupon(settlementDate))
+                ++exCoupon;
+        }
+    }
+    if (compiledLeg.size() != stored)
+        BOOST_FAIL("wrong number of compiled cash flows: "
+                   << compiledLeg.size() << " instead of " << stored);
+    if (exCoupon != 1 || compiledLeg.amounts().front() != 0.0 ||
+        compiledLeg.accrualNominals().front() != 0.0)
+        BOOST_ERROR("ex-coupon cash flow not compiled with null amount");
+    if (compiledLeg.accrualNominals().back() != 0.0)
+        BOOST_ERROR("redemption compiled with non-null accrual nominal");
+
+    Real tolerance = 1.0e-10;
+
+    // term-structure functions
+    ext::shared_ptr<YieldTermStructure> curve =
+        flatRate(today, 0.04, Actual365Fixed());
+    Real npv = CashFlows::npv(leg, *curve, false, settlementDate);
+    Real bps = CashFlows::bps(leg, *curve, false, settlementDate);
+    Real compiledNpv, compiledBps;
+    compiledLeg.npvbps(*curve, compiledNpv, compiledBps);
+    if (std::fabs(compiledLeg.npv(*curve) - npv) > tolerance ||
+        std::fabs(compiledNpv - npv) > tolerance)
+        BOOST_ERROR("compiled NPV does not match:"
+                    << "\n    compiled:  " << compiledLeg.npv(*curve)
+                    << "\n    npvbps:    " << compiledNpv
+                    << "\n    expected:  " << npv);
+    if (std::fabs(compiledLeg.bps(*curve) - bps) > tolerance ||
+        std::fabs(compiledBps - bps) > tolerance)
+        BOOST_ERROR("compiled BPS does not match:"
+                    << "\n    compiled:  " << compiledLeg.bps(*curve)
+                    << "\n    npvbps:    " << compiledBps
+                    << "\n    expected:  " << bps);
+
+    // yield functions
+    Compounding compounding = Compounded;
+    Frequency frequency = Semiannual;
+    Real price = 104.0;
+    Rate yield = compiledLeg.yield(price, compounding, frequency);
+    Rate expectedYield = CashFlows::yield(leg, price, dayCounter,
+                                          compounding, frequency, false,
+                                          settlementDate);
+    if (std::fabs(yield - expectedYield) > tolerance)
+        BOOST_ERROR("compiled yield does not match:"
+                    << "\n    compiled:  " << yield
+                    << "\n    expected:  " << expectedYield);
+    Real P = compiledLeg.npv(yield, compounding, frequency);
+    if (std::fabs(P - price) > 1.0e-6)
+        BOOST_ERROR("NPV at the compiled yield does not match the price:"
+                    << "\n    NPV:    " << P
+                    << "\n    price:  " << price);
+
+    Spread h = 1.0e-5;
+    Real up = compiledLeg.npv(yield+h, compounding, frequency),
+         down = compiledLeg.npv(yield-h, compounding, frequency);
+    Real duration = compiledLeg.duration(yield, compounding, frequency,
+                                         Duration::Modified);
+    Real expectedDuration = -(up-down)/(2.0*h*P);
+    if (std::fabs(duration - expectedDuration) > 1.0e-6)
+        BOOST_ERROR("compiled duration does not match:"
+                    << "\n    compiled:    " << duration
+                    << "\n    numerical:   " << expectedDuration);
+    Real convexity = compiledLeg.convexity(yield, compounding, frequency);
+    Real expectedConvexity = (up-2.0*P+down)/(h*h*P);
+    if (std::fabs(convexity - expectedConvexity) > 1.0e-3)
+        BOOST_ERROR("compiled convexity does not match:"
+                    << "\n    compiled:    " << convexity
+                    << "\n    numerical:   " << expectedConvexity);
+    if (std::fabs(CashFlows::duration(leg, yield, dayCounter, compounding,
+                                      frequency, Duration::Modified, false,
+                                      settlementDate) - duration) > tolerance)
+        BOOST_ERROR("compiled duration does not match CashFlows");
+    if (std::fabs(CashFlows::convexity(leg, yield, dayCounter, compounding,
+                                       frequency, false,
+                                       settlementDate) - convexity)
+        > tolerance)
+        BOOST_ERROR("compiled convexity does not match CashFlows");
+
+    // the Z-spread doesn't use the day counter, which can be empty
+    Spread zSpread = CashFlows::zSpread(leg, npv - 1.0, curve, dayCounter,
+                                        compounding, frequency, false,
+                                        settlementDate);
+    Spread zSpreadWithoutDayCounter =
+        CashFlows::zSpread(leg, npv - 1.0, curve, DayCounter(),
+                           compounding, frequency, false, settlementDate);
+    if (zSpreadWithoutDayCounter != zSpread)
+        BOOST_ERROR("Z-spread depends on the day counter:"
+                    << "\n    with day counter:     " << zSpread
+                    << "\n    without day counter:  "
+                    << zSpreadWithoutDayCounter);
+
+    // an empty leg has null duration whatever the rate...
+    if (CashFlows::duration(Leg(), yield, dayCounter, Continuous,
+                            NoFrequency, Duration::Macaulay, false,
+                            settlementDate) != 0.0)
+        BOOST_ERROR("non-null duration for empty leg");
+    // ...but a leg whose cash flows have all occurred still requires
+    // a compounded rate for Macaulay duration
+    Date afterMaturity = CashFlows::maturityDate(leg) + 1;
+    BOOST_CHECK_THROW(CashFlows::duration(leg, yield, dayCounter, Continuous,
+                                          NoFrequency, Duration::Macaulay,
+                                          false, afterMaturity),
+                      Error);
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -519,5 +658,6 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testPartialScheduleLegConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
     return suite;
 }
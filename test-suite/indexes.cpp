@@ -22,6 +22,7 @@
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/bmaindex.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <cstdio>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -64,9 +65,177 @@ void IndexTest::testFixingObservability() {
 }
 
 
+namespace {
+
+    // removes the file after the histories, and the mapping, are gone
+    struct FileRemover {
+        explicit FileRemover(const std::string& path) : path(path) {}
+        ~FileRemover() { std::remove(path.c_str()); }
+        std::string path;
+    };
+
+}
+
+void IndexTest::testFixingStore() {
+    BOOST_TEST_MESSAGE("Testing storage and retrieval of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, June, 2018);
+    Settings::instance().evaluationDate() = today;
+    ext::shared_ptr<InterestRateIndex> euribor = ext::make_shared<Euribor6M>();
+    Calendar calendar = euribor->fixingCalendar();
+
+    // a year of fixings, added in overlapping chunks in both
+    // chronological and reverse order
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = calendar.advance(today, -1, Days);
+         dates.size() < 250; d = calendar.advance(d, -1, Days)) {
+        dates.push_back(d);
+        values.push_back(0.01 + 0.0001*dates.size());
+    }
+    euribor->addFixings(dates.begin(), dates.begin() + 100,
+                        values.begin());
+    euribor->addFixings(dates.rbegin(), dates.rbegin() + 150,
+                        values.rbegin());
+    euribor->addFixings(dates.begin() + 50, dates.begin() + 150,
+                        values.begin() + 50);
+
+    const TimeSeries<Real>& history = euribor->timeSeries();
+    if (history.size() != dates.size())
+        BOOST_FAIL("stored " << history.size() << " fixings; "
+                   << dates.size() << " expected");
+    for (Size i=0; i<dates.size(); ++i) {
+        Real fixing = euribor->fixing(dates[i]);
+        if (fixing != values[i] || history[dates[i]] != values[i])
+            BOOST_ERROR("wrong fixing stored for " << dates[i] << ":"
+                        << "\n    stored:      " << fixing
+                        << "\n    time series: " << history[dates[i]]
+                        << "\n    expected:    " << values[i]);
+    }
+    if (history.firstDate() != dates.back() ||
+        history.lastDate() != dates.front())
+        BOOST_ERROR("wrong first or last date in time series");
+
+    // a different fixing at a stored date is rejected...
+    BOOST_CHECK_THROW(euribor->addFixing(dates[10], 0.5), Error);
+    if (euribor->fixing(dates[10]) != values[10])
+        BOOST_ERROR("stored fixing overwritten");
+    // ...unless the overwrite is forced
+    euribor->addFixing(dates[10], 0.5, true);
+    if (euribor->fixing(dates[10]) != 0.5 ||
+        euribor->timeSeries()[dates[10]] != 0.5)
+        BOOST_ERROR("stored fixing not overwritten");
+    // repeated dates in the same call are checked as well
+    Date repeated[] = { today, today };
+    Real different[] = { 0.02, 0.03 };
+    BOOST_CHECK_THROW(euribor->addFixings(repeated, repeated + 2, different),
+                      Error);
+    if (euribor->fixing(today) != 0.02)
+        BOOST_ERROR("first of repeated fixings not stored");
+
+    // fixings are shared by indexes with the same name
+    ext::shared_ptr<InterestRateIndex> other = ext::make_shared<Euribor6M>();
+    if (other->fixing(dates[20]) != values[20])
+        BOOST_ERROR("fixing not available to other instance of index");
+
+    euribor->clearFixings();
+    if (!euribor->timeSeries().empty())
+        BOOST_ERROR("fixings not cleared");
+    BOOST_CHECK_THROW(other->fixing(dates[20]), Error);
+
+    // fixings added by id after clearing the history are stored again
+    IndexManager& manager = IndexManager::instance();
+    Size id = manager.historyId(euribor->name());
+    manager.clearHistory(euribor->name());
+    manager.addFixings(id, dates, values);
+    if (!manager.hasHistory(euribor->name()))
+        BOOST_FAIL("fixings added by id after clearing the history "
+                   "not reported");
+    const std::string path = "quantlib-fixings-store.snapshot";
+    FileRemover remover(path);
+    manager.writeSnapshot(path);
+    manager.clearHistories();
+    manager.loadSnapshot(path);
+    for (Size i=0; i<dates.size(); ++i) {
+        if (euribor->fixing(dates[i]) != values[i])
+            BOOST_ERROR("wrong fixing read for " << dates[i] << ":"
+                        << "\n    read:     " << euribor->fixing(dates[i])
+                        << "\n    expected: " << values[i]);
+    }
+}
+
+
+void IndexTest::testFixingSnapshot() {
+    BOOST_TEST_MESSAGE("Testing index fixings read from a snapshot...");
+
+    const std::string path = "quantlib-fixings.snapshot";
+    FileRemover remover(path);
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, June, 2018);
+    Settings::instance().evaluationDate() = today;
+    ext::shared_ptr<InterestRateIndex> euribor = ext::make_shared<Euribor6M>();
+    Calendar calendar = euribor->fixingCalendar();
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = calendar.advance(today, -100, Days); d < today;
+         d = calendar.advance(d, 1, Days)) {
+        dates.push_back(d);
+        values.push_back(0.01 + 0.0001*dates.size());
+    }
+    euribor->addFixings(dates.begin(), dates.end(), values.begin());
+
+    IndexManager::instance().writeSnapshot(path);
+    euribor->clearFixings();
+
+    Flag flag;
+    flag.registerWith(euribor);
+    IndexManager::instance().loadSnapshot(path);
+    if (!flag.isUp())
+        BOOST_ERROR("Observer was not notified of fixings read from snapshot");
+
+    for (Size i=0; i<dates.size(); ++i) {
+        if (euribor->fixing(dates[i]) != values[i])
+            BOOST_ERROR("wrong fixing read for " << dates[i] << ":"
+                        << "\n    read:     " << euribor->fixing(dates[i])
+                        << "\n    expected: " << values[i]);
+    }
+
+    // fixings added later take precedence
+    euribor->addFixing(dates[5], 0.5, true);
+    euribor->addFixing(today, 0.25);
+    if (euribor->fixing(dates[5]) != 0.5 || euribor->fixing(dates[6]) != values[6])
+        BOOST_ERROR("fixing overwritten after reading snapshot not retrieved");
+    if (euribor->fixing(today) != 0.25)
+        BOOST_ERROR("fixing added after reading snapshot not retrieved");
+    const TimeSeries<Real>& history = euribor->timeSeries();
+    if (history.size() != dates.size()+1 || history[dates[5]] != 0.5 ||
+        history[today] != 0.25 || history[dates[7]] != values[7])
+        BOOST_ERROR("wrong time series after reading snapshot");
+
+    // reading the snapshot again replaces the histories, and releases
+    // the previous mapping; the file written above passes the
+    // optional check of the fixing dates
+    IndexManager::instance().loadSnapshot(path);
+    IndexManager::instance().loadSnapshot(path, true);
+    if (euribor->fixing(dates[5]) != values[5] ||
+        euribor->fixing(dates[6]) != values[6])
+        BOOST_ERROR("wrong fixing read after reloading snapshot");
+    if (euribor->timeSeries().size() != dates.size())
+        BOOST_ERROR("wrong time series after reloading snapshot");
+}
+
+
 test_suite* IndexTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("index tests");
     suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingObservability));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingStore));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingSnapshot));
     return suite;
 }
 
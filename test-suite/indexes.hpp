@@ -28,6 +28,8 @@
 class IndexTest {
   public:
     static void testFixingObservability();
+    static void testFixingStore();
+    static void testFixingSnapshot();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -20,6 +20,7 @@
 #include "lazyobject.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/patterns/lazyobjectscheduler.hpp>
 #include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
@@ -80,12 +81,134 @@ void LazyObjectTest::testForwardingNotifications() {
 }
 
 
+namespace {
+
+    // sums its quote and the values of the lazy objects it depends on
+    class Sum : public LazyObject {
+      public:
+        Sum(const Handle<Quote>& quote,
+            const std::vector<ext::shared_ptr<Sum> >& terms =
+                                        std::vector<ext::shared_ptr<Sum> >())
+        : quote_(quote), terms_(terms), calculations_(0), failing_(false),
+          outOfOrder_(false) {
+            registerWith(quote_);
+            for (Size i=0; i<terms_.size(); ++i)
+                registerWith(terms_[i]);
+        }
+        Real value() const {
+            calculate();
+            return value_;
+        }
+        Size calculations() const { return calculations_; }
+        bool outOfOrder() const { return outOfOrder_; }
+        void fail(bool failing) {
+            failing_ = failing;
+            update();
+        }
+      private:
+        void performCalculations() const {
+            ++calculations_;
+            QL_REQUIRE(!failing_, "failing on purpose");
+            value_ = quote_->value();
+            for (Size i=0; i<terms_.size(); ++i) {
+                // the scheduler should calculate the terms first
+                if (terms_[i]->calculations() == 0)
+                    outOfOrder_ = true;
+                value_ += terms_[i]->value();
+            }
+        }
+        Handle<Quote> quote_;
+        std::vector<ext::shared_ptr<Sum> > terms_;
+        mutable Size calculations_;
+        mutable Real value_;
+        bool failing_;
+        mutable bool outOfOrder_;
+    };
+
+}
+
+void LazyObjectTest::testParallelRecalculation() {
+
+    BOOST_TEST_MESSAGE("Testing parallel recalculation of lazy objects...");
+
+    // a common base, many independent curves on top of it, and
+    // a total depending on all of them
+    ext::shared_ptr<SimpleQuote> baseQuote(new SimpleQuote(1.0));
+    ext::shared_ptr<Sum> base(new Sum(Handle<Quote>(baseQuote)));
+
+    const Size n = 100;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<Sum> > curves;
+    for (Size i=0; i<n; ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(Real(i)));
+        // reached through a relinkable handle, as usual
+        RelinkableHandle<Quote> h(quotes.back());
+        curves.push_back(ext::make_shared<Sum>(
+            h, std::vector<ext::shared_ptr<Sum> >(1, base)));
+    }
+    ext::shared_ptr<Sum> total(new Sum(Handle<Quote>(baseQuote), curves));
+
+    LazyObjectScheduler scheduler(4);
+    scheduler.add(total);
+    for (Size i=0; i<n; i+=10)
+        scheduler.add(curves[i]);
+
+    Size calculated = scheduler.calculate();
+    if (calculated != n+2)
+        BOOST_ERROR("calculated " << calculated << " objects, "
+                    << n+2 << " expected");
+    if (base->calculations() != 1 || total->calculations() != 1)
+        BOOST_ERROR("base and total calculated "
+                    << base->calculations() << " and "
+                    << total->calculations() << " times");
+    for (Size i=0; i<n; ++i) {
+        if (curves[i]->calculations() != 1 || curves[i]->outOfOrder())
+            BOOST_ERROR("curve #" << i << " calculated "
+                        << curves[i]->calculations() << " times"
+                        << (curves[i]->outOfOrder() ? " before its base" : ""));
+    }
+    if (total->outOfOrder())
+        BOOST_ERROR("total calculated before its terms");
+    Real expected = 1.0 + n*1.0 + n*(n-1)/2.0;
+    if (std::fabs(total->value() - expected) > 1.0e-12)
+        BOOST_ERROR("wrong total: " << total->value()
+                    << " instead of " << expected);
+
+    // nothing to do until something changes...
+    calculated = scheduler.calculate();
+    if (calculated != 0)
+        BOOST_ERROR("recalculated " << calculated << " objects "
+                    "with no changes");
+
+    // ...and then only the affected objects are recalculated
+    quotes[7]->setValue(1000.0);
+    calculated = scheduler.calculate();
+    if (calculated != 2 || curves[7]->calculations() != 2 ||
+        total->calculations() != 2 || curves[8]->calculations() != 1)
+        BOOST_ERROR("recalculated " << calculated << " objects "
+                    "after a single change; 2 expected");
+
+    // failures propagate to the dependent objects
+    curves[3]->fail(true);
+    BOOST_CHECK_THROW(scheduler.calculate(), Error);
+    if (total->calculations() != 2)
+        BOOST_ERROR("object depending on a failed one was calculated");
+    curves[3]->fail(false);
+    calculated = scheduler.calculate();
+    if (calculated != 2)
+        BOOST_ERROR("recalculated " << calculated << " objects "
+                    "after a failure; 2 expected");
+}
+
+
 test_suite* LazyObjectTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("LazyObject tests");
     suite->add(
         QUANTLIB_TEST_CASE(&LazyObjectTest::testDiscardingNotifications));
     suite->add(
         QUANTLIB_TEST_CASE(&LazyObjectTest::testForwardingNotifications));
+    suite->add(
+        QUANTLIB_TEST_CASE(&LazyObjectTest::testParallelRecalculation));
     return suite;
 }
 
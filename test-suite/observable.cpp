@@ -20,6 +20,7 @@
 #include "observable.hpp"
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
@@ -324,6 +325,192 @@ void ObservableTest::testEmptyObserverList() {
     dummyObserver->unregisterWith(ext::make_shared<SimpleQuote>(10.0));
 }
 
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+namespace {
+
+    class CountingLazyObject : public LazyObject {
+      public:
+        CountingLazyObject() : updates_(0) {}
+        void update() {
+            ++updates_;
+            LazyObject::update();
+        }
+        void performCalculations() const {}
+        void recalculate() { calculate(); }
+        bool isCalculated() const { return calculated_; }
+        Size updates() const { return updates_; }
+      private:
+        Size updates_;
+    };
+
+    // checks that the curve was invalidated before this is updated
+    class OrderChecker : public Observer {
+      public:
+        explicit OrderChecker(const ext::shared_ptr<CountingLazyObject>& curve)
+        : curve_(curve), updates_(0), outOfOrder_(0) {}
+        void update() {
+            ++updates_;
+            if (curve_->isCalculated())
+                ++outOfOrder_;
+        }
+        Size updates() const { return updates_; }
+        Size outOfOrder() const { return outOfOrder_; }
+      private:
+        ext::shared_ptr<CountingLazyObject> curve_;
+        Size updates_, outOfOrder_;
+    };
+
+}
+
+void ObservableTest::testUpdateBatch() {
+
+    BOOST_TEST_MESSAGE("Testing notifications from update batches...");
+
+    RestoreUpdates guard;
+
+    // quotes -> helpers -> curve -> counter, as in a bootstrap
+    const Size n = 100;
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<CountingLazyObject> > helpers;
+    ext::shared_ptr<CountingLazyObject> curve =
+        ext::make_shared<CountingLazyObject>();
+    curve->alwaysForwardNotifications();
+    for (Size i=0; i<n; ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(1.0));
+        helpers.push_back(ext::make_shared<CountingLazyObject>());
+        helpers[i]->registerWith(quotes[i]);
+        curve->registerWith(helpers[i]);
+    }
+    UpdateCounter counter;
+    counter.registerWith(curve);
+    // observes both ends of the chain
+    OrderChecker checker(curve);
+    checker.registerWith(quotes[0]);
+    checker.registerWith(curve);
+
+    for (Size i=0; i<n; ++i)
+        helpers[i]->recalculate();
+    curve->recalculate();
+    Size curveUpdates = curve->updates(), counted = counter.counter();
+
+    {
+        UpdateBatch batch;
+        for (Size i=0; i<n; ++i)
+            quotes[i]->setValue(2.0);
+        if (counter.counter() != counted)
+            BOOST_FAIL("notifications sent before the batch was committed");
+
+        // nested batches don't send notifications
+        {
+            UpdateBatch nested;
+            quotes[0]->setValue(3.0);
+            nested.commit();
+        }
+        if (counter.counter() != counted)
+            BOOST_FAIL("notifications sent by a nested batch");
+
+        batch.commit();
+    }
+
+    for (Size i=0; i<n; ++i) {
+        if (helpers[i]->updates() != 1)
+            BOOST_FAIL("helper #" << i << " updated "
+                       << helpers[i]->updates() << " times, expected once");
+    }
+    if (curve->updates() != curveUpdates + 1)
+        BOOST_FAIL("curve updated " << curve->updates() - curveUpdates
+                   << " times, expected once");
+    if (counter.counter() != counted + 1)
+        BOOST_FAIL("counter updated " << counter.counter() - counted
+                   << " times, expected once");
+    if (checker.updates() != 1)
+        BOOST_FAIL("order checker updated " << checker.updates()
+                   << " times, expected once");
+    if (checker.outOfOrder() != 0)
+        BOOST_FAIL("observer updated before the objects it observes");
+
+    // observers destroyed before the commit are left out
+    {
+        UpdateBatch batch;
+        ext::shared_ptr<CountingLazyObject> temporary =
+            ext::make_shared<CountingLazyObject>();
+        temporary->registerWith(quotes[1]);
+        temporary->recalculate();
+        quotes[1]->setValue(4.0);
+    }
+    if (ObservableSettings::instance().updatesDeferred() ||
+        !ObservableSettings::instance().updatesEnabled())
+        BOOST_FAIL("updates not enabled after the batch");
+}
+
+namespace {
+
+    // forwards its notifications, or just counts them
+    class Relay : public Observer, public Observable {
+      public:
+        explicit Relay(bool forward) : forward_(forward), updates_(0) {}
+        void update() {
+            ++updates_;
+            if (forward_)
+                notifyObservers();
+        }
+        Size updates() const { return updates_; }
+      private:
+        bool forward_;
+        Size updates_;
+    };
+
+    // changes an unrelated quote when updated
+    class QuoteSetter : public Observer {
+      public:
+        explicit QuoteSetter(const ext::shared_ptr<SimpleQuote>& quote)
+        : quote_(quote) {}
+        void update() { quote_->setValue(quote_->value() + 1.0); }
+      private:
+        ext::shared_ptr<SimpleQuote> quote_;
+    };
+
+}
+
+void ObservableTest::testLateNotificationInUpdateBatch() {
+
+    BOOST_TEST_MESSAGE("Testing notifications sent late in update batches...");
+
+    RestoreUpdates guard;
+
+    // quote -> silent -> counter, and
+    // quote -> relay1 -> relay2 -> setter, which sets other; the
+    // counter, which also observes other, is reached before the setter
+    // but is only notified by it
+    ext::shared_ptr<SimpleQuote> quote = ext::make_shared<SimpleQuote>(1.0);
+    ext::shared_ptr<SimpleQuote> other = ext::make_shared<SimpleQuote>(1.0);
+    ext::shared_ptr<Relay> silent = ext::make_shared<Relay>(false);
+    ext::shared_ptr<Relay> relay1 = ext::make_shared<Relay>(true);
+    ext::shared_ptr<Relay> relay2 = ext::make_shared<Relay>(true);
+    silent->registerWith(quote);
+    relay1->registerWith(quote);
+    relay2->registerWith(relay1);
+    QuoteSetter setter(other);
+    setter.registerWith(relay2);
+    UpdateCounter counter;
+    counter.registerWith(silent);
+    counter.registerWith(other);
+
+    {
+        UpdateBatch batch;
+        quote->setValue(2.0);
+    }
+
+    if (silent->updates() != 1 || relay2->updates() != 1)
+        BOOST_FAIL("observers of the batch not updated");
+    if (other->value() != 2.0)
+        BOOST_FAIL("unrelated quote not set during the batch");
+    if (counter.counter() != 1)
+        BOOST_FAIL("counter updated " << counter.counter()
+                   << " times, expected once");
+}
+#endif
+
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
@@ -337,6 +524,12 @@ test_suite* ObservableTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDeepUpdate));
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testEmptyObserverList));
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testUpdateBatch));
+    suite->add(QUANTLIB_TEST_CASE(
+        &ObservableTest::testLateNotificationInUpdateBatch));
+#endif
     return suite;
 }
 
@@ -32,6 +32,8 @@ class ObservableTest {
     static void testMultiThreadingGlobalSettings();
     static void testDeepUpdate();
     static void testEmptyObserverList();
+    static void testUpdateBatch();
+    static void testLateNotificationInUpdateBatch();
 
     static boost::unit_test_framework::test_suite* suite();
 };
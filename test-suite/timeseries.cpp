@@ -21,6 +21,7 @@
 #include "timeseries.hpp"
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
+#include <ql/math/statistics/timeseriesstatistics.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 
@@ -182,11 +183,156 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testFlatContainer() {
+    BOOST_TEST_MESSAGE("Testing time series stored in contiguous memory...");
+
+    std::vector<Date> dates;
+    std::vector<Real> prices;
+
+    dates.push_back(Date(25, March, 2005));
+    dates.push_back(Date(29, March, 2005));
+    dates.push_back(Date(15, March, 2005));
+
+    prices.push_back(25);
+    prices.push_back(23);
+    prices.push_back(20);
+
+    FlatTimeSeries<Real> ts(dates.begin(), dates.end(), prices.begin());
+
+    if (ts.size() != 3)
+        BOOST_ERROR("wrong size: " << ts.size() << " instead of 3");
+    if (ts.firstDate() != Date(15, March, 2005))
+        BOOST_ERROR("first date does not match");
+    if (ts.lastDate() != Date(29, March, 2005))
+        BOOST_ERROR("last date does not match");
+    if (ts[Date(25, March, 2005)] != 25)
+        BOOST_ERROR("value does not match");
+    if (ts[Date(16, March, 2005)] != Null<Real>())
+        BOOST_ERROR("missing value is not null");
+    // the lookup above added a null datum
+    if (ts.size() != 4)
+        BOOST_ERROR("wrong size: " << ts.size() << " instead of 4");
+
+    ts.append(Date(31, March, 2005), 24);
+    if (ts.lastDate() != Date(31, March, 2005) ||
+        ts[Date(31, March, 2005)] != 24)
+        BOOST_ERROR("appended value does not match");
+
+    bool raised = false;
+    try {
+        ts.append(Date(30, March, 2005), 22);
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("appending before the last date did not raise");
+
+    std::vector<std::pair<Date,Real> > data(ts.size());
+    std::copy(ts.crbegin(), ts.crend(), data.begin());
+    if (data[0].first != Date(31, March, 2005) || data[0].second != 24)
+        BOOST_ERROR("reverse iteration does not match");
+
+    // same results as the default container
+    TimeSeries<Real> reference;
+    for (FlatTimeSeries<Real>::const_iterator i = ts.cbegin();
+         i != ts.cend(); ++i) {
+        if (i->second != Null<Real>())
+            reference.append(i->first, i->second);
+    }
+    FlatTimeSeries<Real> flat(reference.cbegin_time(), reference.cend_time(),
+                              reference.cbegin_values());
+    if (flat.dates() != reference.dates() ||
+        flat.values() != reference.values())
+        BOOST_ERROR("data do not match the default container");
+}
+
+void TimeSeriesTest::testRollingStatistics() {
+    BOOST_TEST_MESSAGE("Testing time-series returns and "
+                       "rolling statistics...");
+
+    const Size n = 50, window = 7;
+    Date today(1, June, 2015);
+    TimeSeries<Real> ts;
+    FlatTimeSeries<Real> flat;
+    std::vector<Real> x(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = 100.0 + 10.0*std::sin(0.3*i) + 0.1*i;
+        ts.append(today + Integer(i), x[i]);
+        flat.append(today + Integer(i), x[i]);
+    }
+
+    const Real tolerance = 1.0e-12;
+
+    TimeSeries<Real> returns = simpleReturns(ts);
+    TimeSeries<Real> logs = logReturns(ts);
+    FlatTimeSeries<Real> flatReturns = simpleReturns(flat);
+    FlatTimeSeries<Real> flatLogs = logReturns(flat);
+    if (returns.size() != n-1 || flatReturns.size() != n-1 ||
+        logs.size() != n-1 || flatLogs.size() != n-1)
+        BOOST_FAIL("wrong number of returns");
+    for (Size i=1; i<n; ++i) {
+        Date d = today + Integer(i);
+        Real expected = x[i]/x[i-1] - 1.0;
+        if (std::fabs(returns[d] - expected) > tolerance ||
+            std::fabs(flatReturns[d] - expected) > tolerance)
+            BOOST_ERROR("wrong simple return at " << d << ":"
+                        << "\n    calculated: " << returns[d]
+                        << "\n    flat:       " << flatReturns[d]
+                        << "\n    expected:   " << expected);
+        expected = std::log(x[i]/x[i-1]);
+        if (std::fabs(logs[d] - expected) > tolerance ||
+            std::fabs(flatLogs[d] - expected) > tolerance)
+            BOOST_ERROR("wrong log return at " << d << ":"
+                        << "\n    calculated: " << logs[d]
+                        << "\n    flat:       " << flatLogs[d]
+                        << "\n    expected:   " << expected);
+    }
+
+    TimeSeries<Real> means = rollingMean(ts, window);
+    TimeSeries<Real> deviations = rollingStandardDeviation(ts, window);
+    FlatTimeSeries<Real> flatMeans = rollingMean(flat, window);
+    FlatTimeSeries<Real> flatDeviations =
+        rollingStandardDeviation(flat, window);
+    if (means.size() != n-window+1 || flatMeans.size() != n-window+1 ||
+        deviations.size() != n-window+1 ||
+        flatDeviations.size() != n-window+1)
+        BOOST_FAIL("wrong number of rolling statistics");
+    for (Size i=window-1; i<n; ++i) {
+        Date d = today + Integer(i);
+        Real mean = 0.0;
+        for (Size j=i+1-window; j<=i; ++j)
+            mean += x[j];
+        mean /= window;
+        Real variance = 0.0;
+        for (Size j=i+1-window; j<=i; ++j)
+            variance += (x[j]-mean)*(x[j]-mean);
+        Real deviation = std::sqrt(variance/(window-1));
+        if (std::fabs(means[d] - mean) > tolerance ||
+            std::fabs(flatMeans[d] - mean) > tolerance)
+            BOOST_ERROR("wrong rolling mean at " << d << ":"
+                        << "\n    calculated: " << means[d]
+                        << "\n    flat:       " << flatMeans[d]
+                        << "\n    expected:   " << mean);
+        if (std::fabs(deviations[d] - deviation) > tolerance ||
+            std::fabs(flatDeviations[d] - deviation) > tolerance)
+            BOOST_ERROR("wrong rolling standard deviation at " << d << ":"
+                        << "\n    calculated: " << deviations[d]
+                        << "\n    flat:       " << flatDeviations[d]
+                        << "\n    expected:   " << deviation);
+    }
+
+    if (!rollingMean(ts, n+1).empty() ||
+        !logReturns(TimeSeries<Real>()).empty())
+        BOOST_ERROR("statistics on too few data are not empty");
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFlatContainer));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testRollingStatistics));
     return suite;
 }
 
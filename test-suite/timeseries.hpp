@@ -30,6 +30,8 @@ class TimeSeriesTest {
     static void testConstruction();
     static void testIntervalPrice();
     static void testIterators();
+    static void testFlatContainer();
+    static void testRollingStatistics();
     static boost::unit_test_framework::test_suite* suite();
     
 };